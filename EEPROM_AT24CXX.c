@@ -11,7 +11,8 @@
 *   (2) MUTIPLE DATA WRITE IS WRITTEN BIG ENDIAN ORDER (HIGHEST
 *       BITS WRITTEN FIRST IE AT THE LOWEST MEMORY LOCATION)
 *       EXCEPT THE WRITEBLOCK FUNCTION WHICH DATA IS WRITTEN
-*       AS IS
+*       AS IS. EEPROM_AT24CXX_REC.h WRITES WHOLE STRUCTS IN EITHER
+*       BYTE ORDER
 *
 *   (3) AT24CXX SERIES EEPROM HAS ADDRESS ROLLOVER FOR MULTIPLE
 *       BYTES READ / WRITE
@@ -21,13 +22,104 @@
 *       READ ROLLOVER  : THE ADDRESS ROLL OVERS FROM THE LAST BYTE
 *                         OF THE LAST PAGE TO THE FIRST BYTE OF
 *                         THE FIRST PAGE
+*       ALL MULTI BYTE WRITES ARE SPLIT INTO PAGE ALIGNED CHUNKS BY
+*       THE LIBRARY SO WRITE ROLLOVER NEVER CORRUPTS DATA
 *
 *   (4) ESP8266 SPECIFIC : HAD SOME ISSUES THE EEPROM I2C, FIRST I2C OPERATION
 *       WORKING BUT THE SECOND FAILED. TURNS OUT ITS SOMETHING TO DO WITH
 *       ESP8266 SOFT I2C IMPLEMENTATION IN i2c_master. HAD TO JACK
 *       UP THE SPEED TO ALMOST 500KHZ (BY DIVING THE delay PARAMETER
 *       BY 3 IN MY i2c_master_wait FUNCTION IN i2c_master FILE TO GET IT
-*       TO WORK PROPERLY)
+*       TO WORK PROPERLY). NO NEED TO HAND EDIT ANY MORE : SET AN I2C
+*       CLOCK FUNCTION THAT SETS THAT delay AND THE LIBRARY FINDS THE
+*       FASTEST STABLE RATE ITSELF (NOTE 18)
+*
+*   (5) LIBRARY DOES NOT USE THE HEAP. ALL SCRATCH BUFFERS ARE ON THE
+*       STACK OR STATIC. DEFINE EEPROM_AT24CXX_NO_HEAP TO DROP THE
+*       ZALLOC / FREE DEFINITIONS SO ANY HEAP USE FAILS TO BUILD
+*
+*   (6) DEFINE EEPROM_AT24CXX_THREAD_SAFE (LINUX / PTHREAD) TO MAKE ALL
+*       DEVICE FUNCTIONS SAFE TO CALL FROM MULTIPLE THREADS
+*
+*   (7) ASYNC API : ReadAsync / WriteAsync / FlushAsync QUEUE A REQUEST
+*       AND RETURN AT ONCE. Tick (CALLED FROM THE MAIN LOOP) DOES ONE
+*       BUS TRANSFER PER CALL AND NEVER WAITS FOR A WRITE CYCLE. SET A
+*       TIME FUNCTION OR ACK POLL FUNCTION, ELSE Tick HAS TO FALL BACK
+*       TO THE WORST CASE tWR DELAY
+*
+*   (8) ALSO BUILDS ON A LINUX / MAC HOST. EEPROM_AT24CXX_SIM PROVIDES A
+*       FILE BACKED SIMULATED EEPROM FOR THE I2C FUNCTIONS. DEFINE
+*       EEPROM_AT24CXX_SIM_TIME SO LIBRARY DELAYS RUN ON THE SIMULATED
+*       CLOCK. EEPROM_AT24CXX_LINUX DRIVES A REAL EEPROM ON /dev/i2c-N
+*
+*   (9) DEFINE EEPROM_AT24CXX_STATS TO KEEP PER DEVICE COUNTERS (OPS,
+*       BYTES, BUS TRANSFERS, ACK POLLS, CACHE HITS, LATENCY HISTOGRAM,
+*       WRITES PER PAGE). READ WITH GetStats, CLEAR WITH ResetStats.
+*       COUNTERS ARE NOT ATOMIC, SO WITH THREADS THEY ARE APPROXIMATE
+*
+*   (10) EEPROM_AT24CXX_LOG_LEVEL PICKS WHICH PRINTF MESSAGES ARE BUILT
+*        IN (NONE / ERROR / WARN / DEBUG). LEVELS ABOVE IT COMPILE OUT
+*        COMPLETELY. WARN AND DEBUG STILL NEED SetDebug(1) AT RUN TIME
+*
+*   (11) DEFINE EEPROM_AT24CXX_TRACE TO RECORD EVERY API CALL AND BUS
+*        TRANSFER (EVENT, ADDRESS, LENGTH, TIMESTAMP, DURATION, RESULT)
+*        IN A FIXED SIZE BINARY RING PER DEVICE. TraceDump SERIALIZES
+*        IT, tools/EEPROM_AT24CXX_TRACE_DECODE TURNS THE DUMP INTO A
+*        TIMELINE ON THE HOST
+*
+*   (12) WHOLE AT24C FAMILY (C01 ... CM01). SIZE, WRITE PAGE, ADDRESS
+*        WIDTH AND tWR COME FROM A CONST MODEL GEOMETRY TABLE. PARTS
+*        UP TO C16 SEND ONE ADDRESS BYTE AND CARRY THE HIGH ADDRESS
+*        BITS IN THE I2C ADDRESS (AS DOES THE CM01), SO THOSE PINS
+*        (A0 ...) ARE IGNORED. DEFINE EEPROM_AT24CXX_FIXED_MODEL TO ONE
+*        MODEL (E.G. EEPROM_MODEL_AT24C64) TO MAKE ALL GEOMETRY
+*        COMPILE TIME CONSTANTS
+*
+*   (13) VECTORED I/O : ReadV / WriteV TAKE AN ARRAY OF (ADDRESS, BUFFER,
+*        LENGTH) SEGMENTS AND WORK THROUGH THEM IN ADDRESS ORDER. READS
+*        SEPARATED BY SMALL GAPS BECOME ONE SEQUENTIAL READ, ALL BYTES
+*        FOR ONE PAGE GO OUT AS ONE PAGE WRITE (GAPS BETWEEN THEM ARE
+*        READ BACK AND REWRITTEN UNCHANGED). ON OVERLAP THE LATER
+*        SEGMENT IN THE ARRAY WINS
+*
+*   (14) IMAGE FUNCTIONS : Dump / Restore / Verify STREAM A RANGE (UP TO
+*        THE WHOLE CHIP) THROUGH A CALLER CALLBACK, SO THE IMAGE NEVER
+*        HAS TO FIT IN RAM. Restore READS EACH CHUNK BACK FIRST AND ONLY
+*        PROGRAMS PAGES THAT DIFFER, THEN CHECKS THE RESULT WITH A CRC32
+*        VERIFY PASS. Crc32 (ZLIB COMPATIBLE) IS EXPORTED FOR THE CALLER
+*        SIDE OF THE CHECK
+*
+*   (15) COMPARE BEFORE WRITE : WITH SetCompareWrite(1) (OR PER CALL WITH
+*        WriteBlockIfChanged) THE TARGET RANGE IS READ FIRST (THROUGH THE
+*        PAGE CACHE IF ON) AND ONLY THE CHANGED SPAN OF EACH PAGE IS
+*        WRITTEN. PAGES ALREADY HOLDING THE DATA COST NO WRITE CYCLE AND
+*        ARE COUNTED IN GetWritesElided. APPLIES TO Write8 / 16 / 32,
+*        WriteBlock AND ARRAY WRITES, NOT TO THE ASYNC QUEUE
+*
+*   (16) Crc32 IS TABLE DRIVEN (SLICING BY 8 ON HOST BUILDS, SEE
+*        EEPROM_AT24CXX_CRC32_TABLES) OR USES THE ARMv8 CRC32
+*        INSTRUCTIONS WHERE AVAILABLE. EEPROM_AT24CXX_CRC.h ADDS AN
+*        OPTIONAL PER PAGE CRC INTEGRITY LAYER ON TOP OF THE DEVICE API
+*
+*   (17) WRITE BACK THRESHOLDS : THE PAGE CACHE ABSORBS REPEATED WRITES
+*        TO THE SAME PAGES. SetWriteBack BOUNDS HOW LONG THEY STAY
+*        THERE : A PAGE IS COMMITTED ONCE IT HAS BEEN DIRTY FOR max_age
+*        OR WHEN MORE THAN max_dirty BYTES ARE DIRTY (OLDEST PAGE FIRST).
+*        CHECKED ON EVERY WRITE AND BY Tick (ONE PAGE PER CALL, NO
+*        WAITING), Flush IS THE EXPLICIT SYNC. PowerFail (SAFE FROM AN
+*        INTERRUPT, ONLY SETS A FLAG) MAKES Tick COMMIT EVERY DIRTY PAGE
+*        BEFORE ANY QUEUED REQUEST AND TURNS LATER WRITES WRITE THROUGH
+*
+*   (18) ERRORS : THE I2C FUNCTIONS RETURN AN EEPROM_STATUS, SO DO ALL
+*        CALLS THAT CAN FAIL (Read8 / 16 / 32 RETURN DATA, GetLastStatus
+*        GIVES THEIR STATUS). AN ADDRESS NACK RIGHT AFTER A WRITE IS THE
+*        WRITE CYCLE STILL RUNNING : IT IS WAITED OUT (UP TO tWR) AND IS
+*        NOT A FAULT. ANY OTHER FAILURE IS RETRIED UP TO
+*        EEPROM_AT24CXX_RETRY_MAX TIMES WITH EXPONENTIAL BACKOFF. WRITE
+*        CYCLE WAITS LEARN THE REAL tWR OF EACH DEVICE AND SLEEP THROUGH
+*        MOST OF IT, THEN POLL WITH A GROWING INTERVAL. WITH AN I2C CLOCK
+*        FUNCTION (SetI2CClockFunction) A FAULT STEPS THE DEVICE'S BUS
+*        CLOCK DOWN AND A RUN OF CLEAN TRANSFERS PROBES A FASTER ONE
 *
 * AUGUST 28 2017
 *
@@ -40,20 +132,186 @@
 
 #include "EEPROM_AT24CXX.h"
 
+#if defined(__ARM_FEATURE_CRC32)
+  #include <arm_acle.h>
+#endif
+
+//LOCKING
+//EACH DEVICE HAS A BUS LOCK (I2C TRANSFERS AND WRITE CYCLE WAITS), A
+//CACHE LOCK (RAM PAGE CACHE) AND A QUEUE LOCK. NO TWO OF THEM ARE
+//EVER HELD TOGETHER. IN PARTICULAR THE CACHE LOCK IS DROPPED BEFORE
+//WAITING FOR THE BUS, SO CACHE HITS DO NOT WAIT BEHIND A WRITE CYCLE
+#if defined(EEPROM_AT24CXX_THREAD_SAFE)
+  #define _EEPROM_AT24CXX_LOCK_INIT(l)          pthread_mutex_init(&(l), NULL)
+  #define _EEPROM_AT24CXX_LOCK(l)               pthread_mutex_lock(&(l))
+  #define _EEPROM_AT24CXX_UNLOCK(l)             pthread_mutex_unlock(&(l))
+  #define _EEPROM_AT24CXX_COND_INIT(c)          pthread_cond_init(&(c), NULL)
+  #define _EEPROM_AT24CXX_COND_WAIT(c, l)       pthread_cond_wait(&(c), &(l))
+  #define _EEPROM_AT24CXX_COND_BROADCAST(c)     pthread_cond_broadcast(&(c))
+#else
+  #define _EEPROM_AT24CXX_LOCK_INIT(l)
+  #define _EEPROM_AT24CXX_LOCK(l)
+  #define _EEPROM_AT24CXX_UNLOCK(l)
+  #define _EEPROM_AT24CXX_COND_INIT(c)
+  #define _EEPROM_AT24CXX_COND_WAIT(c, l)
+  #define _EEPROM_AT24CXX_COND_BROADCAST(c)
+#endif
+
+//MODEL GEOMETRY
+//WITH A FIXED MODEL THE TABLE INDEX IS A CONSTANT, SO EVERY FIELD
+//FOLDS INTO AN IMMEDIATE AND VALIDATION / CHUNKING HAS NO LOOKUP
+#if defined(EEPROM_AT24CXX_FIXED_MODEL)
+  #define _EEPROM_AT24CXX_GEOMETRY(d)       ((void)(d), &_eeprom_at24cxx_geometry[EEPROM_AT24CXX_FIXED_MODEL])
+#else
+  #define _EEPROM_AT24CXX_GEOMETRY(d)       (&_eeprom_at24cxx_geometry[(d)->model])
+#endif
+
+//SPLIT A BYTE ADDRESS INTO I2C ADDRESS (WITH BLOCK BITS) AND WORD ADDRESS
+#define _EEPROM_AT24CXX_BUS_I2C_ADDRESS(d, g, a)    ((uint8_t)((d)->i2c_address | ((a) >> (8 * (g)->address_bytes))))
+#define _EEPROM_AT24CXX_BUS_WORD_ADDRESS(g, a)      ((a) & ((((uint32_t)1) << (8 * (g)->address_bytes)) - 1))
+
+//LOGGING
+//WARN / DEBUG MESSAGES ARE ALSO GATED BY SetDebug AT RUN TIME
+#if (EEPROM_AT24CXX_LOG_LEVEL >= EEPROM_AT24CXX_LOG_LEVEL_WARN)
+  #define _EEPROM_AT24CXX_LOG_WARN(...)     do { if(_eeprom_at24cxx_debug) { PRINTF(__VA_ARGS__); } } while(0)
+#else
+  #define _EEPROM_AT24CXX_LOG_WARN(...)
+#endif
+#if (EEPROM_AT24CXX_LOG_LEVEL >= EEPROM_AT24CXX_LOG_LEVEL_DEBUG)
+  #define _EEPROM_AT24CXX_LOG_DEBUG(...)    do { if(_eeprom_at24cxx_debug) { PRINTF(__VA_ARGS__); } } while(0)
+#else
+  #define _EEPROM_AT24CXX_LOG_DEBUG(...)
+#endif
+
+//STATISTICS
+//COMPILE TO NOTHING UNLESS EEPROM_AT24CXX_STATS IS DEFINED
+#if defined(EEPROM_AT24CXX_STATS)
+  #define _EEPROM_AT24CXX_STATS_OP(d, op, len, t)     _eeprom_at24cxx_stats_op((d), (op), (len), (t))
+  #define _EEPROM_AT24CXX_STATS_INC(d, field)         ((d)->stats.field++)
+  #define _EEPROM_AT24CXX_STATS_ADD(d, field, n)      ((d)->stats.field += (n))
+#else
+  #define _EEPROM_AT24CXX_STATS_OP(d, op, len, t)
+  #define _EEPROM_AT24CXX_STATS_INC(d, field)
+  #define _EEPROM_AT24CXX_STATS_ADD(d, field, n)
+#endif
+
+//TRACE
+//COMPILES TO NOTHING UNLESS EEPROM_AT24CXX_TRACE IS DEFINED
+#if defined(EEPROM_AT24CXX_TRACE)
+  #define _EEPROM_AT24CXX_TRACE_TIMER(d, t)                 uint32_t t = _eeprom_at24cxx_now(d)
+  #define _EEPROM_AT24CXX_TRACE(d, ev, addr, len, res, t)   _eeprom_at24cxx_trace((d), (ev), (addr), (len), (res), (t))
+#else
+  #define _EEPROM_AT24CXX_TRACE_TIMER(d, t)
+  #define _EEPROM_AT24CXX_TRACE(d, ev, addr, len, res, t)
+#endif
+
+//API CALL ACCOUNTING (STATISTICS + TRACE)
+#if defined(EEPROM_AT24CXX_STATS) || defined(EEPROM_AT24CXX_TRACE)
+  #define _EEPROM_AT24CXX_TIMER(d, t)       uint32_t t = _eeprom_at24cxx_now(d)
+#else
+  #define _EEPROM_AT24CXX_TIMER(d, t)
+#endif
+#define _EEPROM_AT24CXX_OP_DONE(d, op, addr, len, t)    do { _EEPROM_AT24CXX_STATS_OP(d, op, len, t); \
+                                                            _EEPROM_AT24CXX_TRACE(d, op, addr, len, 1, t); } while(0)
+#define _EEPROM_AT24CXX_OP_ERROR(d, op, addr, len, t)   do { _EEPROM_AT24CXX_STATS_INC(d, op_errors); \
+                                                            _EEPROM_AT24CXX_TRACE(d, op, addr, len, 0, t); } while(0)
+
+//CALL RESULT (NOTE 18)
+//MARK THE FAULT COUNT ON ENTRY, _eeprom_at24cxx_result ON EXIT TURNS
+//ANY TRANSFER FAULT SINCE THEN INTO THE CALL'S STATUS
+#define _EEPROM_AT24CXX_FAULTS(d, f)      uint32_t f = (d)->fault_count
+
 //LOCAL LIBRARY VARIABLES/////////////////////////////////////
 //DEBUG RELATRED
 static uint8_t _eeprom_at24cxx_debug;
 
-//EEPROM RELATED
-static uint8_t _eeprom_at24cxx_model;
-static uint8_t _eeprom_at24cxx_i2c_address;
+//DEFAULT DEVICE USED BY THE NON HANDLE API
+static EEPROM_AT24CXX_DEVICE _eeprom_at24cxx_device;
+
+//LAST RATE SET THROUGH AN I2C CLOCK FUNCTION (DEVICES MAY SHARE A BUS)
+static void (*_eeprom_at24cxx_clock_fn)(uint32_t);
+static uint32_t _eeprom_at24cxx_clock_hz;
 
-//I2C FUNCTION POINTERS
-static void (*_eeprom_at24cxx_i2c_init)(void);
-static void (*_eeprom_at24cxx_i2c_writebyte)(uint8_t, uint32_t, uint8_t, uint8_t);
-static void (*_eeprom_at24cxx_writebyte_multiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t);
-static uint8_t (*_eeprom_at24cxx_i2c_readbyte)(uint8_t, uint32_t, uint8_t);
-static void (*_eeprom_at24cxx_readbyte_multiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t);
+//MODEL GEOMETRY (SAME ORDER AS EEPROM_MODEL_TYPE)
+//SIZE, WRITE PAGE, ADDRESS BYTES, BLOCK BITS, tWR
+static const EEPROM_AT24CXX_GEOMETRY _eeprom_at24cxx_geometry[EEPROM_MODEL_MAX] =
+{
+    {4096,      32,     2,  0,  10000},     //AT24C32
+    {8192,      32,     2,  0,  10000},     //AT24C64
+    {128,       8,      1,  0,  5000},      //AT24C01
+    {256,       8,      1,  0,  5000},      //AT24C02
+    {512,       16,     1,  1,  5000},      //AT24C04
+    {1024,      16,     1,  2,  5000},      //AT24C08
+    {2048,      16,     1,  3,  5000},      //AT24C16
+    {16384,     64,     2,  0,  5000},      //AT24C128
+    {32768,     64,     2,  0,  5000},      //AT24C256
+    {65536,     128,    2,  0,  5000},      //AT24C512
+    {131072,    256,    2,  1,  5000}       //AT24CM01
+};
+
+//CRC32 LOOKUP TABLES (TABLE n ADVANCES A BYTE n MORE POSITIONS)
+#if !defined(__ARM_FEATURE_CRC32) && (EEPROM_AT24CXX_CRC32_TABLES > 0)
+static uint32_t _eeprom_at24cxx_crc32_table[EEPROM_AT24CXX_CRC32_TABLES][256];
+  #if defined(EEPROM_AT24CXX_THREAD_SAFE)
+static pthread_once_t _eeprom_at24cxx_crc32_once = PTHREAD_ONCE_INIT;
+  #else
+static uint8_t _eeprom_at24cxx_crc32_ready;
+  #endif
+#endif
+
+//INTERNAL FUNCTIONS//////////////////////////////////////////
+static uint8_t PUTINFLASH _eeprom_at24cxx_validate_page_address(EEPROM_AT24CXX_DEVICE* device, uint32_t p_address);
+static uint8_t PUTINFLASH _eeprom_at24cxx_validate_byte_address(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address);
+static uint32_t PUTINFLASH _eeprom_at24cxx_get_size(EEPROM_AT24CXX_DEVICE* device);
+static uint8_t PUTINFLASH _eeprom_at24cxx_get_byte_address(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint32_t* b_address);
+static void PUTINFLASH _eeprom_at24cxx_write_bytes(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len);
+static void PUTINFLASH _eeprom_at24cxx_write_checked(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len, uint8_t compare);
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_write_block(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len, uint8_t compare);
+static void PUTINFLASH _eeprom_at24cxx_read_bytes(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len);
+static void PUTINFLASH _eeprom_at24cxx_write_chunked(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len);
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_write_page_nowait(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len);
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_write_span_locked(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len);
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_bus_read(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len);
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_bus_transfer(EEPROM_AT24CXX_DEVICE* device, uint8_t write, uint32_t b_address, uint8_t* data, uint8_t len);
+static void PUTINFLASH _eeprom_at24cxx_clock_apply(EEPROM_AT24CXX_DEVICE* device);
+static void PUTINFLASH _eeprom_at24cxx_clock_update(EEPROM_AT24CXX_DEVICE* device, uint8_t ok);
+static void PUTINFLASH _eeprom_at24cxx_fault(EEPROM_AT24CXX_DEVICE* device, EEPROM_STATUS status);
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_result(EEPROM_AT24CXX_DEVICE* device, uint32_t faults, EEPROM_STATUS status);
+static uint8_t PUTINFLASH _eeprom_at24cxx_bus_ackpoll(EEPROM_AT24CXX_DEVICE* device);
+static uint8_t PUTINFLASH _eeprom_at24cxx_wait_write_cycle(EEPROM_AT24CXX_DEVICE* device);
+static uint8_t PUTINFLASH _eeprom_at24cxx_write_cycle_done(EEPROM_AT24CXX_DEVICE* device);
+static void PUTINFLASH _eeprom_at24cxx_bus_acquire(EEPROM_AT24CXX_DEVICE* device);
+static void PUTINFLASH _eeprom_at24cxx_bus_release(EEPROM_AT24CXX_DEVICE* device);
+#if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+static uint32_t PUTINFLASH _eeprom_at24cxx_cache_mask(uint32_t offset, uint32_t len);
+static EEPROM_AT24CXX_CACHE_PAGE* PUTINFLASH _eeprom_at24cxx_cache_find(EEPROM_AT24CXX_DEVICE* device, uint32_t page);
+static EEPROM_AT24CXX_CACHE_PAGE* PUTINFLASH _eeprom_at24cxx_cache_get(EEPROM_AT24CXX_DEVICE* device, uint32_t page);
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_cache_flush_page(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_CACHE_PAGE* entry);
+static void PUTINFLASH _eeprom_at24cxx_cache_write(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len);
+static void PUTINFLASH _eeprom_at24cxx_cache_overlay(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len);
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_cache_fill(EEPROM_AT24CXX_DEVICE* device, uint32_t page, uint32_t page_count);
+static void PUTINFLASH _eeprom_at24cxx_cache_read(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len);
+static uint8_t PUTINFLASH _eeprom_at24cxx_cache_flush_one(EEPROM_AT24CXX_DEVICE* device);
+static EEPROM_AT24CXX_CACHE_PAGE* PUTINFLASH _eeprom_at24cxx_cache_due(EEPROM_AT24CXX_DEVICE* device);
+#endif
+static uint8_t PUTINFLASH _eeprom_at24cxx_iov_sort(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_IOVEC* vec, uint8_t count, uint8_t* order, uint8_t* used, uint32_t* total);
+static void PUTINFLASH _eeprom_at24cxx_iov_write_window(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_IOVEC* vec, uint8_t count, uint32_t window, uint32_t window_size);
+static uint8_t PUTINFLASH _eeprom_at24cxx_image_read(EEPROM_AT24CXX_DEVICE* device, uint32_t address, uint32_t len, EEPROM_AT24CXX_IMAGE_IO sink, void* user_data, uint32_t* crc);
+#if !defined(__ARM_FEATURE_CRC32) && (EEPROM_AT24CXX_CRC32_TABLES > 0)
+static void PUTINFLASH _eeprom_at24cxx_crc32_build(void);
+#endif
+static void PUTINFLASH _eeprom_at24cxx_request_complete(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_REQUEST* request);
+static uint8_t PUTINFLASH _eeprom_at24cxx_array_map(EEPROM_AT24CXX_ARRAY* array, uint32_t address, uint32_t* b_address, uint32_t* chunk_len);
+#if defined(EEPROM_AT24CXX_STATS) || defined(EEPROM_AT24CXX_TRACE)
+static uint32_t PUTINFLASH _eeprom_at24cxx_now(EEPROM_AT24CXX_DEVICE* device);
+#endif
+#if defined(EEPROM_AT24CXX_STATS)
+static void PUTINFLASH _eeprom_at24cxx_stats_op(EEPROM_AT24CXX_DEVICE* device, EEPROM_STATS_OP op, uint32_t len, uint32_t t0);
+#endif
+#if defined(EEPROM_AT24CXX_TRACE)
+static void PUTINFLASH _eeprom_at24cxx_trace(EEPROM_AT24CXX_DEVICE* device, uint8_t event, uint32_t address, uint32_t len, uint8_t result, uint32_t t0);
+#endif
+//END INTERNAL FUNCTIONS//////////////////////////////////////
 
 void PUTINFLASH EEPROM_AT24CXX_SetDebug(uint8_t debug_on)
 {
@@ -62,45 +320,330 @@ void PUTINFLASH EEPROM_AT24CXX_SetDebug(uint8_t debug_on)
     _eeprom_at24cxx_debug = debug_on;
 }
 
-void PUTINFLASH EEPROM_AT24CXX_SetI2CFunctions(void (*i2c_init)(void),
-                                            void (*i2c_writebyte)(uint8_t, uint32_t, uint8_t, uint8_t),
-                                            void (*i2c_writebytemultiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t),
-                                            uint8_t (*i2c_readbyte)(uint8_t, uint32_t, uint8_t),
-                                            void (*i2c_readbytemultiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t)
-                                          )
+void PUTINFLASH EEPROM_AT24CXX_DeviceSetI2CFunctions(EEPROM_AT24CXX_DEVICE* device,
+                                                    void (*i2c_init)(void),
+                                                    EEPROM_STATUS (*i2c_writebyte)(uint8_t, uint32_t, uint8_t, uint8_t),
+                                                    EEPROM_STATUS (*i2c_writebytemultiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t),
+                                                    EEPROM_STATUS (*i2c_readbyte)(uint8_t, uint32_t, uint8_t, uint8_t*),
+                                                    EEPROM_STATUS (*i2c_readbytemultiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t)
+                                                  )
 {
     //SET I2C DATA TRANSFER FUNCTIONS POINTERS
+    //EACH RETURNS EEPROM_STATUS_OK, EEPROM_STATUS_NACK IF THE DEVICE DID
+    //NOT ACK ITS ADDRESS OR EEPROM_STATUS_BUS_ERROR FOR ANY OTHER FAILURE
+
+    device->i2c_init = i2c_init;
+    device->i2c_writebyte = i2c_writebyte;
+    device->i2c_writebyte_multiple = i2c_writebytemultiple;
+    device->i2c_readbyte = i2c_readbyte;
+    device->i2c_readbyte_multiple = i2c_readbytemultiple;
+
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : i2c operation functions set\n");
+}
 
-    _eeprom_at24cxx_i2c_init = i2c_init;
-    _eeprom_at24cxx_i2c_writebyte = i2c_writebyte;
-    _eeprom_at24cxx_writebyte_multiple = i2c_writebytemultiple;
-    _eeprom_at24cxx_i2c_readbyte = i2c_readbyte;
-    _eeprom_at24cxx_readbyte_multiple = i2c_readbytemultiple;
+void PUTINFLASH EEPROM_AT24CXX_DeviceSetI2CAckPollFunction(EEPROM_AT24CXX_DEVICE* device, uint8_t (*i2c_ackpoll)(uint8_t))
+{
+    //SET I2C ACK POLL FUNCTION POINTER
+    //FUNCTION ADDRESSES THE DEVICE AND RETURNS 1 IF IT ACKS, 0 IF NOT
+    //USED TO DETECT END OF EEPROM WRITE CYCLE INSTEAD OF FIXED DELAY
+
+    device->i2c_ackpoll = i2c_ackpoll;
+
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : i2c ack poll function set\n");
+}
 
-    if(_eeprom_at24cxx_debug)
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceSetI2CClockFunction(EEPROM_AT24CXX_DEVICE* device, void (*i2c_set_clock)(uint32_t), uint32_t min_hz, uint32_t max_hz)
+{
+    //SET I2C CLOCK FUNCTION POINTER (NOTE 18)
+    //FUNCTION SETS THE BUS BIT RATE IN HZ. THE LIBRARY STARTS AT max_hz,
+    //STEPS DOWN ON FAULTS (NOT BELOW min_hz) AND PROBES BACK UP
+    //NULL TURNS ADAPTIVE CLOCK OFF (RATE LEFT AS IT IS)
+
+    if(i2c_set_clock != NULL && (min_hz == 0 || min_hz > max_hz))
     {
-        PRINTF("EEPROM : AT24CXX : i2c operation functions set\n");
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid i2c clock range !\n");
+        return _eeprom_at24cxx_result(device, device->fault_count, EEPROM_STATUS_INVALID);
     }
+
+    _EEPROM_AT24CXX_LOCK(device->bus_lock);
+    device->i2c_set_clock = i2c_set_clock;
+    device->clock_hz = max_hz;
+    device->clock_stable_hz = max_hz;
+    device->clock_min_hz = min_hz;
+    device->clock_max_hz = max_hz;
+    device->clock_clean = 0;
+    device->clock_probe = EEPROM_AT24CXX_CLOCK_PROBE;
+    _EEPROM_AT24CXX_UNLOCK(device->bus_lock);
+
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : i2c clock function set (%u - %u Hz)\n", min_hz, max_hz);
+    return _eeprom_at24cxx_result(device, device->fault_count, EEPROM_STATUS_OK);
+}
+
+void PUTINFLASH EEPROM_AT24CXX_DeviceSetTimeFunction(EEPROM_AT24CXX_DEVICE* device, uint32_t (*get_time_us)(void))
+{
+    //SET FREE RUNNING MICROSECOND TIME SOURCE
+    //LETS Tick TIME THE WRITE CYCLE WITHOUT BLOCKING. ON ESP8266
+    //system_get_time IS USED BY DEFAULT
+
+    device->get_time_us = get_time_us;
+
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : time function set\n");
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceSetCache(EEPROM_AT24CXX_DEVICE* device, uint8_t cache_on)
+{
+    //SET WRITE BACK PAGE CACHE ON(1) OR OFF(0)
+    //TURNING CACHE OFF COMMITS ALL DIRTY PAGES FIRST (STATUS OF THAT)
+
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        EEPROM_STATUS status = EEPROM_STATUS_OK;
+        uint8_t i;
+
+        if(!cache_on)
+        {
+            status = EEPROM_AT24CXX_DeviceFlush(device);
+            _EEPROM_AT24CXX_LOCK(device->cache_lock);
+            for(i = 0; i < EEPROM_AT24CXX_CACHE_PAGES; i++)
+            {
+                device->cache[i].used = 0;
+            }
+            device->cache_on = 0;
+            _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+        }
+        else
+        {
+            device->cache_on = 1;
+        }
+
+        _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : page cache %s\n", cache_on ? "on" : "off");
+        return _eeprom_at24cxx_result(device, device->fault_count, status);
+    #else
+        (void)cache_on;
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : page cache not compiled in !\n");
+        return _eeprom_at24cxx_result(device, device->fault_count, EEPROM_STATUS_INVALID);
+    #endif
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceSetCachePrefetch(EEPROM_AT24CXX_DEVICE* device, uint8_t pages)
+{
+    //SET NUMBER OF PAGES READ IN ONE SEQUENTIAL READ ON A CACHE MISS
+    //CLAMPED TO 1 .. EEPROM_AT24CXX_CACHE_PREFETCH_PAGES
+
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        if(pages == 0)
+            pages = 1;
+        if(pages > EEPROM_AT24CXX_CACHE_PREFETCH_PAGES)
+            pages = EEPROM_AT24CXX_CACHE_PREFETCH_PAGES;
+        device->cache_prefetch = pages;
+        return _eeprom_at24cxx_result(device, device->fault_count, EEPROM_STATUS_OK);
+    #else
+        (void)pages;
+        return _eeprom_at24cxx_result(device, device->fault_count, EEPROM_STATUS_INVALID);
+    #endif
+}
+
+void PUTINFLASH EEPROM_AT24CXX_DeviceSetCompareWrite(EEPROM_AT24CXX_DEVICE* device, uint8_t compare_on)
+{
+    //SET COMPARE BEFORE WRITE ON(1) OR OFF(0) FOR ALL WRITES (NOTE 15)
+
+    device->compare_write = compare_on;
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : compare before write %s\n", compare_on ? "on" : "off");
+}
+
+void PUTINFLASH EEPROM_AT24CXX_DeviceSetWriteBack(EEPROM_AT24CXX_DEVICE* device, uint32_t max_age_ms, uint16_t max_dirty)
+{
+    //SET HOW LONG WRITES MAY SIT IN THE PAGE CACHE (NOTE 17)
+    //max_age_ms : COMMIT A PAGE DIRTY THIS LONG (NEEDS A TIME FUNCTION)
+    //max_dirty  : COMMIT WHEN MORE BYTES THAN THIS ARE DIRTY
+    //0 = NO LIMIT (PAGES STAY TILL EVICTED OR FLUSHED). ALSO CLEARS A
+    //PREVIOUS PowerFail
+
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        _EEPROM_AT24CXX_LOCK(device->cache_lock);
+        device->cache_max_age_us = max_age_ms * 1000;
+        device->cache_max_dirty = max_dirty;
+        device->power_fail = 0;
+        _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+
+        _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : write back age %u ms dirty %u bytes\n", max_age_ms, max_dirty);
+    #else
+        (void)device;
+        (void)max_age_ms;
+        (void)max_dirty;
+    #endif
+}
+
+void PUTINFLASH EEPROM_AT24CXX_DevicePowerFail(EEPROM_AT24CXX_DEVICE* device)
+{
+    //POWER FAIL HOOK, SAFE TO CALL FROM AN INTERRUPT (ONLY SETS A FLAG)
+    //Tick THEN COMMITS ALL DIRTY PAGES AHEAD OF QUEUED REQUESTS AND ALL
+    //LATER WRITES GO STRAIGHT TO EEPROM. OUTSIDE AN INTERRUPT, CALL
+    //Flush RIGHT AFTER INSTEAD OF WAITING FOR Tick
+
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        device->power_fail = 1;
+    #else
+        (void)device;
+    #endif
 }
 
 //GET PARAMETER FUNCTIONS
-uint8_t PUTINFLASH EEPROM_AT24CXX_GetI2CAddress(void)
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceGetI2CAddress(EEPROM_AT24CXX_DEVICE* device)
 {
     //RETURN THE CALCULATED I2C ADDRESS
 
-    return _eeprom_at24cxx_i2c_address;
+    return device->i2c_address;
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_DeviceGetSize(EEPROM_AT24CXX_DEVICE* device)
+{
+    //RETURN EEPROM CAPACITY IN BYTES
+
+    return _eeprom_at24cxx_get_size(device);
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_DeviceGetWritesElided(EEPROM_AT24CXX_DEVICE* device)
+{
+    //RETURN NUMBER OF PAGE WRITES SKIPPED BY COMPARE BEFORE WRITE
+    //BECAUSE THE PAGE ALREADY HELD THE DATA
+
+    return device->writes_elided;
+}
+
+uint16_t PUTINFLASH EEPROM_AT24CXX_DeviceGetPageSize(EEPROM_AT24CXX_DEVICE* device)
+{
+    //RETURN EEPROM WRITE PAGE SIZE IN BYTES (UNIT OF ADDRESS_TYPE_PAGE)
+
+    return _EEPROM_AT24CXX_GEOMETRY(device)->page_size;
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_DeviceGetClock(EEPROM_AT24CXX_DEVICE* device)
+{
+    //RETURN CURRENT BUS CLOCK IN HZ (0 IF NO I2C CLOCK FUNCTION IS SET)
+
+    return (device->i2c_set_clock != NULL) ? device->clock_hz : 0;
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceGetLastStatus(EEPROM_AT24CXX_DEVICE* device)
+{
+    //RETURN STATUS OF THE LAST CALL ON THE DEVICE (THE ONLY WAY TO GET
+    //IT FOR Read8 / 16 / 32). WITH THREADS, A FAULT OF A CALL RUNNING AT
+    //THE SAME TIME MAY SHOW UP IN IT TOO
+
+    return device->status;
+}
+
+#if defined(EEPROM_AT24CXX_STATS)
+void PUTINFLASH EEPROM_AT24CXX_DeviceGetStats(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_STATISTICS* stats)
+{
+    //COPY OUT CURRENT COUNTERS
+
+    MEMCPY(stats, &device->stats, sizeof(EEPROM_AT24CXX_STATISTICS));
+}
+
+void PUTINFLASH EEPROM_AT24CXX_DeviceResetStats(EEPROM_AT24CXX_DEVICE* device)
+{
+    //CLEAR ALL COUNTERS
+
+    uint8_t* ptr = (uint8_t*)&device->stats;
+    uint32_t i;
+
+    for(i = 0; i < sizeof(EEPROM_AT24CXX_STATISTICS); i++)
+    {
+        ptr[i] = 0;
+    }
+}
+#endif
+
+#if defined(EEPROM_AT24CXX_TRACE)
+uint32_t PUTINFLASH EEPROM_AT24CXX_DeviceTraceDump(EEPROM_AT24CXX_DEVICE* device, uint8_t* buffer, uint32_t buffer_len)
+{
+    //SERIALIZE TRACE RING (OLDEST FIRST) INTO buffer, SEE HEADER FOR
+    //LAYOUT. IF buffer IS SHORT, THE NEWEST EVENTS THAT FIT ARE KEPT
+    //RETURN NUMBER OF BYTES WRITTEN (0 IF buffer CANNOT HOLD THE HEADER)
+
+    EEPROM_AT24CXX_TRACE_ENTRY* entry;
+    uint32_t count;
+    uint32_t i;
+    uint8_t* ptr;
+
+    if(buffer_len < EEPROM_AT24CXX_TRACE_HEADER_SIZE)
+    {
+        return 0;
+    }
+
+    count = (device->trace_count < EEPROM_AT24CXX_TRACE_ENTRIES) ? device->trace_count : EEPROM_AT24CXX_TRACE_ENTRIES;
+    if(count > (buffer_len - EEPROM_AT24CXX_TRACE_HEADER_SIZE) / EEPROM_AT24CXX_TRACE_ENTRY_SIZE)
+    {
+        count = (buffer_len - EEPROM_AT24CXX_TRACE_HEADER_SIZE) / EEPROM_AT24CXX_TRACE_ENTRY_SIZE;
+    }
+
+    ptr = buffer;
+    *ptr++ = 'A';
+    *ptr++ = 'T';
+    *ptr++ = '2';
+    *ptr++ = '4';
+    *ptr++ = EEPROM_AT24CXX_TRACE_VERSION;
+    *ptr++ = device->i2c_address;
+    *ptr++ = (uint8_t)count;
+    *ptr++ = (uint8_t)(count >> 8);
+    for(i = 0; i < 4; i++)
+    {
+        *ptr++ = (uint8_t)(device->trace_count >> (8 * i));
+    }
+
+    for(i = device->trace_count - count; i != device->trace_count; i++)
+    {
+        entry = &device->trace[i & (EEPROM_AT24CXX_TRACE_ENTRIES - 1)];
+        ptr[0] = (uint8_t)entry->time_us;
+        ptr[1] = (uint8_t)(entry->time_us >> 8);
+        ptr[2] = (uint8_t)(entry->time_us >> 16);
+        ptr[3] = (uint8_t)(entry->time_us >> 24);
+        ptr[4] = (uint8_t)entry->duration_us;
+        ptr[5] = (uint8_t)(entry->duration_us >> 8);
+        ptr[6] = (uint8_t)(entry->duration_us >> 16);
+        ptr[7] = (uint8_t)(entry->duration_us >> 24);
+        ptr[8] = (uint8_t)entry->address;
+        ptr[9] = (uint8_t)(entry->address >> 8);
+        ptr[10] = (uint8_t)(entry->address >> 16);
+        ptr[11] = (uint8_t)(entry->address >> 24);
+        ptr[12] = (uint8_t)entry->len;
+        ptr[13] = (uint8_t)(entry->len >> 8);
+        ptr[14] = entry->event;
+        ptr[15] = entry->result;
+        ptr += EEPROM_AT24CXX_TRACE_ENTRY_SIZE;
+    }
+    return (uint32_t)(ptr - buffer);
+}
+
+void PUTINFLASH EEPROM_AT24CXX_DeviceTraceReset(EEPROM_AT24CXX_DEVICE* device)
+{
+    //DROP ALL RECORDED EVENTS
+
+    device->trace_count = 0;
 }
+#endif
 
-void PUTINFLASH EEPROM_AT24CXX_Initialize(EEPROM_MODEL_TYPE model, uint8_t a2, uint8_t a1, uint8_t a0)
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceInitialize(EEPROM_AT24CXX_DEVICE* device, EEPROM_MODEL_TYPE model, uint8_t a2, uint8_t a1, uint8_t a0)
 {
-    //INTIALIZE DS1307 RTC
-    //CHECK FOR CH BIT, IF DISABLED, ENABLE IT
+    //INTIALIZE EEPROM DEVICE
+    //PAGE CACHE STARTS OFF AND EMPTY
+    //MUST BE CALLED BEFORE THE DEVICE IS SHARED BETWEEN THREADS
+
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        uint8_t i;
+    #endif
 
     //VALIDATE EEPROM MODEL
-    if(model >= EEPROM_MODEL_MAX)
+    #if defined(EEPROM_AT24CXX_FIXED_MODEL)
+        if(model != EEPROM_AT24CXX_FIXED_MODEL)
+    #else
+        if(model >= EEPROM_MODEL_MAX)
+    #endif
     {
-        PRINTF("EEPROM : AT24CXX : Invalid EEPROM model !\n");
-        return;
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid EEPROM model !\n");
+        device->status = EEPROM_STATUS_INVALID;
+        return EEPROM_STATUS_INVALID;
     }
 
     //INIT BACKEND I2C
@@ -110,440 +653,2911 @@ void PUTINFLASH EEPROM_AT24CXX_Initialize(EEPROM_MODEL_TYPE model, uint8_t a2, u
     #endif
 
     //SET EEPROM MODEL
-    _eeprom_at24cxx_model = model;
+    device->model = model;
 
     //CALCULATE I2C ADDRESS
-    _eeprom_at24cxx_i2c_address = EEPROM_AT24CXX_I2C_ADDRESS | (a2 << 2) | (a1 << 1) | a0;
+    //LOW BITS USED FOR HIGH MEMORY ADDRESS BITS DO NOT SELECT THE DEVICE
+    device->i2c_address = EEPROM_AT24CXX_I2C_ADDRESS | (a2 << 2) | (a1 << 1) | a0;
+    device->i2c_address &= ~((1 << _EEPROM_AT24CXX_GEOMETRY(device)->block_bits) - 1);
 
-    if(_eeprom_at24cxx_debug)
-    {
-        PRINTF("EEPROM : AT24CXX : Initialized. I2C address = 0x%02X\n", _eeprom_at24cxx_i2c_address);
-    }
+    //DEFAULT TIME SOURCE
+    #if defined(ESP8266)
+        if(device->get_time_us == NULL)
+        {
+            device->get_time_us = system_get_time;
+        }
+    #endif
+
+    //RESET BUS STATE, LOCKS AND REQUEST QUEUE
+    device->write_busy = 0;
+    device->write_unacked = 0;
+    device->write_start_us = 0;
+    device->write_cycle_us = 0;
+    device->status = EEPROM_STATUS_OK;
+    device->fault_status = EEPROM_STATUS_OK;
+    device->fault_count = 0;
+    device->compare_write = 0;
+    device->writes_elided = 0;
+    device->queue_head = 0;
+    device->queue_count = 0;
+    _EEPROM_AT24CXX_LOCK_INIT(device->bus_lock);
+    _EEPROM_AT24CXX_LOCK_INIT(device->cache_lock);
+    _EEPROM_AT24CXX_LOCK_INIT(device->queue_lock);
+    _EEPROM_AT24CXX_COND_INIT(device->queue_done);
+
+    #if defined(EEPROM_AT24CXX_STATS)
+        EEPROM_AT24CXX_DeviceResetStats(device);
+    #endif
+    #if defined(EEPROM_AT24CXX_TRACE)
+        EEPROM_AT24CXX_DeviceTraceReset(device);
+    #endif
+
+    //RESET PAGE CACHE
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        device->cache_on = 0;
+        device->cache_prefetch = EEPROM_AT24CXX_CACHE_PREFETCH_PAGES;
+        device->cache_clock = 0;
+        device->cache_generation = 0;
+        device->cache_max_age_us = 0;
+        device->cache_max_dirty = 0;
+        device->power_fail = 0;
+        for(i = 0; i < EEPROM_AT24CXX_CACHE_PAGES; i++)
+        {
+            device->cache[i].used = 0;
+        }
+    #endif
+
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : Initialized. I2C address = 0x%02X\n", device->i2c_address);
+    return EEPROM_STATUS_OK;
 }
 
-void PUTINFLASH EEPROM_AT24CXX_Write8(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t data)
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceWrite8(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t data)
 {
     //WRITE UINT8_T AT SPECIFIED ADDRESS
 
+    uint32_t b_address;
+    _EEPROM_AT24CXX_TIMER(device, op_t0);
+    _EEPROM_AT24CXX_FAULTS(device, faults);
+
     if(address_type >= ADDRESS_TYPE_MAX)
     {
-        PRINTF("EEPROM : AT24CXX : Invalid address type !\n");
-        return;
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_WRITE8, address, 1, op_t0);
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid address type !\n");
+        return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
     }
 
     //CHECK VALIDITY OF ADDRESS
-    //DO WRITE OPERATION
-    switch(address_type)
+    if(!_eeprom_at24cxx_get_byte_address(device, address, address_type, &b_address))
     {
-        case ADDRESS_TYPE_BYTE:
-                      if(!_eeprom_at24cxx_validate_byte_address(address))
-                      {
-                            if(_eeprom_at24cxx_debug)
-                            {
-                                PRINTF("EEPROM : AT24CXX : Invalid address write\n");
-                            }
-                            return;
-                      }
-                      (*_eeprom_at24cxx_i2c_writebyte)(_eeprom_at24cxx_i2c_address, address, 2, data);
-                      if(_eeprom_at24cxx_debug)
-                      {
-                          PRINTF("EEPROM : AT24CXX : written %u at address %u\n", data, address);
-                      }
-                      break;
-        case ADDRESS_TYPE_PAGE:
-                      if(!_eeprom_at24cxx_validate_page_address(address))
-                      {
-                          if(_eeprom_at24cxx_debug)
-                          {
-                              PRINTF("EEPROM : AT24CXX : Invalid address write\n");
-                          }
-                          return;
-                      }
-                      (*_eeprom_at24cxx_i2c_writebyte)(_eeprom_at24cxx_i2c_address, EEPROM_GET_BYTE_ADDRESS_FROM_PAGE(address), 2, data);
-                      if(_eeprom_at24cxx_debug)
-                      {
-                          PRINTF("EEPROM : AT24CXX : written %u at page %u\n", data, address);
-                      }
-                      break;
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_WRITE8, address, 1, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid address write\n");
+        return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
     }
+
+    //DO WRITE OPERATION
+    _eeprom_at24cxx_write_checked(device, b_address, &data, 1, device->compare_write);
+    _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_WRITE8, address, 1, op_t0);
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : written %u at %s %u\n", data, (address_type == ADDRESS_TYPE_BYTE) ? "address" : "page", address);
+    return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK);
 }
 
-void PUTINFLASH EEPROM_AT24CXX_Write16(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint16_t data)
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceWrite16(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint16_t data)
 {
     //WRITE UINT16_T AT SPECIFIED ADDRESS
 
+    uint32_t b_address;
+    _EEPROM_AT24CXX_TIMER(device, op_t0);
+    _EEPROM_AT24CXX_FAULTS(device, faults);
+
     if(address_type >= ADDRESS_TYPE_MAX)
     {
-        PRINTF("EEPROM : AT24CXX : Invalid address type !\n");
-        return;
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_WRITE16, address, 2, op_t0);
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid address type !\n");
+        return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+    }
+
+    if(!_eeprom_at24cxx_get_byte_address(device, address, address_type, &b_address) ||
+        !_eeprom_at24cxx_validate_byte_address(device, b_address + 1))
+    {
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_WRITE16, address, 2, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid address write\n");
+        return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
     }
 
-    uint8_t* byte = (uint8_t*)ZALLOC(2);
+    uint8_t byte[2];
     byte[0] = (uint8_t)((data & 0xFF00) >> 8);
     byte[1] = (uint8_t)data;
 
-    switch(address_type)
-    {
-        case ADDRESS_TYPE_BYTE:
-                      if(!_eeprom_at24cxx_validate_byte_address(address))
-                      {
-                            if(_eeprom_at24cxx_debug)
-                            {
-                                PRINTF("EEPROM : AT24CXX : Invalid address write\n");
-                            }
-                            return;
-                      }
-                      (*_eeprom_at24cxx_writebyte_multiple)(_eeprom_at24cxx_i2c_address, address, 2, byte, 2);
-                      if(_eeprom_at24cxx_debug)
-                      {
-                          PRINTF("EEPROM : AT24CXX : written %u at address %u\n", data, address);
-                      }
-                      break;
-        case ADDRESS_TYPE_PAGE:
-                      if(!_eeprom_at24cxx_validate_page_address(address))
-                      {
-                          if(_eeprom_at24cxx_debug)
-                          {
-                              PRINTF("EEPROM : AT24CXX : Invalid address write\n");
-                          }
-                          return;
-                      }
-                      (*_eeprom_at24cxx_writebyte_multiple)(_eeprom_at24cxx_i2c_address, EEPROM_GET_BYTE_ADDRESS_FROM_PAGE(address), 2, byte, 2);
-                      if(_eeprom_at24cxx_debug)
-                      {
-                          PRINTF("EEPROM : AT24CXX : written %u at page %u\n", data, address);
-                      }
-                      break;
-    }
-    FREE(byte);
-}
-
-void PUTINFLASH EEPROM_AT24CXX_Write32(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint32_t data)
+    _eeprom_at24cxx_write_checked(device, b_address, byte, 2, device->compare_write);
+    _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_WRITE16, address, 2, op_t0);
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : written %u at %s %u\n", data, (address_type == ADDRESS_TYPE_BYTE) ? "address" : "page", address);
+    return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceWrite32(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint32_t data)
 {
     //WRITE UINT32_T AT SPECIFIED ADDRESS
 
+    uint32_t b_address;
+    _EEPROM_AT24CXX_TIMER(device, op_t0);
+    _EEPROM_AT24CXX_FAULTS(device, faults);
+
     if(address_type >= ADDRESS_TYPE_MAX)
     {
-        PRINTF("EEPROM : AT24CXX : Invalid address type !\n");
-        return;
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_WRITE32, address, 4, op_t0);
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid address type !\n");
+        return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+    }
+
+    if(!_eeprom_at24cxx_get_byte_address(device, address, address_type, &b_address) ||
+        !_eeprom_at24cxx_validate_byte_address(device, b_address + 3))
+    {
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_WRITE32, address, 4, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid address write\n");
+        return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
     }
 
-    uint8_t* byte = (uint8_t*)ZALLOC(4);
+    uint8_t byte[4];
     byte[0] = (uint8_t)((data & 0xFF000000) >> 24);
     byte[1] = (uint8_t)((data & 0x00FF0000) >> 16);
     byte[2] = (uint8_t)((data & 0x0000FF00) >> 8);
     byte[3] = (uint8_t)data;
 
-    switch(address_type)
-    {
-        case ADDRESS_TYPE_BYTE:
-                      if(!_eeprom_at24cxx_validate_byte_address(address))
-                      {
-                            if(_eeprom_at24cxx_debug)
-                            {
-                                PRINTF("EEPROM : AT24CXX : Invalid address write\n");
-                            }
-                            return;
-                      }
-                      (*_eeprom_at24cxx_writebyte_multiple)(_eeprom_at24cxx_i2c_address, address, 2, byte, 4);
-                      if(_eeprom_at24cxx_debug)
-                      {
-                          PRINTF("EEPROM : AT24CXX : written %u at address %u\n", data, address);
-                      }
-                      break;
-        case ADDRESS_TYPE_PAGE:
-                      if(!_eeprom_at24cxx_validate_page_address(address))
-                      {
-                          if(_eeprom_at24cxx_debug)
-                          {
-                              PRINTF("EEPROM : AT24CXX : Invalid address write\n");
-                          }
-                          return;
-                      }
-                      (*_eeprom_at24cxx_writebyte_multiple)(_eeprom_at24cxx_i2c_address, EEPROM_GET_BYTE_ADDRESS_FROM_PAGE(address), 2, byte, 4);
-                      if(_eeprom_at24cxx_debug)
-                      {
-                          PRINTF("EEPROM : AT24CXX : written %u at page %u\n", data, address);
-                      }
-                      break;
-    }
-    FREE(byte);
-}
-
-void PUTINFLASH EEPROM_AT24CXX_WriteBlock(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint8_t data_len)
+    _eeprom_at24cxx_write_checked(device, b_address, byte, 4, device->compare_write);
+    _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_WRITE32, address, 4, op_t0);
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : written %u at %s %u\n", data, (address_type == ADDRESS_TYPE_BYTE) ? "address" : "page", address);
+    return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceWriteBlock(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len)
 {
     //WRITE BLOCK AT SPECIFIED ADDRESS
+    //BLOCK CAN BE OF ANY LENGTH AND CROSS PAGE BOUNDARIES
 
-    if(address_type >= ADDRESS_TYPE_MAX)
-    {
-        PRINTF("EEPROM : AT24CXX : Invalid address type !\n");
-        return;
-    }
+    return _eeprom_at24cxx_write_block(device, address, address_type, data, data_len, device->compare_write);
+}
 
-    switch(address_type)
-    {
-        case ADDRESS_TYPE_BYTE:
-                      if(!_eeprom_at24cxx_validate_byte_address(address))
-                      {
-                            if(_eeprom_at24cxx_debug)
-                            {
-                                PRINTF("EEPROM : AT24CXX : Invalid address write\n");
-                            }
-                            return;
-                      }
-                      (*_eeprom_at24cxx_writebyte_multiple)(_eeprom_at24cxx_i2c_address, address, 2, data, data_len);
-                      if(_eeprom_at24cxx_debug)
-                      {
-                          PRINTF("EEPROM : AT24CXX : written %u bytes at address %u\n", data_len, address);
-                      }
-                      break;
-        case ADDRESS_TYPE_PAGE:
-                      if(!_eeprom_at24cxx_validate_page_address(address))
-                      {
-                          if(_eeprom_at24cxx_debug)
-                          {
-                              PRINTF("EEPROM : AT24CXX : Invalid address write\n");
-                          }
-                          return;
-                      }
-                      (*_eeprom_at24cxx_writebyte_multiple)(_eeprom_at24cxx_i2c_address, EEPROM_GET_BYTE_ADDRESS_FROM_PAGE(address), 2, data, data_len);
-                      if(_eeprom_at24cxx_debug)
-                      {
-                          PRINTF("EEPROM : AT24CXX : written %u bytes at page %u\n", data_len, address);
-                      }
-                      break;
-    }
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceWriteBlockIfChanged(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len)
+{
+    //WRITE BLOCK AT SPECIFIED ADDRESS, SKIPPING BYTES ALREADY STORED
+    //(COMPARE BEFORE WRITE FOR THIS CALL ONLY, SEE NOTE 15)
+
+    return _eeprom_at24cxx_write_block(device, address, address_type, data, data_len, 1);
 }
 
-uint8_t PUTINFLASH EEPROM_AT24CXX_Read8(uint32_t address, EEPROM_ADDRESS_TYPE address_type)
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceFlush(EEPROM_AT24CXX_DEVICE* device)
+{
+    //COMMIT ALL DIRTY CACHED PAGES TO EEPROM
+    //RETURNS ONCE THE LAST WRITE CYCLE HAS COMPLETED
+
+    _EEPROM_AT24CXX_TIMER(device, op_t0);
+    _EEPROM_AT24CXX_FAULTS(device, faults);
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        uint8_t i;
+
+        _EEPROM_AT24CXX_LOCK(device->cache_lock);
+        for(i = 0; i < EEPROM_AT24CXX_CACHE_PAGES; i++)
+        {
+            _eeprom_at24cxx_cache_flush_page(device, &device->cache[i]);
+        }
+        _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+
+        _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : cache flushed\n");
+    #endif
+
+    _eeprom_at24cxx_bus_acquire(device);
+    _eeprom_at24cxx_bus_release(device);
+    _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_FLUSH, 0, 0, op_t0);
+    return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceInvalidateCache(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint32_t data_len)
+{
+    //DROP CACHED CONTENT OF SPECIFIED RANGE SO NEXT READ GOES TO EEPROM
+    //CALL WHEN EEPROM IS MODIFIED OUTSIDE THIS LIBRARY
+    //DIRTY BYTES ARE KEPT AS THEY ARE NEWER THAN EEPROM CONTENT
+
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        EEPROM_AT24CXX_CACHE_PAGE* entry;
+        uint32_t b_address;
+        uint32_t page;
+
+        if(address_type >= ADDRESS_TYPE_MAX || data_len == 0 ||
+            !_eeprom_at24cxx_get_byte_address(device, address, address_type, &b_address))
+        {
+            return _eeprom_at24cxx_result(device, device->fault_count, EEPROM_STATUS_INVALID);
+        }
+
+        _EEPROM_AT24CXX_LOCK(device->cache_lock);
+        for(page = b_address / EEPROM_AT24CXX_CACHE_LINE_SIZE;
+            page <= (b_address + data_len - 1) / EEPROM_AT24CXX_CACHE_LINE_SIZE;
+            page++)
+        {
+            entry = _eeprom_at24cxx_cache_find(device, page);
+            if(entry != NULL)
+            {
+                entry->valid = entry->dirty;
+            }
+        }
+        device->cache_generation++;
+        _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+    #else
+        (void)address;
+        (void)address_type;
+        (void)data_len;
+    #endif
+    return _eeprom_at24cxx_result(device, device->fault_count, EEPROM_STATUS_OK);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceRead8(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type)
 {
     //READ UINT8_T FROM SPECIFIED ADDRESS
 
+    uint32_t b_address;
+    uint8_t data;
+    _EEPROM_AT24CXX_TIMER(device, op_t0);
+    _EEPROM_AT24CXX_FAULTS(device, faults);
+
     if(address_type >= ADDRESS_TYPE_MAX)
     {
-        PRINTF("EEPROM : AT24CXX : Invalid address type !\n");
-        return;
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_READ8, address, 1, op_t0);
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid address type !\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+        return 0;
     }
 
-    uint8_t data;
-    switch(address_type)
+    if(!_eeprom_at24cxx_get_byte_address(device, address, address_type, &b_address))
     {
-        case ADDRESS_TYPE_BYTE:
-                      if(!_eeprom_at24cxx_validate_byte_address(address))
-                      {
-                            if(_eeprom_at24cxx_debug)
-                            {
-                                PRINTF("EEPROM : AT24CXX : Invalid address read\n");
-                            }
-                            return;
-                      }
-                      data = (*_eeprom_at24cxx_i2c_readbyte)(_eeprom_at24cxx_i2c_address, address, 2);
-                      if(_eeprom_at24cxx_debug)
-                      {
-                          PRINTF("EEPROM : AT24CXX : read %u from address %u\n", data, address);
-                      }
-                      break;
-        case ADDRESS_TYPE_PAGE:
-                      if(!_eeprom_at24cxx_validate_page_address(address))
-                      {
-                          if(_eeprom_at24cxx_debug)
-                          {
-                              PRINTF("EEPROM : AT24CXX : Invalid address read\n");
-                          }
-                          return;
-                      }
-                      data = (*_eeprom_at24cxx_i2c_readbyte)(_eeprom_at24cxx_i2c_address, EEPROM_GET_BYTE_ADDRESS_FROM_PAGE(address), 2);
-                      if(_eeprom_at24cxx_debug)
-                      {
-                          PRINTF("EEPROM : AT24CXX : read %u from page %u\n", data, address);
-                      }
-                      break;
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_READ8, address, 1, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid address read\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+        return 0;
     }
+
+    _eeprom_at24cxx_read_bytes(device, b_address, &data, 1);
+    _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_READ8, address, 1, op_t0);
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : read %u from %s %u\n", data, (address_type == ADDRESS_TYPE_BYTE) ? "address" : "page", address);
+    _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK);
     return data;
 }
 
-uint16_t PUTINFLASH EEPROM_AT24CXX_Read16(uint32_t address, EEPROM_ADDRESS_TYPE address_type)
+uint16_t PUTINFLASH EEPROM_AT24CXX_DeviceRead16(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type)
 {
     //READ UINT16_T FROM SPECIFIED ADDRESS
 
+    uint32_t b_address;
+    uint16_t data;
+    _EEPROM_AT24CXX_TIMER(device, op_t0);
+    _EEPROM_AT24CXX_FAULTS(device, faults);
+
     if(address_type >= ADDRESS_TYPE_MAX)
     {
-        PRINTF("EEPROM : AT24CXX : Invalid address type !\n");
-        return;
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_READ16, address, 2, op_t0);
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid address type !\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+        return 0;
     }
 
-    uint16_t data;
-    uint8_t* byte = (uint8_t*)ZALLOC(2);
-
-    switch(address_type)
+    if(!_eeprom_at24cxx_get_byte_address(device, address, address_type, &b_address) ||
+        !_eeprom_at24cxx_validate_byte_address(device, b_address + 1))
     {
-        case ADDRESS_TYPE_BYTE:
-                      if(!_eeprom_at24cxx_validate_byte_address(address))
-                      {
-                            if(_eeprom_at24cxx_debug)
-                            {
-                                PRINTF("EEPROM : AT24CXX : Invalid address read\n");
-                            }
-                            return;
-                      }
-                      (*_eeprom_at24cxx_readbyte_multiple)(_eeprom_at24cxx_i2c_address, address, 2, byte, 2);
-                      break;
-        case ADDRESS_TYPE_PAGE:
-                      if(!_eeprom_at24cxx_validate_page_address(address))
-                      {
-                          if(_eeprom_at24cxx_debug)
-                          {
-                              PRINTF("EEPROM : AT24CXX : Invalid address read\n");
-                          }
-                          return;
-                      }
-                      (*_eeprom_at24cxx_readbyte_multiple)(_eeprom_at24cxx_i2c_address, EEPROM_GET_BYTE_ADDRESS_FROM_PAGE(address), 2, byte, 2);
-                      break;
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_READ16, address, 2, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid address read\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+        return 0;
     }
+
+    uint8_t byte[2];
+    _eeprom_at24cxx_read_bytes(device, b_address, byte, 2);
+    _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_READ16, address, 2, op_t0);
     data = (byte[0] << 8) | byte[1];
-    if(_eeprom_at24cxx_debug)
-    {
-        if(address_type == ADDRESS_TYPE_BYTE)
-            PRINTF("EEPROM : AT24CXX : read %u from address %u\n", data, address);
-        else
-            PRINTF("EEPROM : AT24CXX : read %u from page %u\n", data, address);
-    }
-    FREE(byte);
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : read %u from %s %u\n", data, (address_type == ADDRESS_TYPE_BYTE) ? "address" : "page", address);
+    _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK);
     return data;
 }
 
-uint32_t PUTINFLASH EEPROM_AT24CXX_Read32(uint32_t address, EEPROM_ADDRESS_TYPE address_type)
+uint32_t PUTINFLASH EEPROM_AT24CXX_DeviceRead32(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type)
 {
     //READ UINT32_T FROM SPECIFIED ADDRESS
 
+    uint32_t b_address;
+    uint32_t data;
+    _EEPROM_AT24CXX_TIMER(device, op_t0);
+    _EEPROM_AT24CXX_FAULTS(device, faults);
+
     if(address_type >= ADDRESS_TYPE_MAX)
     {
-        PRINTF("EEPROM : AT24CXX : Invalid address type !\n");
-        return;
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_READ32, address, 4, op_t0);
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid address type !\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+        return 0;
     }
 
-    uint32_t data;
-    uint8_t* byte = (uint8_t*)ZALLOC(4);
-
-    switch(address_type)
+    if(!_eeprom_at24cxx_get_byte_address(device, address, address_type, &b_address) ||
+        !_eeprom_at24cxx_validate_byte_address(device, b_address + 3))
     {
-        case ADDRESS_TYPE_BYTE:
-                      if(!_eeprom_at24cxx_validate_byte_address(address))
-                      {
-                            if(_eeprom_at24cxx_debug)
-                            {
-                                PRINTF("EEPROM : AT24CXX : Invalid address read\n");
-                            }
-                            return;
-                      }
-                      (*_eeprom_at24cxx_readbyte_multiple)(_eeprom_at24cxx_i2c_address, address, 2, byte, 4);
-                      break;
-        case ADDRESS_TYPE_PAGE:
-                      if(!_eeprom_at24cxx_validate_page_address(address))
-                      {
-                          if(_eeprom_at24cxx_debug)
-                          {
-                              PRINTF("EEPROM : AT24CXX : Invalid address read\n");
-                          }
-                          return;
-                      }
-                      (*_eeprom_at24cxx_readbyte_multiple)(_eeprom_at24cxx_i2c_address, EEPROM_GET_BYTE_ADDRESS_FROM_PAGE(address), 2, byte, 4);
-                      break;
-    }
-    data = (byte[0] << 24) | (byte[1] << 16) | (byte[2] << 8) | byte[3];
-    if(_eeprom_at24cxx_debug)
-    {
-        if(address_type == ADDRESS_TYPE_BYTE)
-            PRINTF("EEPROM : AT24CXX : read %u from address %u\n", data, address);
-        else
-            PRINTF("EEPROM : AT24CXX : read %u from page %u\n", data, address);
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_READ32, address, 4, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid address read\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+        return 0;
     }
-    FREE(byte);
+
+    uint8_t byte[4];
+    _eeprom_at24cxx_read_bytes(device, b_address, byte, 4);
+    _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_READ32, address, 4, op_t0);
+    data = ((uint32_t)byte[0] << 24) | ((uint32_t)byte[1] << 16) | ((uint32_t)byte[2] << 8) | byte[3];
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : read %u from %s %u\n", data, (address_type == ADDRESS_TYPE_BYTE) ? "address" : "page", address);
+    _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK);
     return data;
 }
 
-void PUTINFLASH EEPROM_AT24CXX_ReadBlock(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint8_t data_len)
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceReadBlock(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len)
 {
     //READ BLOCK FROM SPECIFIED ADDRESS
 
+    uint32_t b_address;
+    _EEPROM_AT24CXX_TIMER(device, op_t0);
+    _EEPROM_AT24CXX_FAULTS(device, faults);
+
     if(address_type >= ADDRESS_TYPE_MAX)
     {
-        PRINTF("EEPROM : AT24CXX : Invalid address type !\n");
-        return;
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_READ_BLOCK, address, data_len, op_t0);
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid address type !\n");
+        return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
     }
 
-    switch(address_type)
+    //WHOLE RANGE MUST BE ON THE DEVICE (THE CHIP WOULD WRAP TO 0, OR
+    //THE HIGH BITS WOULD SELECT ANOTHER I2C ADDRESS)
+    if(data_len == 0 ||
+        !_eeprom_at24cxx_get_byte_address(device, address, address_type, &b_address) ||
+        b_address + data_len < b_address ||
+        !_eeprom_at24cxx_validate_byte_address(device, b_address + data_len - 1))
     {
-        case ADDRESS_TYPE_BYTE:
-                      if(!_eeprom_at24cxx_validate_byte_address(address))
-                      {
-                            if(_eeprom_at24cxx_debug)
-                            {
-                                PRINTF("EEPROM : AT24CXX : Invalid address read\n");
-                            }
-                            return;
-                      }
-                      (*_eeprom_at24cxx_readbyte_multiple)(_eeprom_at24cxx_i2c_address, address, 2, data, data_len);
-                      break;
-        case ADDRESS_TYPE_PAGE:
-                      if(!_eeprom_at24cxx_validate_page_address(address))
-                      {
-                          if(_eeprom_at24cxx_debug)
-                          {
-                              PRINTF("EEPROM : AT24CXX : Invalid address read\n");
-                          }
-                          return;
-                      }
-                      (*_eeprom_at24cxx_readbyte_multiple)(_eeprom_at24cxx_i2c_address, EEPROM_GET_BYTE_ADDRESS_FROM_PAGE(address), 2, data, data_len);
-                      break;
-    }
-    if(_eeprom_at24cxx_debug)
-    {
-        if(address_type == ADDRESS_TYPE_BYTE)
-            PRINTF("EEPROM : AT24CXX : read %u bytes from address %u\n", data_len, address);
-        else
-            PRINTF("EEPROM : AT24CXX : read %u bytes from page %u\n", data_len, address);
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_READ_BLOCK, address, data_len, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid address read\n");
+        return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
     }
+
+    _eeprom_at24cxx_read_bytes(device, b_address, data, data_len);
+    _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_READ_BLOCK, address, data_len, op_t0);
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : read %u bytes from %s %u\n", data_len, (address_type == ADDRESS_TYPE_BYTE) ? "address" : "page", address);
+    return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK);
 }
 
-static uint8_t PUTINFLASH _eeprom_at24cxx_validate_page_address(uint32_t p_address)
+//VECTORED I/O FUNCTIONS
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceReadV(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_IOVEC* vec, uint8_t count)
 {
-    //CHECK FOR VALIDITY OF PAGE ADDRESS
+    //READ A BATCH OF (ADDRESS, BUFFER, LENGTH) SEGMENTS
+    //SEGMENTS ARE READ IN ADDRESS ORDER. NEIGHBOURS NO MORE THAN
+    //EEPROM_AT24CXX_IOV_GAP BYTES APART ARE JOINED INTO ONE SEQUENTIAL
+    //READ THROUGH THE SCRATCH BUFFER (ONE ADDRESS PHASE INSTEAD OF ONE
+    //PER SEGMENT). WITH THE PAGE CACHE ON SEGMENTS GO THROUGH THE CACHE
+    //RETURN 0 IF ANY SEGMENT IS INVALID (NOTHING IS READ)
+    //OR A TRANSFER FAILED (SEE GetLastStatus)
+
+    uint8_t order[EEPROM_AT24CXX_IOV_MAX];
+    uint8_t scratch[EEPROM_AT24CXX_IOV_SCRATCH];
+    EEPROM_AT24CXX_IOVEC* segment;
+    uint8_t used;
+    uint32_t total;
+    uint32_t start;
+    uint32_t end;
+    uint32_t address;
+    uint32_t len;
+    uint32_t chunk_len;
+    uint8_t i;
+    uint8_t j;
+    uint8_t k;
+    _EEPROM_AT24CXX_TIMER(device, op_t0);
+    _EEPROM_AT24CXX_FAULTS(device, faults);
 
-    switch(_eeprom_at24cxx_model)
+    if(!_eeprom_at24cxx_iov_sort(device, vec, count, order, &used, &total))
     {
-        case EEPROM_MODEL_AT24C32:
-            if(p_address >= 0 && p_address <= 127)
-                return 1;
-            else
-                return 0;
-            break;
-        case EEPROM_MODEL_AT24C64:
-            if(p_address >= 0 && p_address <= 255)
-                return 1;
-            else
-                return 0;
-          break;
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_READ_BLOCK, 0, 0, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid vectored read\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+        return 0;
+    }
+
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        if(device->cache_on)
+        {
+            for(i = 0; i < used; i++)
+            {
+                _eeprom_at24cxx_read_bytes(device, vec[order[i]].address, vec[order[i]].data, vec[order[i]].data_len);
+            }
+            _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_READ_BLOCK, (used > 0) ? vec[order[0]].address : 0, total, op_t0);
+            _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : read %u bytes in %u segments\n", total, used);
+            return (_eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK) == EEPROM_STATUS_OK);
+        }
+    #endif
+
+    _eeprom_at24cxx_bus_acquire(device);
+    for(i = 0; i < used; i = j)
+    {
+        //GROW THE RUN WHILE THE NEXT SEGMENT IS CLOSE ENOUGH AND THE
+        //WHOLE RUN STILL FITS THE SCRATCH BUFFER
+        start = vec[order[i]].address;
+        end = start + vec[order[i]].data_len;
+        for(j = i + 1; j < used; j++)
+        {
+            segment = &vec[order[j]];
+            if(segment->address > end + EEPROM_AT24CXX_IOV_GAP ||
+                ((segment->address + segment->data_len > end) ? segment->address + segment->data_len : end) - start > EEPROM_AT24CXX_IOV_SCRATCH)
+            {
+                break;
+            }
+            if(segment->address + segment->data_len > end)
+            {
+                end = segment->address + segment->data_len;
+            }
+        }
+
+        if(j == i + 1)
+        {
+            //LONE SEGMENT : STRAIGHT INTO THE CALLER BUFFER
+            segment = &vec[order[i]];
+            address = segment->address;
+            len = segment->data_len;
+            while(len > 0)
+            {
+                chunk_len = (len > 255) ? 255 : len;
+                _eeprom_at24cxx_bus_read(device, address, segment->data + (address - segment->address), chunk_len);
+                address += chunk_len;
+                len -= chunk_len;
+            }
+            continue;
+        }
+
+        _eeprom_at24cxx_bus_read(device, start, scratch, end - start);
+        for(k = i; k < j; k++)
+        {
+            segment = &vec[order[k]];
+            MEMCPY(segment->data, &scratch[segment->address - start], segment->data_len);
+        }
     }
+    _eeprom_at24cxx_bus_release(device);
+
+    _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_READ_BLOCK, (used > 0) ? vec[order[0]].address : 0, total, op_t0);
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : read %u bytes in %u segments\n", total, used);
+    return (_eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK) == EEPROM_STATUS_OK);
 }
 
-static uint8_t PUTINFLASH _eeprom_at24cxx_validate_byte_address(uint32_t b_address)
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceWriteV(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_IOVEC* vec, uint8_t count)
 {
-    //CHECK FOR VALIDITY OF BYTE ADDRESS
+    //WRITE A BATCH OF (ADDRESS, BUFFER, LENGTH) SEGMENTS
+    //WORKS PAGE BY PAGE IN ADDRESS ORDER, SO EVERY TOUCHED PAGE COSTS
+    //ONE WRITE CYCLE NO MATTER HOW MANY SEGMENTS FALL INTO IT. WITH THE
+    //PAGE CACHE ON SEGMENTS GO INTO THE CACHE, WHICH GROUPS THEM BY
+    //CACHE LINE ALREADY
+    //RETURN 0 IF ANY SEGMENT IS INVALID (NOTHING IS WRITTEN)
+    //OR A TRANSFER FAILED (SEE GetLastStatus)
 
-    switch(_eeprom_at24cxx_model)
+    uint8_t order[EEPROM_AT24CXX_IOV_MAX];
+    EEPROM_AT24CXX_IOVEC* segment;
+    uint8_t used;
+    uint32_t total;
+    uint32_t window_size;
+    uint32_t window;
+    uint32_t next;
+    uint8_t i;
+    _EEPROM_AT24CXX_TIMER(device, op_t0);
+    _EEPROM_AT24CXX_FAULTS(device, faults);
+
+    if(!_eeprom_at24cxx_iov_sort(device, vec, count, order, &used, &total))
     {
-        case EEPROM_MODEL_AT24C32:
-            if(b_address >= 0 && b_address <= 4095)
-                return 1;
-            else
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_WRITE_BLOCK, 0, 0, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid vectored write\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+        return 0;
+    }
+
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        if(device->cache_on)
+        {
+            //ARRAY ORDER, SO THE LATER OF TWO OVERLAPPING SEGMENTS WINS
+            for(i = 0; i < count; i++)
+            {
+                if(vec[i].data_len > 0)
+                {
+                    _eeprom_at24cxx_write_bytes(device, vec[i].address, vec[i].data, vec[i].data_len);
+                }
+            }
+            _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_WRITE_BLOCK, (used > 0) ? vec[order[0]].address : 0, total, op_t0);
+            _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : written %u bytes in %u segments\n", total, used);
+            return (_eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK) == EEPROM_STATUS_OK);
+        }
+    #endif
+
+    //WINDOW : DEVICE PAGE, OR A SCRATCH SIZED PIECE OF A LARGER PAGE
+    window_size = _EEPROM_AT24CXX_GEOMETRY(device)->page_size;
+    if(window_size > EEPROM_AT24CXX_IOV_SCRATCH)
+    {
+        window_size = EEPROM_AT24CXX_IOV_SCRATCH;
+    }
+
+    //VISIT EVERY WINDOW TOUCHED BY A SEGMENT ONCE, LOWEST FIRST
+    //(SEGMENTS ARE SORTED BY START, A LONG ONE MAY COVER SEVERAL)
+    next = 0;
+    for(i = 0; i < used; i++)
+    {
+        segment = &vec[order[i]];
+        window = segment->address / window_size;
+        if(window < next)
+        {
+            window = next;
+        }
+        for(; window <= (segment->address + segment->data_len - 1) / window_size; window++)
+        {
+            _eeprom_at24cxx_iov_write_window(device, vec, count, window, window_size);
+        }
+        if(window > next)
+        {
+            next = window;
+        }
+    }
+
+    _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_WRITE_BLOCK, (used > 0) ? vec[order[0]].address : 0, total, op_t0);
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : written %u bytes in %u segments\n", total, used);
+    return (_eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK) == EEPROM_STATUS_OK);
+}
+
+//IMAGE FUNCTIONS
+uint32_t PUTINFLASH EEPROM_AT24CXX_Crc32(uint32_t crc, const uint8_t* data, uint32_t len)
+{
+    //CRC-32 (POLY 0xEDB88320, SAME AS ZLIB crc32)
+    //START WITH crc = 0, FEED THE RESULT BACK IN TO CONTINUE A STREAM
+
+    #if !defined(__ARM_FEATURE_CRC32) && (EEPROM_AT24CXX_CRC32_TABLES == 8)
+        uint32_t lo;
+        uint32_t hi;
+    #elif !defined(__ARM_FEATURE_CRC32) && (EEPROM_AT24CXX_CRC32_TABLES == 0)
+        uint8_t i;
+    #endif
+
+    crc = ~crc;
+
+    #if defined(__ARM_FEATURE_CRC32)
+        //HARDWARE : 4 BYTES PER INSTRUCTION, SAME POLYNOMIAL
+        while(len >= 4)
+        {
+            crc = __crc32w(crc, (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+                                ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+            data += 4;
+            len -= 4;
+        }
+        while(len--)
+        {
+            crc = __crc32b(crc, *data++);
+        }
+    #elif (EEPROM_AT24CXX_CRC32_TABLES > 0)
+        #if defined(EEPROM_AT24CXX_THREAD_SAFE)
+            pthread_once(&_eeprom_at24cxx_crc32_once, _eeprom_at24cxx_crc32_build);
+        #else
+            if(!_eeprom_at24cxx_crc32_ready)
+            {
+                _eeprom_at24cxx_crc32_build();
+            }
+        #endif
+
+        #if (EEPROM_AT24CXX_CRC32_TABLES == 8)
+            //SLICING BY 8 : 8 INDEPENDENT LOOKUPS PER 8 BYTES
+            while(len >= 8)
+            {
+                lo = crc ^ ((uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+                            ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+                hi = (uint32_t)data[4] | ((uint32_t)data[5] << 8) |
+                        ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 24);
+                crc = _eeprom_at24cxx_crc32_table[7][lo & 0xFF] ^
+                        _eeprom_at24cxx_crc32_table[6][(lo >> 8) & 0xFF] ^
+                        _eeprom_at24cxx_crc32_table[5][(lo >> 16) & 0xFF] ^
+                        _eeprom_at24cxx_crc32_table[4][lo >> 24] ^
+                        _eeprom_at24cxx_crc32_table[3][hi & 0xFF] ^
+                        _eeprom_at24cxx_crc32_table[2][(hi >> 8) & 0xFF] ^
+                        _eeprom_at24cxx_crc32_table[1][(hi >> 16) & 0xFF] ^
+                        _eeprom_at24cxx_crc32_table[0][hi >> 24];
+                data += 8;
+                len -= 8;
+            }
+        #endif
+        while(len--)
+        {
+            crc = (crc >> 8) ^ _eeprom_at24cxx_crc32_table[0][(crc ^ *data++) & 0xFF];
+        }
+    #else
+        while(len--)
+        {
+            crc ^= *data++;
+            for(i = 0; i < 8; i++)
+            {
+                crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
+            }
+        }
+    #endif
+    return ~crc;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceDump(EEPROM_AT24CXX_DEVICE* device,
+                                                uint32_t address,
+                                                uint32_t len,
+                                                EEPROM_AT24CXX_IMAGE_IO sink,
+                                                void* user_data,
+                                                uint32_t* crc)
+{
+    //STREAM len BYTES FROM BYTE ADDRESS address TO sink, CHUNK BY CHUNK
+    //IN ONE SEQUENTIAL PASS. DIRTY CACHED PAGES ARE FLUSHED FIRST SO THE
+    //DUMP MATCHES WHAT THE CALLER HAS WRITTEN
+    //crc (OPTIONAL) RECEIVES THE CRC32 OF THE DUMPED BYTES
+    //RETURN 0 ON INVALID RANGE, IF sink ABORTS OR A TRANSFER FAILED
+
+    uint32_t image_crc;
+    _EEPROM_AT24CXX_TIMER(device, op_t0);
+    _EEPROM_AT24CXX_FAULTS(device, faults);
+
+    if(sink == NULL || len == 0 || address + len < address ||
+        !_eeprom_at24cxx_validate_byte_address(device, address + len - 1))
+    {
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_READ_BLOCK, address, len, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid dump range\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+        return 0;
+    }
+
+    EEPROM_AT24CXX_DeviceFlush(device);
+    if(!_eeprom_at24cxx_image_read(device, address, len, sink, user_data, &image_crc))
+    {
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_READ_BLOCK, address, len, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : dump aborted\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK);
+        return 0;
+    }
+    if(crc != NULL)
+    {
+        *crc = image_crc;
+    }
+
+    _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_READ_BLOCK, address, len, op_t0);
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : dumped %u bytes from address %u crc %08X\n", len, address, image_crc);
+    return (_eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK) == EEPROM_STATUS_OK);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceRestore(EEPROM_AT24CXX_DEVICE* device,
+                                                    uint32_t address,
+                                                    uint32_t len,
+                                                    EEPROM_AT24CXX_IMAGE_IO source,
+                                                    void* user_data,
+                                                    uint32_t* pages_written)
+{
+    //PROGRAM len BYTES FROM source AT BYTE ADDRESS address
+    //EACH CHUNK OF THE IMAGE IS COMPARED WITH WHAT THE EEPROM HOLDS AND
+    //ONLY DEVICE PAGES THAT DIFFER ARE WRITTEN, SO RESTORING A MOSTLY
+    //IDENTICAL IMAGE COSTS FEW WRITE CYCLES. ENDS WITH A VERIFY PASS
+    //AGAINST THE CRC32 OF THE STREAMED IMAGE
+    //pages_written (OPTIONAL) RECEIVES THE NUMBER OF PAGE WRITES ISSUED
+    //RETURN 0 ON INVALID RANGE, IF source ABORTS, A TRANSFER FAILED OR
+    //IF VERIFY FAILS
+
+    uint8_t image[EEPROM_AT24CXX_IMAGE_CHUNK];
+    uint8_t eeprom[EEPROM_AT24CXX_IMAGE_CHUNK];
+    uint32_t page_size = _EEPROM_AT24CXX_GEOMETRY(device)->page_size;
+    uint32_t image_crc = 0;
+    uint32_t written = 0;
+    uint32_t offset;
+    uint32_t b_address;
+    uint32_t chunk_len;
+    uint32_t n;
+    uint32_t p;
+    uint8_t ok = 1;
+    _EEPROM_AT24CXX_TIMER(device, op_t0);
+    _EEPROM_AT24CXX_FAULTS(device, faults);
+
+    if(pages_written != NULL)
+    {
+        *pages_written = 0;
+    }
+
+    if(source == NULL || len == 0 || address + len < address ||
+        !_eeprom_at24cxx_validate_byte_address(device, address + len - 1))
+    {
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_WRITE_BLOCK, address, len, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid restore range\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+        return 0;
+    }
+
+    //EEPROM IS WRITTEN BEHIND THE CACHE : NOTHING DIRTY MAY BE LEFT
+    //TO OVERWRITE THE IMAGE LATER, CACHED COPIES ARE DROPPED AT THE END
+    EEPROM_AT24CXX_DeviceFlush(device);
+
+    for(offset = 0; offset < len && ok; offset += chunk_len)
+    {
+        b_address = address + offset;
+        chunk_len = EEPROM_AT24CXX_IMAGE_CHUNK - (b_address % EEPROM_AT24CXX_IMAGE_CHUNK);
+        if(chunk_len > len - offset)
+        {
+            chunk_len = len - offset;
+        }
+
+        if(!(*source)(user_data, offset, image, chunk_len))
+        {
+            ok = 0;
+            break;
+        }
+        image_crc = EEPROM_AT24CXX_Crc32(image_crc, image, chunk_len);
+
+        _eeprom_at24cxx_bus_acquire(device);
+        _eeprom_at24cxx_bus_read(device, b_address, eeprom, chunk_len);
+        for(p = 0; p < chunk_len; p += n)
+        {
+            n = page_size - ((b_address + p) % page_size);
+            if(n > chunk_len - p)
+            {
+                n = chunk_len - p;
+            }
+            if(MEMCMP(&image[p], &eeprom[p], n) != 0)
+            {
+                _eeprom_at24cxx_write_span_locked(device, b_address + p, &image[p], n);
+                written++;
+            }
+        }
+        _eeprom_at24cxx_bus_release(device);
+        if(device->fault_count != faults)
+        {
+            ok = 0;
+        }
+    }
+
+    EEPROM_AT24CXX_DeviceInvalidateCache(device, address, ADDRESS_TYPE_BYTE, len);
+    if(pages_written != NULL)
+    {
+        *pages_written = written;
+    }
+
+    if(!ok)
+    {
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_WRITE_BLOCK, address, len, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : restore aborted\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK);
+        return 0;
+    }
+
+    ok = EEPROM_AT24CXX_DeviceVerify(device, address, len, image_crc);
+    if(!ok)
+    {
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_WRITE_BLOCK, address, len, op_t0);
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : restore verify failed !\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK);
+        return 0;
+    }
+
+    _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_WRITE_BLOCK, address, len, op_t0);
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : restored %u bytes at address %u (%u page writes)\n", len, address, written);
+    return (_eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK) == EEPROM_STATUS_OK);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceVerify(EEPROM_AT24CXX_DEVICE* device, uint32_t address, uint32_t len, uint32_t crc)
+{
+    //CHECK CRC32 OF len BYTES AT BYTE ADDRESS address AGAINST crc
+    //DIRTY CACHED PAGES ARE FLUSHED FIRST, THE EEPROM ITSELF IS CHECKED
+    //RETURN 1 IF IT MATCHES AND NO TRANSFER FAILED
+
+    uint32_t eeprom_crc;
+    _EEPROM_AT24CXX_FAULTS(device, faults);
+
+    if(len == 0 || address + len < address ||
+        !_eeprom_at24cxx_validate_byte_address(device, address + len - 1))
+    {
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid verify range\n");
+        _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+        return 0;
+    }
+
+    EEPROM_AT24CXX_DeviceFlush(device);
+    _eeprom_at24cxx_image_read(device, address, len, NULL, NULL, &eeprom_crc);
+    return (_eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK) == EEPROM_STATUS_OK && eeprom_crc == crc);
+}
+
+//REQUEST QUEUE FUNCTIONS
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceSubmit(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_REQUEST* request)
+{
+    //QUEUE A CALLER OWNED REQUEST FOR THE BUS OWNER TO EXECUTE
+    //SAFE TO CALL FROM ANY THREAD. REQUEST MUST STAY VALID TILL DONE
+    //RETURN 1 IF QUEUED, 0 IF QUEUE IS FULL OR REQUEST IS INVALID
+
+    if(request->type >= EEPROM_REQUEST_MAX)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid request type !\n");
+        return 0;
+    }
+
+    if(request->type != EEPROM_REQUEST_FLUSH)
+    {
+        if(request->data_len > _eeprom_at24cxx_get_size(device) ||
+            request->address > _eeprom_at24cxx_get_size(device) - request->data_len)
+        {
+            _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid address request\n");
+            return 0;
+        }
+    }
+    else
+    {
+        request->data_len = 0;
+    }
+
+    request->progress = 0;
+    request->status = EEPROM_STATUS_OK;
+    request->done = 0;
+
+    _EEPROM_AT24CXX_LOCK(device->queue_lock);
+    if(device->queue_count >= EEPROM_AT24CXX_QUEUE_DEPTH)
+    {
+        _EEPROM_AT24CXX_UNLOCK(device->queue_lock);
+        return 0;
+    }
+    device->queue[(device->queue_head + device->queue_count) % EEPROM_AT24CXX_QUEUE_DEPTH] = request;
+    device->queue_count++;
+    _EEPROM_AT24CXX_UNLOCK(device->queue_lock);
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceProcessQueue(EEPROM_AT24CXX_DEVICE* device, uint8_t max_requests)
+{
+    //EXECUTE UP TO max_requests QUEUED REQUESTS (0 = ALL) IN ORDER
+    //BLOCKING VERSION OF Tick : WRITE CYCLES ARE WAITED OUT HERE
+    //MEANT TO BE CALLED BY A SINGLE BUS OWNER THREAD
+    //RETURN NUMBER OF REQUESTS EXECUTED
+
+    uint8_t count = 0;
+
+    while(max_requests == 0 || count < max_requests)
+    {
+        switch(EEPROM_AT24CXX_DeviceTick(device))
+        {
+            case EEPROM_TICK_IDLE:
+                return count;
+            case EEPROM_TICK_BUSY:
+                _eeprom_at24cxx_bus_acquire(device);
+                _eeprom_at24cxx_bus_release(device);
+                break;
+            case EEPROM_TICK_DONE:
+                count++;
+                break;
+            default:
+                break;
+        }
+    }
+    return count;
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceWaitRequest(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_REQUEST* request)
+{
+    //BLOCK TILL SUBMITTED REQUEST IS DONE, RETURN ITS STATUS
+    //WITHOUT THREAD SUPPORT THE CALLER IS THE BUS OWNER, SO THE QUEUE
+    //IS PROCESSED HERE INSTEAD
+
+    #if defined(EEPROM_AT24CXX_THREAD_SAFE)
+        _EEPROM_AT24CXX_LOCK(device->queue_lock);
+        while(!request->done)
+        {
+            _EEPROM_AT24CXX_COND_WAIT(device->queue_done, device->queue_lock);
+        }
+        _EEPROM_AT24CXX_UNLOCK(device->queue_lock);
+    #else
+        while(!request->done)
+        {
+            if(EEPROM_AT24CXX_DeviceProcessQueue(device, 1) == 0)
+            {
+                //NOT QUEUED ON THIS DEVICE
+                return EEPROM_STATUS_INVALID;
+            }
+        }
+    #endif
+    return request->status;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceReadAsync(EEPROM_AT24CXX_DEVICE* device,
+                                                    EEPROM_AT24CXX_REQUEST* request,
+                                                    uint32_t address,
+                                                    EEPROM_ADDRESS_TYPE address_type,
+                                                    uint8_t* data,
+                                                    uint32_t data_len,
+                                                    void (*callback)(EEPROM_AT24CXX_REQUEST*),
+                                                    void* user_data)
+{
+    //QUEUE A READ AND RETURN AT ONCE
+    //callback IS CALLED FROM Tick ONCE data IS FILLED IN
+    //RETURN 1 IF QUEUED, 0 IF QUEUE IS FULL OR ADDRESS IS INVALID
+
+    if(address_type >= ADDRESS_TYPE_MAX)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid address type !\n");
+        return 0;
+    }
+
+    if(!_eeprom_at24cxx_get_byte_address(device, address, address_type, &request->address) ||
+        (data_len > 0 && (request->address + data_len < request->address ||
+            !_eeprom_at24cxx_validate_byte_address(device, request->address + data_len - 1))))
+    {
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid address read\n");
+        return 0;
+    }
+
+    request->type = EEPROM_REQUEST_READ;
+    request->data = data;
+    request->data_len = data_len;
+    request->callback = callback;
+    request->user_data = user_data;
+    return EEPROM_AT24CXX_DeviceSubmit(device, request);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceWriteAsync(EEPROM_AT24CXX_DEVICE* device,
+                                                    EEPROM_AT24CXX_REQUEST* request,
+                                                    uint32_t address,
+                                                    EEPROM_ADDRESS_TYPE address_type,
+                                                    uint8_t* data,
+                                                    uint32_t data_len,
+                                                    void (*callback)(EEPROM_AT24CXX_REQUEST*),
+                                                    void* user_data)
+{
+    //QUEUE A WRITE AND RETURN AT ONCE
+    //data MUST STAY VALID TILL callback IS CALLED FROM Tick
+    //RETURN 1 IF QUEUED, 0 IF QUEUE IS FULL OR ADDRESS IS INVALID
+
+    if(address_type >= ADDRESS_TYPE_MAX)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid address type !\n");
+        return 0;
+    }
+
+    if(!_eeprom_at24cxx_get_byte_address(device, address, address_type, &request->address) ||
+        (data_len > 0 && (request->address + data_len < request->address ||
+            !_eeprom_at24cxx_validate_byte_address(device, request->address + data_len - 1))))
+    {
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid address write\n");
+        return 0;
+    }
+
+    request->type = EEPROM_REQUEST_WRITE;
+    request->data = data;
+    request->data_len = data_len;
+    request->callback = callback;
+    request->user_data = user_data;
+    return EEPROM_AT24CXX_DeviceSubmit(device, request);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceFlushAsync(EEPROM_AT24CXX_DEVICE* device,
+                                                    EEPROM_AT24CXX_REQUEST* request,
+                                                    void (*callback)(EEPROM_AT24CXX_REQUEST*),
+                                                    void* user_data)
+{
+    //QUEUE A CACHE FLUSH AND RETURN AT ONCE
+    //callback IS CALLED FROM Tick ONCE THE LAST WRITE CYCLE IS OVER
+    //RETURN 1 IF QUEUED, 0 IF QUEUE IS FULL
+
+    request->type = EEPROM_REQUEST_FLUSH;
+    request->address = 0;
+    request->data = NULL;
+    request->data_len = 0;
+    request->callback = callback;
+    request->user_data = user_data;
+    return EEPROM_AT24CXX_DeviceSubmit(device, request);
+}
+
+EEPROM_TICK_STATE PUTINFLASH EEPROM_AT24CXX_DeviceTick(EEPROM_AT24CXX_DEVICE* device)
+{
+    //ADVANCE THE REQUEST AT THE HEAD OF THE QUEUE BY ONE BUS TRANSFER
+    //(ONE PAGE WRITE, ONE READ OF UP TO 255 BYTES OR ONE CACHED PAGE
+    //COMMIT). NEVER WAITS FOR A WRITE CYCLE : IF ONE IS STILL RUNNING
+    //RETURN EEPROM_TICK_BUSY SO THE CALLER CAN GET BACK TO ITS LOOP
+    //WITH THE PAGE CACHE ON, A PREFETCHING CACHE MISS THAT EVICTS MORE
+    //THAN ONE DIRTY PAGE MAY STILL WAIT FOR A WRITE CYCLE
+    //MEANT TO BE CALLED BY A SINGLE BUS OWNER
+    //A TRANSFER THAT FAILS AFTER RETRIES ENDS THE REQUEST WITH ITS STATUS
+
+    EEPROM_AT24CXX_REQUEST* request;
+    uint32_t chunk_len;
+    uint32_t page_size;
+    uint32_t page_left;
+    uint32_t faults;
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        EEPROM_AT24CXX_CACHE_PAGE* entry;
+    #endif
+
+    _EEPROM_AT24CXX_LOCK(device->bus_lock);
+    if(device->write_busy)
+    {
+        if(!_eeprom_at24cxx_write_cycle_done(device))
+        {
+            _EEPROM_AT24CXX_UNLOCK(device->bus_lock);
+            return EEPROM_TICK_BUSY;
+        }
+        device->write_busy = 0;
+    }
+    _EEPROM_AT24CXX_UNLOCK(device->bus_lock);
+
+    //WRITE BACK LIMITS AND POWER FAIL GO AHEAD OF QUEUED REQUESTS
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        _EEPROM_AT24CXX_LOCK(device->cache_lock);
+        entry = _eeprom_at24cxx_cache_due(device);
+        if(entry != NULL)
+        {
+            _eeprom_at24cxx_cache_flush_page(device, entry);
+            _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+            return EEPROM_TICK_PROGRESS;
+        }
+        _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+    #endif
+
+    _EEPROM_AT24CXX_LOCK(device->queue_lock);
+    if(device->queue_count == 0)
+    {
+        _EEPROM_AT24CXX_UNLOCK(device->queue_lock);
+        return EEPROM_TICK_IDLE;
+    }
+    request = device->queue[device->queue_head];
+    _EEPROM_AT24CXX_UNLOCK(device->queue_lock);
+
+    //ONE PAGE PER TICK FOR WRITES AND CACHED READS, SO AT MOST ONE
+    //PAGE WRITE (DIRECT OR A CACHE EVICTION) IS ISSUED PER TICK
+    //(CACHE LINE WITH THE CACHE ON, DEVICE PAGE WITH IT OFF)
+    chunk_len = request->data_len - request->progress;
+    page_size = _EEPROM_AT24CXX_GEOMETRY(device)->page_size;
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        if(device->cache_on)
+        {
+            page_size = EEPROM_AT24CXX_CACHE_LINE_SIZE;
+        }
+    #endif
+    page_left = page_size - ((request->address + request->progress) % page_size);
+    faults = device->fault_count;
+    switch(request->type)
+    {
+        case EEPROM_REQUEST_READ:
+            if(chunk_len > 255)
+            {
+                chunk_len = 255;
+            }
+            #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+                if(device->cache_on && chunk_len > page_left)
+                {
+                    chunk_len = page_left;
+                }
+            #endif
+            if(chunk_len > 0)
+            {
+                _eeprom_at24cxx_read_bytes(device, request->address + request->progress, request->data + request->progress, chunk_len);
+            }
+            request->progress += chunk_len;
+            break;
+
+        case EEPROM_REQUEST_WRITE:
+            if(chunk_len > page_left)
+            {
+                chunk_len = page_left;
+            }
+            if(chunk_len > 0)
+            {
+                _eeprom_at24cxx_write_bytes(device, request->address + request->progress, request->data + request->progress, chunk_len);
+            }
+            request->progress += chunk_len;
+            break;
+
+        case EEPROM_REQUEST_FLUSH:
+            #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+                if(_eeprom_at24cxx_cache_flush_one(device) && device->fault_count == faults)
+                {
+                    return EEPROM_TICK_PROGRESS;
+                }
+            #endif
+            break;
+
+        default:
+            break;
+    }
+
+    if(device->fault_count != faults)
+    {
+        request->status = device->fault_status;
+    }
+    else if(request->progress < request->data_len)
+    {
+        return EEPROM_TICK_PROGRESS;
+    }
+
+    _eeprom_at24cxx_request_complete(device, request);
+    return EEPROM_TICK_DONE;
+}
+
+//DEFAULT DEVICE FUNCTIONS
+//KEPT FOR SINGLE EEPROM USERS. ALL OPERATE ON A LIBRARY OWNED DEVICE
+void PUTINFLASH EEPROM_AT24CXX_SetI2CFunctions(void (*i2c_init)(void),
+                                            EEPROM_STATUS (*i2c_writebyte)(uint8_t, uint32_t, uint8_t, uint8_t),
+                                            EEPROM_STATUS (*i2c_writebytemultiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t),
+                                            EEPROM_STATUS (*i2c_readbyte)(uint8_t, uint32_t, uint8_t, uint8_t*),
+                                            EEPROM_STATUS (*i2c_readbytemultiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t)
+                                          )
+{
+    EEPROM_AT24CXX_DeviceSetI2CFunctions(&_eeprom_at24cxx_device, i2c_init, i2c_writebyte, i2c_writebytemultiple, i2c_readbyte, i2c_readbytemultiple);
+}
+
+void PUTINFLASH EEPROM_AT24CXX_SetI2CAckPollFunction(uint8_t (*i2c_ackpoll)(uint8_t))
+{
+    EEPROM_AT24CXX_DeviceSetI2CAckPollFunction(&_eeprom_at24cxx_device, i2c_ackpoll);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SetI2CClockFunction(void (*i2c_set_clock)(uint32_t), uint32_t min_hz, uint32_t max_hz)
+{
+    return EEPROM_AT24CXX_DeviceSetI2CClockFunction(&_eeprom_at24cxx_device, i2c_set_clock, min_hz, max_hz);
+}
+
+void PUTINFLASH EEPROM_AT24CXX_SetTimeFunction(uint32_t (*get_time_us)(void))
+{
+    EEPROM_AT24CXX_DeviceSetTimeFunction(&_eeprom_at24cxx_device, get_time_us);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SetCache(uint8_t cache_on)
+{
+    return EEPROM_AT24CXX_DeviceSetCache(&_eeprom_at24cxx_device, cache_on);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SetCachePrefetch(uint8_t pages)
+{
+    return EEPROM_AT24CXX_DeviceSetCachePrefetch(&_eeprom_at24cxx_device, pages);
+}
+
+void PUTINFLASH EEPROM_AT24CXX_SetCompareWrite(uint8_t compare_on)
+{
+    EEPROM_AT24CXX_DeviceSetCompareWrite(&_eeprom_at24cxx_device, compare_on);
+}
+
+void PUTINFLASH EEPROM_AT24CXX_SetWriteBack(uint32_t max_age_ms, uint16_t max_dirty)
+{
+    EEPROM_AT24CXX_DeviceSetWriteBack(&_eeprom_at24cxx_device, max_age_ms, max_dirty);
+}
+
+void PUTINFLASH EEPROM_AT24CXX_PowerFail(void)
+{
+    EEPROM_AT24CXX_DevicePowerFail(&_eeprom_at24cxx_device);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_GetI2CAddress(void)
+{
+    return EEPROM_AT24CXX_DeviceGetI2CAddress(&_eeprom_at24cxx_device);
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_GetSize(void)
+{
+    return EEPROM_AT24CXX_DeviceGetSize(&_eeprom_at24cxx_device);
+}
+
+uint16_t PUTINFLASH EEPROM_AT24CXX_GetPageSize(void)
+{
+    return EEPROM_AT24CXX_DeviceGetPageSize(&_eeprom_at24cxx_device);
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_GetWritesElided(void)
+{
+    return EEPROM_AT24CXX_DeviceGetWritesElided(&_eeprom_at24cxx_device);
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_GetClock(void)
+{
+    return EEPROM_AT24CXX_DeviceGetClock(&_eeprom_at24cxx_device);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_GetLastStatus(void)
+{
+    return EEPROM_AT24CXX_DeviceGetLastStatus(&_eeprom_at24cxx_device);
+}
+
+const EEPROM_AT24CXX_GEOMETRY* PUTINFLASH EEPROM_AT24CXX_GetModelGeometry(EEPROM_MODEL_TYPE model)
+{
+    //RETURN GEOMETRY OF A MODEL (NULL IF INVALID)
+    //USEFUL TO SET UP A SIMULATED DEVICE BEFORE THE DRIVER
+
+    if(model >= EEPROM_MODEL_MAX)
+    {
+        return NULL;
+    }
+    return &_eeprom_at24cxx_geometry[model];
+}
+
+#if defined(EEPROM_AT24CXX_STATS)
+void PUTINFLASH EEPROM_AT24CXX_GetStats(EEPROM_AT24CXX_STATISTICS* stats)
+{
+    EEPROM_AT24CXX_DeviceGetStats(&_eeprom_at24cxx_device, stats);
+}
+
+void PUTINFLASH EEPROM_AT24CXX_ResetStats(void)
+{
+    EEPROM_AT24CXX_DeviceResetStats(&_eeprom_at24cxx_device);
+}
+#endif
+
+#if defined(EEPROM_AT24CXX_TRACE)
+uint32_t PUTINFLASH EEPROM_AT24CXX_TraceDump(uint8_t* buffer, uint32_t buffer_len)
+{
+    return EEPROM_AT24CXX_DeviceTraceDump(&_eeprom_at24cxx_device, buffer, buffer_len);
+}
+
+void PUTINFLASH EEPROM_AT24CXX_TraceReset(void)
+{
+    EEPROM_AT24CXX_DeviceTraceReset(&_eeprom_at24cxx_device);
+}
+#endif
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_Initialize(EEPROM_MODEL_TYPE model, uint8_t a2, uint8_t a1, uint8_t a0)
+{
+    return EEPROM_AT24CXX_DeviceInitialize(&_eeprom_at24cxx_device, model, a2, a1, a0);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_Write8(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t data)
+{
+    return EEPROM_AT24CXX_DeviceWrite8(&_eeprom_at24cxx_device, address, address_type, data);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_Write16(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint16_t data)
+{
+    return EEPROM_AT24CXX_DeviceWrite16(&_eeprom_at24cxx_device, address, address_type, data);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_Write32(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint32_t data)
+{
+    return EEPROM_AT24CXX_DeviceWrite32(&_eeprom_at24cxx_device, address, address_type, data);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_WriteBlock(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len)
+{
+    return EEPROM_AT24CXX_DeviceWriteBlock(&_eeprom_at24cxx_device, address, address_type, data, data_len);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_WriteBlockIfChanged(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len)
+{
+    return EEPROM_AT24CXX_DeviceWriteBlockIfChanged(&_eeprom_at24cxx_device, address, address_type, data, data_len);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_Flush(void)
+{
+    return EEPROM_AT24CXX_DeviceFlush(&_eeprom_at24cxx_device);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_InvalidateCache(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint32_t data_len)
+{
+    return EEPROM_AT24CXX_DeviceInvalidateCache(&_eeprom_at24cxx_device, address, address_type, data_len);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_Read8(uint32_t address, EEPROM_ADDRESS_TYPE address_type)
+{
+    return EEPROM_AT24CXX_DeviceRead8(&_eeprom_at24cxx_device, address, address_type);
+}
+
+uint16_t PUTINFLASH EEPROM_AT24CXX_Read16(uint32_t address, EEPROM_ADDRESS_TYPE address_type)
+{
+    return EEPROM_AT24CXX_DeviceRead16(&_eeprom_at24cxx_device, address, address_type);
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_Read32(uint32_t address, EEPROM_ADDRESS_TYPE address_type)
+{
+    return EEPROM_AT24CXX_DeviceRead32(&_eeprom_at24cxx_device, address, address_type);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_ReadBlock(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len)
+{
+    return EEPROM_AT24CXX_DeviceReadBlock(&_eeprom_at24cxx_device, address, address_type, data, data_len);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_ReadV(EEPROM_AT24CXX_IOVEC* vec, uint8_t count)
+{
+    return EEPROM_AT24CXX_DeviceReadV(&_eeprom_at24cxx_device, vec, count);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_WriteV(EEPROM_AT24CXX_IOVEC* vec, uint8_t count)
+{
+    return EEPROM_AT24CXX_DeviceWriteV(&_eeprom_at24cxx_device, vec, count);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_Dump(uint32_t address, uint32_t len, EEPROM_AT24CXX_IMAGE_IO sink, void* user_data, uint32_t* crc)
+{
+    return EEPROM_AT24CXX_DeviceDump(&_eeprom_at24cxx_device, address, len, sink, user_data, crc);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_Restore(uint32_t address, uint32_t len, EEPROM_AT24CXX_IMAGE_IO source, void* user_data, uint32_t* pages_written)
+{
+    return EEPROM_AT24CXX_DeviceRestore(&_eeprom_at24cxx_device, address, len, source, user_data, pages_written);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_Verify(uint32_t address, uint32_t len, uint32_t crc)
+{
+    return EEPROM_AT24CXX_DeviceVerify(&_eeprom_at24cxx_device, address, len, crc);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_ReadAsync(EEPROM_AT24CXX_REQUEST* request,
+                                            uint32_t address,
+                                            EEPROM_ADDRESS_TYPE address_type,
+                                            uint8_t* data,
+                                            uint32_t data_len,
+                                            void (*callback)(EEPROM_AT24CXX_REQUEST*),
+                                            void* user_data)
+{
+    return EEPROM_AT24CXX_DeviceReadAsync(&_eeprom_at24cxx_device, request, address, address_type, data, data_len, callback, user_data);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_WriteAsync(EEPROM_AT24CXX_REQUEST* request,
+                                            uint32_t address,
+                                            EEPROM_ADDRESS_TYPE address_type,
+                                            uint8_t* data,
+                                            uint32_t data_len,
+                                            void (*callback)(EEPROM_AT24CXX_REQUEST*),
+                                            void* user_data)
+{
+    return EEPROM_AT24CXX_DeviceWriteAsync(&_eeprom_at24cxx_device, request, address, address_type, data, data_len, callback, user_data);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_FlushAsync(EEPROM_AT24CXX_REQUEST* request,
+                                            void (*callback)(EEPROM_AT24CXX_REQUEST*),
+                                            void* user_data)
+{
+    return EEPROM_AT24CXX_DeviceFlushAsync(&_eeprom_at24cxx_device, request, callback, user_data);
+}
+
+EEPROM_TICK_STATE PUTINFLASH EEPROM_AT24CXX_Tick(void)
+{
+    return EEPROM_AT24CXX_DeviceTick(&_eeprom_at24cxx_device);
+}
+
+//MULTI DEVICE ARRAY FUNCTIONS
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_ArrayInitialize(EEPROM_AT24CXX_ARRAY* array,
+                                                        EEPROM_ARRAY_TYPE type,
+                                                        EEPROM_AT24CXX_DEVICE** devices,
+                                                        uint8_t device_count)
+{
+    //GROUP ALREADY INITIALIZED DEVICES INTO ONE LINEAR ADDRESS SPACE
+    //CONCAT : DEVICES FOLLOW EACH OTHER. SIZE IS SUM OF DEVICE SIZES
+    //STRIPE : CONSECUTIVE PAGES GO TO CONSECUTIVE DEVICES SO LONG
+    //         WRITES OVERLAP THE WRITE CYCLES OF ALL DEVICES. SIZE IS
+    //         SMALLEST DEVICE SIZE TIMES NUMBER OF DEVICES
+
+    uint32_t size;
+    uint32_t min_size;
+    uint8_t i;
+
+    array->size = 0;
+
+    if(type >= EEPROM_ARRAY_MAX)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid array type !\n");
+        return EEPROM_STATUS_INVALID;
+    }
+
+    if(device_count == 0 || device_count > EEPROM_AT24CXX_ARRAY_MAX_DEVICES)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid array device count !\n");
+        return EEPROM_STATUS_INVALID;
+    }
+
+    array->type = type;
+    array->device_count = device_count;
+
+    min_size = 0xFFFFFFFF;
+    size = 0;
+    for(i = 0; i < device_count; i++)
+    {
+        array->device[i] = devices[i];
+        size += _eeprom_at24cxx_get_size(devices[i]);
+        if(_eeprom_at24cxx_get_size(devices[i]) < min_size)
+        {
+            min_size = _eeprom_at24cxx_get_size(devices[i]);
+        }
+    }
+
+    if(type == EEPROM_ARRAY_CONCAT)
+        array->size = size;
+    else
+        array->size = min_size * device_count;
+
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : array of %u devices initialized. size = %u\n", device_count, array->size);
+    return EEPROM_STATUS_OK;
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_ArrayGetSize(EEPROM_AT24CXX_ARRAY* array)
+{
+    //RETURN ARRAY CAPACITY IN BYTES
+
+    return array->size;
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_ArrayWriteBlock(EEPROM_AT24CXX_ARRAY* array, uint32_t address, uint8_t* data, uint32_t data_len)
+{
+    //WRITE BLOCK AT SPECIFIED ARRAY BYTE ADDRESS
+    //A DEVICE IS ONLY WAITED ON WHEN IT IS ACCESSED AGAIN, SO WRITE
+    //CYCLES OF DIFFERENT DEVICES RUN IN PARALLEL
+
+    EEPROM_STATUS status;
+    uint32_t b_address;
+    uint32_t chunk_len;
+    uint32_t faults;
+    uint8_t index;
+
+    if(data_len == 0 || address >= array->size || data_len > array->size - address)
+    {
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid array address write\n");
+        return EEPROM_STATUS_INVALID;
+    }
+
+    while(data_len > 0)
+    {
+        index = _eeprom_at24cxx_array_map(array, address, &b_address, &chunk_len);
+        if(chunk_len > data_len)
+        {
+            chunk_len = data_len;
+        }
+
+        faults = array->device[index]->fault_count;
+        _eeprom_at24cxx_write_checked(array->device[index], b_address, data, chunk_len, array->device[index]->compare_write);
+        status = _eeprom_at24cxx_result(array->device[index], faults, EEPROM_STATUS_OK);
+        if(status != EEPROM_STATUS_OK)
+        {
+            return status;
+        }
+
+        address += chunk_len;
+        data += chunk_len;
+        data_len -= chunk_len;
+    }
+    return EEPROM_STATUS_OK;
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_ArrayReadBlock(EEPROM_AT24CXX_ARRAY* array, uint32_t address, uint8_t* data, uint32_t data_len)
+{
+    //READ BLOCK FROM SPECIFIED ARRAY BYTE ADDRESS
+
+    EEPROM_STATUS status;
+    uint32_t b_address;
+    uint32_t chunk_len;
+    uint32_t faults;
+    uint8_t index;
+
+    if(data_len == 0 || address >= array->size || data_len > array->size - address)
+    {
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid array address read\n");
+        return EEPROM_STATUS_INVALID;
+    }
+
+    while(data_len > 0)
+    {
+        index = _eeprom_at24cxx_array_map(array, address, &b_address, &chunk_len);
+        if(chunk_len > data_len)
+        {
+            chunk_len = data_len;
+        }
+
+        faults = array->device[index]->fault_count;
+        _eeprom_at24cxx_read_bytes(array->device[index], b_address, data, chunk_len);
+        status = _eeprom_at24cxx_result(array->device[index], faults, EEPROM_STATUS_OK);
+        if(status != EEPROM_STATUS_OK)
+        {
+            return status;
+        }
+
+        address += chunk_len;
+        data += chunk_len;
+        data_len -= chunk_len;
+    }
+    return EEPROM_STATUS_OK;
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_ArrayFlush(EEPROM_AT24CXX_ARRAY* array)
+{
+    //COMMIT DIRTY CACHED PAGES OF ALL ARRAY DEVICES
+    //RETURN STATUS OF THE FIRST DEVICE THAT FAILED
+
+    EEPROM_STATUS status = EEPROM_STATUS_OK;
+    EEPROM_STATUS device_status;
+    uint8_t i;
+
+    for(i = 0; i < array->device_count; i++)
+    {
+        device_status = EEPROM_AT24CXX_DeviceFlush(array->device[i]);
+        if(status == EEPROM_STATUS_OK)
+        {
+            status = device_status;
+        }
+    }
+    return status;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_validate_page_address(EEPROM_AT24CXX_DEVICE* device, uint32_t p_address)
+{
+    //CHECK FOR VALIDITY OF PAGE ADDRESS
+
+    return (p_address < _EEPROM_AT24CXX_GEOMETRY(device)->size / _EEPROM_AT24CXX_GEOMETRY(device)->page_size);
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_validate_byte_address(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address)
+{
+    //CHECK FOR VALIDITY OF BYTE ADDRESS
+
+    return (b_address < _EEPROM_AT24CXX_GEOMETRY(device)->size);
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_get_byte_address(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint32_t* b_address)
+{
+    //CONVERT ADDRESS OF SPECIFIED TYPE TO BYTE ADDRESS
+    //RETURN 0 IF ADDRESS IS INVALID
+
+    switch(address_type)
+    {
+        case ADDRESS_TYPE_BYTE:
+            if(!_eeprom_at24cxx_validate_byte_address(device, address))
                 return 0;
+            *b_address = address;
+            return 1;
+        case ADDRESS_TYPE_PAGE:
+            if(!_eeprom_at24cxx_validate_page_address(device, address))
+                return 0;
+            *b_address = address * _EEPROM_AT24CXX_GEOMETRY(device)->page_size;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_write_block(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len, uint8_t compare)
+{
+    //VALIDATE AND WRITE A BLOCK (DeviceWriteBlock / WriteBlockIfChanged)
+
+    uint32_t b_address;
+    _EEPROM_AT24CXX_TIMER(device, op_t0);
+    _EEPROM_AT24CXX_FAULTS(device, faults);
+
+    if(address_type >= ADDRESS_TYPE_MAX)
+    {
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_WRITE_BLOCK, address, data_len, op_t0);
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : Invalid address type !\n");
+        return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+    }
+
+    if(data_len == 0)
+    {
+        return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK);
+    }
+
+    if(!_eeprom_at24cxx_get_byte_address(device, address, address_type, &b_address) ||
+        b_address + data_len < b_address ||
+        !_eeprom_at24cxx_validate_byte_address(device, b_address + data_len - 1))
+    {
+        _EEPROM_AT24CXX_OP_ERROR(device, EEPROM_STATS_OP_WRITE_BLOCK, address, data_len, op_t0);
+        _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : Invalid address write\n");
+        return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_INVALID);
+    }
+
+    _eeprom_at24cxx_write_checked(device, b_address, data, data_len, compare);
+    _EEPROM_AT24CXX_OP_DONE(device, EEPROM_STATS_OP_WRITE_BLOCK, address, data_len, op_t0);
+    _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : written %u bytes at %s %u\n", data_len, (address_type == ADDRESS_TYPE_BYTE) ? "address" : "page", address);
+    return _eeprom_at24cxx_result(device, faults, EEPROM_STATUS_OK);
+}
+
+static void PUTINFLASH _eeprom_at24cxx_write_checked(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len, uint8_t compare)
+{
+    //WRITE DATA AT BYTE ADDRESS, OPTIONALLY COMPARING FIRST
+    //WITH compare SET EACH DEVICE PAGE OF THE RANGE IS READ (THROUGH THE
+    //CACHE IF ON) AND ONLY THE SPAN FROM ITS FIRST TO LAST CHANGED BYTE
+    //IS WRITTEN. AN UNCHANGED PAGE IS NOT WRITTEN AT ALL
+
+    uint8_t current[EEPROM_AT24CXX_PAGE_SIZE];
+    uint32_t page_size = _EEPROM_AT24CXX_GEOMETRY(device)->page_size;
+    uint32_t page_len;
+    uint32_t first;
+    uint32_t last;
+    uint32_t pos;
+    uint32_t n;
+    uint32_t i;
+
+    if(!compare)
+    {
+        _eeprom_at24cxx_write_bytes(device, b_address, data, data_len);
+        return;
+    }
+
+    while(data_len > 0)
+    {
+        page_len = page_size - (b_address % page_size);
+        if(page_len > data_len)
+        {
+            page_len = data_len;
+        }
+
+        first = page_len;
+        last = 0;
+        for(pos = 0; pos < page_len; pos += n)
+        {
+            n = (page_len - pos > sizeof(current)) ? sizeof(current) : page_len - pos;
+            _eeprom_at24cxx_read_bytes(device, b_address + pos, current, n);
+            for(i = 0; i < n; i++)
+            {
+                if(current[i] != data[pos + i])
+                {
+                    if(first == page_len)
+                    {
+                        first = pos + i;
+                    }
+                    last = pos + i;
+                }
+            }
+        }
+
+        if(first == page_len)
+        {
+            device->writes_elided++;
+        }
+        else
+        {
+            _eeprom_at24cxx_write_bytes(device, b_address + first, data + first, last - first + 1);
+        }
+
+        b_address += page_len;
+        data += page_len;
+        data_len -= page_len;
+    }
+}
+
+static void PUTINFLASH _eeprom_at24cxx_write_bytes(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len)
+{
+    //WRITE DATA AT BYTE ADDRESS
+    //GOES INTO PAGE CACHE IF ENABLED, ELSE STRAIGHT TO EEPROM
+
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        EEPROM_AT24CXX_CACHE_PAGE* entry;
+
+        if(device->cache_on)
+        {
+            _EEPROM_AT24CXX_LOCK(device->cache_lock);
+            _eeprom_at24cxx_cache_write(device, b_address, data, data_len);
+            while((entry = _eeprom_at24cxx_cache_due(device)) != NULL)
+            {
+                _eeprom_at24cxx_cache_flush_page(device, entry);
+            }
+            _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+            return;
+        }
+    #endif
+    _eeprom_at24cxx_write_chunked(device, b_address, data, data_len);
+}
+
+static void PUTINFLASH _eeprom_at24cxx_read_bytes(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len)
+{
+    //READ DATA FROM BYTE ADDRESS
+    //SMALL READS ARE SERVED THROUGH THE PAGE CACHE IF ENABLED. LARGE
+    //READS BYPASS IT (SO THEY DO NOT FLUSH OUT HOT PAGES) BUT CACHED
+    //BYTES STILL TAKE PRECEDENCE OVER EEPROM CONTENT
+
+    uint32_t address = b_address;
+    uint8_t* ptr = data;
+    uint32_t len = data_len;
+    uint32_t chunk_len;
+
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        if(device->cache_on && data_len < EEPROM_AT24CXX_CACHE_PAGES * EEPROM_AT24CXX_CACHE_LINE_SIZE)
+        {
+            _EEPROM_AT24CXX_LOCK(device->cache_lock);
+            _eeprom_at24cxx_cache_read(device, b_address, data, data_len);
+            _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+            return;
+        }
+    #endif
+
+    _eeprom_at24cxx_bus_acquire(device);
+    while(len > 0)
+    {
+        chunk_len = (len > 255) ? 255 : len;
+        _eeprom_at24cxx_bus_read(device, address, ptr, chunk_len);
+        address += chunk_len;
+        ptr += chunk_len;
+        len -= chunk_len;
+    }
+    _eeprom_at24cxx_bus_release(device);
+
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        if(device->cache_on)
+        {
+            _EEPROM_AT24CXX_LOCK(device->cache_lock);
+            _eeprom_at24cxx_cache_overlay(device, b_address, data, data_len);
+            _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+        }
+    #endif
+}
+
+static uint32_t PUTINFLASH _eeprom_at24cxx_get_size(EEPROM_AT24CXX_DEVICE* device)
+{
+    //RETURN EEPROM CAPACITY IN BYTES
+
+    return _EEPROM_AT24CXX_GEOMETRY(device)->size;
+}
+
+static void PUTINFLASH _eeprom_at24cxx_write_chunked(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len)
+{
+    //WRITE DATA SPLIT INTO PAGE ALIGNED CHUNKS SO THAT THE EEPROM
+    //WRITE ROLLOVER (NOTE 3) NEVER WRAPS DATA INSIDE A PAGE
+    //THE WRITE CYCLE OF EACH CHUNK IS WAITED OUT BEFORE THE NEXT BUS
+    //TRANSFER TO THE DEVICE (SEE _eeprom_at24cxx_bus_acquire)
+    //STOPS AT THE FIRST CHUNK THAT FAILS (FAULT IS ALREADY RECORDED)
+
+    EEPROM_STATUS status;
+    uint32_t page_size = _EEPROM_AT24CXX_GEOMETRY(device)->page_size;
+    uint32_t chunk_len;
+
+    //THE I2C MULTIPLE WRITE TAKES AT MOST 255 BYTES, SO 256 BYTE
+    //PAGES (AT24CM01) ARE WRITTEN AS TWO HALVES
+    if(page_size > 128)
+    {
+        page_size = 128;
+    }
+
+    while(data_len > 0)
+    {
+        chunk_len = page_size - (b_address % page_size);
+        if(chunk_len > data_len)
+        {
+            chunk_len = data_len;
+        }
+
+        _eeprom_at24cxx_bus_acquire(device);
+        status = _eeprom_at24cxx_write_page_nowait(device, b_address, data, chunk_len);
+        _eeprom_at24cxx_bus_release(device);
+        if(status != EEPROM_STATUS_OK)
+        {
+            return;
+        }
+
+        b_address += chunk_len;
+        data += chunk_len;
+        data_len -= chunk_len;
+    }
+}
+
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_write_page_nowait(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len)
+{
+    //ISSUE A WRITE THAT LIES WITHIN ONE PAGE AND MARK THE DEVICE BUSY
+    //DOES NOT WAIT FOR THE WRITE CYCLE, SO CALLER CAN OVERLAP IT WITH
+    //WORK ON OTHER DEVICES. A FAILED WRITE MAY STILL HAVE STARTED ONE,
+    //SO THE DEVICE IS MARKED BUSY EITHER WAY
+    //CALLED WITH BUS LOCK HELD
+
+    EEPROM_STATUS status;
+    _EEPROM_AT24CXX_TRACE_TIMER(device, bus_t0);
+
+    status = _eeprom_at24cxx_bus_transfer(device, 1, b_address, data, (uint8_t)data_len);
+    device->write_busy = 1;
+    device->write_unacked = 1;
+    _EEPROM_AT24CXX_STATS_INC(device, bus_writes);
+    _EEPROM_AT24CXX_STATS_ADD(device, bus_bytes_written, data_len);
+    #if defined(EEPROM_AT24CXX_STATS)
+        if(b_address / _EEPROM_AT24CXX_GEOMETRY(device)->page_size < EEPROM_AT24CXX_STATS_MAX_PAGES)
+        {
+            device->stats.page_writes[b_address / _EEPROM_AT24CXX_GEOMETRY(device)->page_size]++;
+        }
+    #endif
+    _EEPROM_AT24CXX_TRACE(device, EEPROM_TRACE_BUS_WRITE, b_address, data_len, (status == EEPROM_STATUS_OK), bus_t0);
+    if(device->get_time_us != NULL)
+    {
+        device->write_start_us = (*device->get_time_us)();
+    }
+    return status;
+}
+
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_write_span_locked(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len)
+{
+    //WRITE A RANGE THAT MAY COVER SEVERAL DEVICE PAGES (A CACHE LINE ON
+    //PARTS WITH 8 / 16 BYTE PAGES) WITHOUT RELEASING THE BUS. EARLIER
+    //WRITE CYCLES ARE WAITED OUT IN PLACE, THE LAST ONE IS LEFT RUNNING
+    //STOPS AT THE FIRST PAGE THAT FAILS
+    //CALLED WITH BUS LOCK HELD
+
+    EEPROM_STATUS status = EEPROM_STATUS_OK;
+    uint32_t page_size = _EEPROM_AT24CXX_GEOMETRY(device)->page_size;
+    uint32_t chunk_len;
+
+    while(data_len > 0)
+    {
+        chunk_len = page_size - (b_address % page_size);
+        if(chunk_len > data_len)
+        {
+            chunk_len = data_len;
+        }
+        if(device->write_busy)
+        {
+            _eeprom_at24cxx_wait_write_cycle(device);
+            device->write_busy = 0;
+        }
+        status = _eeprom_at24cxx_write_page_nowait(device, b_address, data, chunk_len);
+        if(status != EEPROM_STATUS_OK)
+        {
+            break;
+        }
+        b_address += chunk_len;
+        data += chunk_len;
+        data_len -= chunk_len;
+    }
+    return status;
+}
+
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_bus_read(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len)
+{
+    //ISSUE ONE SEQUENTIAL READ OF UP TO 255 BYTES
+    //A READ CROSSING INTO THE NEXT ADDRESS BLOCK (HIGH ADDRESS BITS IN
+    //THE I2C ADDRESS) IS SPLIT SO EACH PART GOES TO THE RIGHT BLOCK
+    //ON A FAILED TRANSFER THE REST OF data READS AS ERASED (0xFF)
+    //CALLED WITH BUS LOCK HELD
+
+    const EEPROM_AT24CXX_GEOMETRY* geometry = _EEPROM_AT24CXX_GEOMETRY(device);
+    uint32_t block_size = ((uint32_t)1) << (8 * geometry->address_bytes);
+    EEPROM_STATUS status;
+    uint32_t chunk_len;
+
+    while(data_len > 0)
+    {
+        _EEPROM_AT24CXX_TRACE_TIMER(device, bus_t0);
+
+        chunk_len = data_len;
+        if(geometry->block_bits != 0 && chunk_len > block_size - (b_address % block_size))
+        {
+            chunk_len = block_size - (b_address % block_size);
+        }
+
+        status = _eeprom_at24cxx_bus_transfer(device, 0, b_address, data, (uint8_t)chunk_len);
+        _EEPROM_AT24CXX_STATS_INC(device, bus_reads);
+        _EEPROM_AT24CXX_STATS_ADD(device, bus_bytes_read, chunk_len);
+        _EEPROM_AT24CXX_TRACE(device, EEPROM_TRACE_BUS_READ, b_address, chunk_len, (status == EEPROM_STATUS_OK), bus_t0);
+        if(status != EEPROM_STATUS_OK)
+        {
+            MEMSET(data, 0xFF, data_len);
+            return status;
+        }
+
+        b_address += chunk_len;
+        data += chunk_len;
+        data_len -= chunk_len;
+    }
+    return EEPROM_STATUS_OK;
+}
+
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_bus_transfer(EEPROM_AT24CXX_DEVICE* device, uint8_t write, uint32_t b_address, uint8_t* data, uint8_t len)
+{
+    //RETRY ENGINE (NOTE 18) : RUN ONE I2C WRITE OR READ TILL IT SUCCEEDS
+    //AN ADDRESS NACK WHILE THE LAST WRITE IS UNCONFIRMED IS ITS WRITE
+    //CYCLE : WAITED OUT UP TO tWR, NOT A FAULT AND NOT A RETRY. ANY
+    //OTHER FAILURE IS RETRIED EEPROM_AT24CXX_RETRY_MAX TIMES WITH A
+    //DOUBLING BACKOFF AND STEPS THE BUS CLOCK DOWN. STILL FAILING, THE
+    //FAULT IS RECORDED AND ITS STATUS RETURNED
+    //CALLED WITH BUS LOCK HELD
+
+    const EEPROM_AT24CXX_GEOMETRY* geometry = _EEPROM_AT24CXX_GEOMETRY(device);
+    uint8_t i2c_address = _EEPROM_AT24CXX_BUS_I2C_ADDRESS(device, geometry, b_address);
+    uint32_t word_address = _EEPROM_AT24CXX_BUS_WORD_ADDRESS(geometry, b_address);
+    uint32_t backoff_us = EEPROM_AT24CXX_RETRY_BACKOFF_US;
+    uint32_t busy_us = 0;
+    uint8_t retries = 0;
+    EEPROM_STATUS status;
+
+    while(1)
+    {
+        _eeprom_at24cxx_clock_apply(device);
+        if(write)
+        {
+            if(len == 1)
+                status = (*device->i2c_writebyte)(i2c_address, word_address, geometry->address_bytes, *data);
+            else
+                status = (*device->i2c_writebyte_multiple)(i2c_address, word_address, geometry->address_bytes, data, len);
+        }
+        else
+        {
+            if(len == 1)
+                status = (*device->i2c_readbyte)(i2c_address, word_address, geometry->address_bytes, data);
+            else
+                status = (*device->i2c_readbyte_multiple)(i2c_address, word_address, geometry->address_bytes, data, len);
+        }
+
+        if(status == EEPROM_STATUS_OK)
+        {
+            device->write_unacked = 0;
+            _eeprom_at24cxx_clock_update(device, 1);
+            return status;
+        }
+
+        if(status == EEPROM_STATUS_NACK && device->write_unacked && busy_us < geometry->write_cycle_us)
+        {
+            _EEPROM_AT24CXX_STATS_INC(device, busy_nacks);
+            DELAY_US(EEPROM_AT24CXX_ACK_POLL_INTERVAL_US);
+            busy_us += EEPROM_AT24CXX_ACK_POLL_INTERVAL_US;
+            continue;
+        }
+
+        _eeprom_at24cxx_clock_update(device, 0);
+        if(write)
+        {
+            //A WRITE THAT FAILED PART WAY MAY HAVE STARTED A WRITE CYCLE
+            device->write_unacked = 1;
+            busy_us = 0;
+        }
+        if(retries == EEPROM_AT24CXX_RETRY_MAX)
+        {
+            break;
+        }
+        retries++;
+        _EEPROM_AT24CXX_STATS_INC(device, retries);
+        DELAY_US(backoff_us);
+        backoff_us *= 2;
+    }
+
+    _EEPROM_AT24CXX_STATS_INC(device, bus_faults);
+    _eeprom_at24cxx_fault(device, status);
+    _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : %s of %u bytes at address %u failed (status %u)\n", write ? "write" : "read", len, b_address, status);
+    return status;
+}
+
+static void PUTINFLASH _eeprom_at24cxx_clock_apply(EEPROM_AT24CXX_DEVICE* device)
+{
+    //SET THE BUS TO THIS DEVICE'S CLOCK IF THE LAST RATE SET THROUGH
+    //ITS CLOCK FUNCTION WAS ANOTHER ONE (DEVICES MAY SHARE A BUS)
+
+    if(device->i2c_set_clock == NULL ||
+        (_eeprom_at24cxx_clock_fn == device->i2c_set_clock && _eeprom_at24cxx_clock_hz == device->clock_hz))
+    {
+        return;
+    }
+    (*device->i2c_set_clock)(device->clock_hz);
+    _eeprom_at24cxx_clock_fn = device->i2c_set_clock;
+    _eeprom_at24cxx_clock_hz = device->clock_hz;
+}
+
+static void PUTINFLASH _eeprom_at24cxx_clock_update(EEPROM_AT24CXX_DEVICE* device, uint8_t ok)
+{
+    //ADAPT BUS CLOCK AFTER A TRANSFER (NOTE 18)
+    //FAULT AT A PROBED RATE : BACK TO THE LAST STABLE RATE AND WAIT
+    //TWICE AS LONG BEFORE THE NEXT PROBE. FAULT AT A STABLE RATE : 1/4
+    //SLOWER. clock_probe CLEAN TRANSFERS : RATE IS STABLE, TRY 1/8 FASTER
+
+    uint32_t hz;
+
+    if(device->i2c_set_clock == NULL)
+    {
+        return;
+    }
+
+    if(!ok)
+    {
+        hz = device->clock_hz;
+        if(device->clock_hz != device->clock_stable_hz)
+        {
+            device->clock_hz = device->clock_stable_hz;
+            if(device->clock_probe < 0x8000)
+            {
+                device->clock_probe *= 2;
+            }
+        }
+        else
+        {
+            device->clock_hz -= device->clock_hz / 4;
+            if(device->clock_hz < device->clock_min_hz)
+            {
+                device->clock_hz = device->clock_min_hz;
+            }
+            device->clock_stable_hz = device->clock_hz;
+        }
+        device->clock_clean = 0;
+        if(device->clock_hz != hz)
+        {
+            _EEPROM_AT24CXX_STATS_INC(device, clock_steps_down);
+            _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : bus clock down to %u Hz\n", device->clock_hz);
+        }
+        return;
+    }
+
+    if(++device->clock_clean < device->clock_probe)
+    {
+        return;
+    }
+    device->clock_clean = 0;
+    device->clock_stable_hz = device->clock_hz;
+    if(device->clock_hz < device->clock_max_hz)
+    {
+        hz = device->clock_hz + device->clock_hz / 8;
+        device->clock_hz = (hz > device->clock_max_hz) ? device->clock_max_hz : hz;
+        _EEPROM_AT24CXX_STATS_INC(device, clock_steps_up);
+        _EEPROM_AT24CXX_LOG_DEBUG("EEPROM : AT24CXX : bus clock probing %u Hz\n", device->clock_hz);
+    }
+}
+
+static void PUTINFLASH _eeprom_at24cxx_fault(EEPROM_AT24CXX_DEVICE* device, EEPROM_STATUS status)
+{
+    //RECORD A TRANSFER OR WRITE CYCLE THAT FAILED FOR GOOD
+
+    device->fault_status = status;
+    device->fault_count++;
+}
+
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_result(EEPROM_AT24CXX_DEVICE* device, uint32_t faults, EEPROM_STATUS status)
+{
+    //SET AND RETURN THE STATUS OF A CALL : status IF NOT OK, ELSE THE
+    //LAST FAULT RECORDED SINCE faults WAS TAKEN (_EEPROM_AT24CXX_FAULTS)
+
+    if(status == EEPROM_STATUS_OK && device->fault_count != faults)
+    {
+        status = device->fault_status;
+    }
+    device->status = status;
+    return status;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_bus_ackpoll(EEPROM_AT24CXX_DEVICE* device)
+{
+    //ADDRESS THE DEVICE ONCE
+    //RETURN 1 IF IT ACKS (NO WRITE CYCLE RUNNING)
+
+    uint8_t ack;
+
+    _eeprom_at24cxx_clock_apply(device);
+    ack = (*device->i2c_ackpoll)(device->i2c_address);
+    _EEPROM_AT24CXX_STATS_INC(device, ackpolls);
+    if(!ack)
+    {
+        _EEPROM_AT24CXX_STATS_INC(device, ackpoll_nacks);
+    }
+    else
+    {
+        device->write_unacked = 0;
+    }
+    return ack;
+}
+
+static void PUTINFLASH _eeprom_at24cxx_bus_acquire(EEPROM_AT24CXX_DEVICE* device)
+{
+    //TAKE DEVICE BUS LOCK AND WAIT OUT ANY WRITE CYCLE STILL RUNNING
+    //WRITES DO NOT WAIT FOR THEIR OWN WRITE CYCLE, SO THE CPU (OR
+    //OTHER DEVICES) CAN DO WORK WHILE THE EEPROM PROGRAMS THE PAGE
+
+    _EEPROM_AT24CXX_LOCK(device->bus_lock);
+    if(device->write_busy)
+    {
+        #if defined(EEPROM_AT24CXX_TRACE)
+            uint32_t wait_t0 = _eeprom_at24cxx_now(device);
+            uint8_t ok = _eeprom_at24cxx_wait_write_cycle(device);
+            _eeprom_at24cxx_trace(device, EEPROM_TRACE_WRITE_CYCLE, 0, 0, ok, wait_t0);
+        #else
+            uint8_t ok = _eeprom_at24cxx_wait_write_cycle(device);
+        #endif
+        if(!ok)
+        {
+            _eeprom_at24cxx_fault(device, EEPROM_STATUS_BUSY);
+        }
+        device->write_busy = 0;
+    }
+}
+
+static void PUTINFLASH _eeprom_at24cxx_bus_release(EEPROM_AT24CXX_DEVICE* device)
+{
+    //RELEASE DEVICE BUS LOCK
+    //(NOTHING TO DO WITHOUT THREAD SUPPORT)
+
+    (void)device;
+    _EEPROM_AT24CXX_UNLOCK(device->bus_lock);
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_wait_write_cycle(EEPROM_AT24CXX_DEVICE* device)
+{
+    //WAIT FOR EEPROM INTERNAL WRITE CYCLE (tWR) TO COMPLETE
+    //EEPROM DOES NOT ACK ITS ADDRESS WHILE WRITE CYCLE IS IN PROGRESS
+    //SO IF ACK POLL FUNCTION IS SET, POLL TILL DEVICE ACKS. ELSE
+    //FALL BACK TO THE WORST CASE tWR DELAY
+    //WITH A TIME SOURCE, TIME ALREADY SPENT SINCE THE WRITE (AND ON THE
+    //POLLS THEMSELVES) COUNTS TOWARDS THE WAIT
+    //ONCE THE DEVICE'S tWR IS LEARNT, SLEEP TILL JUST BEFORE IT ENDS.
+    //POLL INTERVAL THEN DOUBLES UP TO EEPROM_AT24CXX_ACK_POLL_MAX_US
+    //RETURN 0 ON TIMEOUT
+
+    uint32_t waited_us = 0;
+    uint32_t interval_us = EEPROM_AT24CXX_ACK_POLL_INTERVAL_US;
+    uint8_t measured = 0;
+
+    if(device->get_time_us != NULL)
+    {
+        waited_us = (*device->get_time_us)() - device->write_start_us;
+    }
+
+    if(device->i2c_ackpoll == NULL)
+    {
+        if(waited_us < _EEPROM_AT24CXX_GEOMETRY(device)->write_cycle_us)
+        {
+            DELAY_US(_EEPROM_AT24CXX_GEOMETRY(device)->write_cycle_us - waited_us);
+        }
+        return 1;
+    }
+
+    if(device->write_cycle_us > waited_us + EEPROM_AT24CXX_ACK_POLL_INTERVAL_US)
+    {
+        DELAY_US(device->write_cycle_us - EEPROM_AT24CXX_ACK_POLL_INTERVAL_US - waited_us);
+        waited_us = device->write_cycle_us - EEPROM_AT24CXX_ACK_POLL_INTERVAL_US;
+        measured = 1;
+    }
+
+    while(!_eeprom_at24cxx_bus_ackpoll(device))
+    {
+        if(waited_us >= _EEPROM_AT24CXX_GEOMETRY(device)->write_cycle_us)
+        {
+            _EEPROM_AT24CXX_STATS_INC(device, write_cycle_timeouts);
+            _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : write cycle ack poll timeout\n");
+            return 0;
+        }
+        DELAY_US(interval_us);
+        if(device->get_time_us != NULL)
+        {
+            waited_us = (*device->get_time_us)() - device->write_start_us;
+        }
+        else
+        {
+            waited_us += interval_us;
+        }
+        if(interval_us < EEPROM_AT24CXX_ACK_POLL_MAX_US)
+        {
+            interval_us *= 2;
+        }
+        measured = 1;
+    }
+
+    //LEARN tWR, ONLY FROM WAITS THAT SAW THE END OF THE WRITE CYCLE
+    //(A FIRST POLL THAT ACKS LONG AFTER THE WRITE SAYS NOTHING)
+    if(measured && waited_us <= _EEPROM_AT24CXX_GEOMETRY(device)->write_cycle_us)
+    {
+        if(device->write_cycle_us == 0)
+            device->write_cycle_us = waited_us;
+        else
+            device->write_cycle_us = (3 * device->write_cycle_us + waited_us) / 4;
+    }
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_write_cycle_done(EEPROM_AT24CXX_DEVICE* device)
+{
+    //NON BLOCKING CHECK FOR END OF EEPROM WRITE CYCLE
+    //ACK POLL IF AVAILABLE (GIVING UP AFTER WORST CASE tWR IF THERE IS
+    //A TIME SOURCE), ELSE COMPARE ELAPSED TIME WITH WORST CASE tWR. WITH
+    //NEITHER, FALL BACK TO THE BLOCKING WAIT
+    //CALLED WITH BUS LOCK HELD
+    //RETURN 1 IF DEVICE IS READY
+
+    uint32_t elapsed_us;
+    uint8_t timed_out = 0;
+
+    if(device->get_time_us != NULL)
+    {
+        elapsed_us = (*device->get_time_us)() - device->write_start_us;
+        timed_out = (elapsed_us >= _EEPROM_AT24CXX_GEOMETRY(device)->write_cycle_us);
+
+        //NO POINT POLLING BEFORE THE LEARNT tWR IS NEARLY OVER
+        if(elapsed_us + EEPROM_AT24CXX_ACK_POLL_INTERVAL_US < device->write_cycle_us)
+        {
+            return 0;
+        }
+    }
+
+    if(device->i2c_ackpoll != NULL)
+    {
+        if(_eeprom_at24cxx_bus_ackpoll(device))
+        {
+            return 1;
+        }
+        if(timed_out)
+        {
+            _EEPROM_AT24CXX_STATS_INC(device, write_cycle_timeouts);
+            _EEPROM_AT24CXX_TRACE(device, EEPROM_TRACE_WRITE_CYCLE, 0, 0, 0, device->write_start_us);
+            _eeprom_at24cxx_fault(device, EEPROM_STATUS_BUSY);
+            _EEPROM_AT24CXX_LOG_WARN("EEPROM : AT24CXX : write cycle ack poll timeout\n");
+        }
+        return timed_out;
+    }
+
+    if(device->get_time_us != NULL)
+    {
+        return timed_out;
+    }
+
+    _eeprom_at24cxx_wait_write_cycle(device);
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_iov_sort(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_IOVEC* vec, uint8_t count, uint8_t* order, uint8_t* used, uint32_t* total)
+{
+    //VALIDATE SEGMENTS AND SORT INDEXES OF NON EMPTY ONES BY ADDRESS
+    //(INSERTION SORT, BATCHES ARE SMALL). EQUAL ADDRESSES KEEP ARRAY
+    //ORDER
+    //RETURN 0 IF TOO MANY SEGMENTS OR ANY SEGMENT IS OUT OF RANGE
+
+    uint8_t i;
+    uint8_t j;
+
+    if(count > EEPROM_AT24CXX_IOV_MAX)
+    {
+        return 0;
+    }
+
+    *used = 0;
+    *total = 0;
+    for(i = 0; i < count; i++)
+    {
+        if(vec[i].data_len == 0)
+        {
+            continue;
+        }
+        if(vec[i].address + vec[i].data_len < vec[i].address ||
+            !_eeprom_at24cxx_validate_byte_address(device, vec[i].address + vec[i].data_len - 1))
+        {
+            return 0;
+        }
+
+        for(j = *used; j > 0 && vec[order[j - 1]].address > vec[i].address; j--)
+        {
+            order[j] = order[j - 1];
+        }
+        order[j] = i;
+        (*used)++;
+        *total += vec[i].data_len;
+    }
+    return 1;
+}
+
+static void PUTINFLASH _eeprom_at24cxx_iov_write_window(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_IOVEC* vec, uint8_t count, uint32_t window, uint32_t window_size)
+{
+    //BUILD ONE WINDOW (PART OF A PAGE) FROM ALL SEGMENTS TOUCHING IT AND
+    //WRITE THE SPAN FROM THE FIRST TO THE LAST TOUCHED BYTE IN ONE PAGE
+    //WRITE. IF THE SEGMENTS LEAVE HOLES IN THE SPAN IT IS READ FROM
+    //EEPROM FIRST, SO THE HOLES ARE WRITTEN BACK UNCHANGED. IF THAT
+    //READ FAILS THE WINDOW IS NOT WRITTEN (THE FAULT IS RECORDED)
+
+    uint8_t scratch[EEPROM_AT24CXX_IOV_SCRATCH];
+    uint32_t covered[EEPROM_AT24CXX_IOV_SCRATCH / 32];
+    uint32_t window_start = window * window_size;
+    uint32_t first = window_size;
+    uint32_t last = 0;
+    uint32_t from;
+    uint32_t to;
+    uint32_t n;
+    uint8_t holes = 0;
+    uint8_t pass;
+    uint8_t i;
+
+    MEMSET(covered, 0, sizeof(covered));
+
+    _eeprom_at24cxx_bus_acquire(device);
+
+    //PASS 0 : FIND SPAN AND COVERAGE, PASS 1 : COPY SEGMENT DATA IN
+    //ARRAY ORDER, SO THE LATER OF TWO OVERLAPPING SEGMENTS WINS
+    for(pass = 0; pass < 2; pass++)
+    {
+        for(i = 0; i < count; i++)
+        {
+            if(vec[i].data_len == 0 ||
+                vec[i].address >= window_start + window_size ||
+                vec[i].address + vec[i].data_len <= window_start)
+            {
+                continue;
+            }
+            from = (vec[i].address > window_start) ? vec[i].address - window_start : 0;
+            to = vec[i].address + vec[i].data_len - window_start;
+            if(to > window_size)
+            {
+                to = window_size;
+            }
+
+            if(pass == 1)
+            {
+                MEMCPY(&scratch[from], vec[i].data + (window_start + from - vec[i].address), to - from);
+                continue;
+            }
+            for(n = from; n < to; n++)
+            {
+                covered[n / 32] |= ((uint32_t)1 << (n % 32));
+            }
+            if(from < first)
+            {
+                first = from;
+            }
+            if(to - 1 > last)
+            {
+                last = to - 1;
+            }
+        }
+
+        if(pass == 0)
+        {
+            for(n = first; n <= last; n++)
+            {
+                if(!(covered[n / 32] & ((uint32_t)1 << (n % 32))))
+                {
+                    holes = 1;
+                    break;
+                }
+            }
+            if(holes && _eeprom_at24cxx_bus_read(device, window_start + first, &scratch[first], last - first + 1) != EEPROM_STATUS_OK)
+            {
+                _eeprom_at24cxx_bus_release(device);
+                return;
+            }
+        }
+    }
+
+    _eeprom_at24cxx_write_page_nowait(device, window_start + first, &scratch[first], last - first + 1);
+    _eeprom_at24cxx_bus_release(device);
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_image_read(EEPROM_AT24CXX_DEVICE* device, uint32_t address, uint32_t len, EEPROM_AT24CXX_IMAGE_IO sink, void* user_data, uint32_t* crc)
+{
+    //READ A RANGE CHUNK BY CHUNK STRAIGHT FROM EEPROM, FEEDING sink (IF
+    //SET) AND THE CRC32. THE BUS IS RELEASED AROUND sink SO IT MAY BE
+    //SLOW (FILE, UART) WITHOUT BLOCKING OTHER USERS OF THE DEVICE
+    //RETURN 0 IF sink ABORTS
+
+    uint8_t chunk[EEPROM_AT24CXX_IMAGE_CHUNK];
+    uint32_t offset;
+    uint32_t chunk_len;
+
+    *crc = 0;
+    for(offset = 0; offset < len; offset += chunk_len)
+    {
+        chunk_len = (len - offset > EEPROM_AT24CXX_IMAGE_CHUNK) ? EEPROM_AT24CXX_IMAGE_CHUNK : len - offset;
+
+        _eeprom_at24cxx_bus_acquire(device);
+        _eeprom_at24cxx_bus_read(device, address + offset, chunk, chunk_len);
+        _eeprom_at24cxx_bus_release(device);
+
+        *crc = EEPROM_AT24CXX_Crc32(*crc, chunk, chunk_len);
+        if(sink != NULL && !(*sink)(user_data, offset, chunk, chunk_len))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#if !defined(__ARM_FEATURE_CRC32) && (EEPROM_AT24CXX_CRC32_TABLES > 0)
+static void PUTINFLASH _eeprom_at24cxx_crc32_build(void)
+{
+    //FILL CRC32 LOOKUP TABLES (ONCE)
+
+    uint32_t crc;
+    uint16_t n;
+    uint8_t i;
+
+    for(n = 0; n < 256; n++)
+    {
+        crc = n;
+        for(i = 0; i < 8; i++)
+        {
+            crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
+        }
+        _eeprom_at24cxx_crc32_table[0][n] = crc;
+    }
+    for(i = 1; i < EEPROM_AT24CXX_CRC32_TABLES; i++)
+    {
+        for(n = 0; n < 256; n++)
+        {
+            crc = _eeprom_at24cxx_crc32_table[i - 1][n];
+            _eeprom_at24cxx_crc32_table[i][n] = (crc >> 8) ^ _eeprom_at24cxx_crc32_table[0][crc & 0xFF];
+        }
+    }
+    #if !defined(EEPROM_AT24CXX_THREAD_SAFE)
+        _eeprom_at24cxx_crc32_ready = 1;
+    #endif
+}
+#endif
+
+static void PUTINFLASH _eeprom_at24cxx_request_complete(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_REQUEST* request)
+{
+    //POP FINISHED REQUEST OFF THE HEAD OF THE QUEUE, WAKE WAITERS AND
+    //CALL ITS COMPLETION CALLBACK
+
+    _EEPROM_AT24CXX_LOCK(device->queue_lock);
+    device->queue_head = (device->queue_head + 1) % EEPROM_AT24CXX_QUEUE_DEPTH;
+    device->queue_count--;
+    request->done = 1;
+    _EEPROM_AT24CXX_COND_BROADCAST(device->queue_done);
+    _EEPROM_AT24CXX_UNLOCK(device->queue_lock);
+
+    if(request->callback != NULL)
+    {
+        (*request->callback)(request);
+    }
+}
+
+#if defined(EEPROM_AT24CXX_STATS) || defined(EEPROM_AT24CXX_TRACE)
+static uint32_t PUTINFLASH _eeprom_at24cxx_now(EEPROM_AT24CXX_DEVICE* device)
+{
+    //TIMESTAMP FOR OP LATENCY, 0 IF THERE IS NO TIME SOURCE
+
+    return (device->get_time_us != NULL) ? (*device->get_time_us)() : 0;
+}
+#endif
+
+#if defined(EEPROM_AT24CXX_STATS)
+static void PUTINFLASH _eeprom_at24cxx_stats_op(EEPROM_AT24CXX_DEVICE* device, EEPROM_STATS_OP op, uint32_t len, uint32_t t0)
+{
+    //COUNT A COMPLETED API CALL AND BIN ITS LATENCY (LOG2 MICROSECONDS)
+
+    uint32_t us;
+    uint8_t bucket = 0;
+
+    device->stats.op_count[op]++;
+    if(op >= EEPROM_STATS_OP_WRITE8)
+    {
+        device->stats.bytes_written += len;
+    }
+    else
+    {
+        device->stats.bytes_read += len;
+    }
+
+    if(device->get_time_us == NULL)
+    {
+        return;
+    }
+    us = (*device->get_time_us)() - t0;
+    while(us != 0 && bucket < EEPROM_AT24CXX_STATS_HIST_BUCKETS - 1)
+    {
+        us >>= 1;
+        bucket++;
+    }
+    device->stats.latency_hist[op][bucket]++;
+}
+#endif
+
+#if defined(EEPROM_AT24CXX_TRACE)
+static void PUTINFLASH _eeprom_at24cxx_trace(EEPROM_AT24CXX_DEVICE* device, uint8_t event, uint32_t address, uint32_t len, uint8_t result, uint32_t t0)
+{
+    //APPEND ONE EVENT TO THE DEVICE TRACE RING, OVERWRITING THE OLDEST
+    //t0 IS WHEN THE EVENT STARTED, IT ENDS NOW
+
+    EEPROM_AT24CXX_TRACE_ENTRY* entry;
+
+    entry = &device->trace[device->trace_count & (EEPROM_AT24CXX_TRACE_ENTRIES - 1)];
+    device->trace_count++;
+
+    entry->time_us = t0;
+    entry->duration_us = _eeprom_at24cxx_now(device) - t0;
+    entry->address = address;
+    entry->len = (len > 0xFFFF) ? 0xFFFF : (uint16_t)len;
+    entry->event = event;
+    entry->result = result;
+}
+#endif
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_array_map(EEPROM_AT24CXX_ARRAY* array, uint32_t address, uint32_t* b_address, uint32_t* chunk_len)
+{
+    //MAP ARRAY BYTE ADDRESS TO DEVICE INDEX AND DEVICE BYTE ADDRESS
+    //chunk_len IS SET TO NUMBER OF BYTES CONTIGUOUS ON THAT DEVICE
+
+    uint32_t stripe;
+    uint32_t size;
+    uint8_t i;
+
+    if(array->type == EEPROM_ARRAY_STRIPE)
+    {
+        stripe = address / EEPROM_AT24CXX_PAGE_SIZE;
+        *b_address = ((stripe / array->device_count) * EEPROM_AT24CXX_PAGE_SIZE) + (address % EEPROM_AT24CXX_PAGE_SIZE);
+        *chunk_len = EEPROM_AT24CXX_PAGE_SIZE - (address % EEPROM_AT24CXX_PAGE_SIZE);
+        return (uint8_t)(stripe % array->device_count);
+    }
+
+    for(i = 0; i < array->device_count - 1; i++)
+    {
+        size = _eeprom_at24cxx_get_size(array->device[i]);
+        if(address < size)
+        {
             break;
-        case EEPROM_MODEL_AT24C64:
-            if(b_address >= 0 && b_address <= 8191)
-                return 1;
-            else
-                return 0;
-          break;
+        }
+        address -= size;
+    }
+    *b_address = address;
+    *chunk_len = _eeprom_at24cxx_get_size(array->device[i]) - address;
+    return i;
+}
+
+#if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+static uint32_t PUTINFLASH _eeprom_at24cxx_cache_mask(uint32_t offset, uint32_t len)
+{
+    //RETURN BITMAP WITH BITS [offset, offset + len) SET
+
+    if(len >= 32)
+        return 0xFFFFFFFF;
+    return ((((uint32_t)1) << len) - 1) << offset;
+}
+
+static EEPROM_AT24CXX_CACHE_PAGE* PUTINFLASH _eeprom_at24cxx_cache_find(EEPROM_AT24CXX_DEVICE* device, uint32_t page)
+{
+    //RETURN CACHE ENTRY HOLDING SPECIFIED PAGE, NULL IF NOT CACHED
+
+    uint8_t i;
+
+    for(i = 0; i < EEPROM_AT24CXX_CACHE_PAGES; i++)
+    {
+        if(device->cache[i].used && device->cache[i].page == page)
+        {
+            device->cache[i].age = ++device->cache_clock;
+            return &device->cache[i];
+        }
+    }
+    return NULL;
+}
+
+static EEPROM_AT24CXX_CACHE_PAGE* PUTINFLASH _eeprom_at24cxx_cache_get(EEPROM_AT24CXX_DEVICE* device, uint32_t page)
+{
+    //RETURN CACHE ENTRY FOR SPECIFIED PAGE
+    //IF NOT CACHED, TAKE A FREE ENTRY OR EVICT THE LEAST RECENTLY USED
+    //ONE. A DIRTY VICTIM IS COMMITTED FIRST (CACHE LOCK IS DROPPED
+    //WHILE COMMITTING) AND THE LOOKUP IS DONE AGAIN
+    //CALLED WITH CACHE LOCK HELD
+
+    EEPROM_AT24CXX_CACHE_PAGE* entry;
+    uint8_t i;
+
+    while(1)
+    {
+        entry = _eeprom_at24cxx_cache_find(device, page);
+        if(entry != NULL)
+        {
+            return entry;
+        }
+
+        entry = NULL;
+        for(i = 0; i < EEPROM_AT24CXX_CACHE_PAGES; i++)
+        {
+            if(!device->cache[i].used)
+            {
+                entry = &device->cache[i];
+                break;
+            }
+            if(!device->cache[i].flushing && (entry == NULL || device->cache[i].age < entry->age))
+            {
+                entry = &device->cache[i];
+            }
+        }
+
+        if(entry == NULL)
+        {
+            //EVERY ENTRY IS BEING COMMITTED BY OTHER THREADS
+            //THEY HOLD THE BUS, SO WAIT FOR IT
+            _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+            _eeprom_at24cxx_bus_acquire(device);
+            _eeprom_at24cxx_bus_release(device);
+            _EEPROM_AT24CXX_LOCK(device->cache_lock);
+            continue;
+        }
+
+        if(entry->used && entry->dirty)
+        {
+            _eeprom_at24cxx_cache_flush_page(device, entry);
+            continue;
+        }
+
+        entry->used = 1;
+        entry->flushing = 0;
+        entry->page = page;
+        entry->valid = 0;
+        entry->dirty = 0;
+        entry->age = ++device->cache_clock;
+        return entry;
+    }
+}
+
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_cache_flush_page(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_CACHE_PAGE* entry)
+{
+    //COMMIT DIRTY BYTES OF CACHE ENTRY TO EEPROM IN A SINGLE PAGE WRITE
+    //CLEAN BYTES IN BETWEEN DIRTY ONES ARE RE-WRITTEN WITH THEIR
+    //CURRENT CONTENT, READ FROM EEPROM FIRST IF NOT ALREADY CACHED
+    //CALLED WITH CACHE LOCK HELD. THE DIRTY BYTES ARE SNAPSHOT AND THE
+    //LOCK IS DROPPED FOR THE BUS TRANSFER, SO READS HITTING THE CACHE
+    //ARE NOT HELD UP. THE ENTRY STAYS CACHED (AND CANNOT BE EVICTED)
+    //TILL THE WRITE IS ISSUED
+    //A PAGE THAT FAILS TO COMMIT IS DROPPED FROM THE CACHE (THE FAULT IS
+    //RECORDED), SO IT CANNOT BLOCK EVICTION OVER AND OVER
+
+    EEPROM_STATUS status;
+    uint32_t first;
+    uint32_t last;
+    uint32_t span;
+    uint32_t valid;
+    uint32_t b_address;
+    uint8_t page_data[EEPROM_AT24CXX_CACHE_LINE_SIZE];
+    uint8_t eeprom_data[EEPROM_AT24CXX_CACHE_LINE_SIZE];
+    uint32_t i;
+
+    if(!entry->used || entry->flushing || entry->dirty == 0)
+    {
+        return EEPROM_STATUS_OK;
+    }
+
+    first = 0;
+    while(!(entry->dirty & (((uint32_t)1) << first)))
+        first++;
+    last = EEPROM_AT24CXX_CACHE_LINE_SIZE - 1;
+    while(!(entry->dirty & (((uint32_t)1) << last)))
+        last--;
+    span = _eeprom_at24cxx_cache_mask(first, last - first + 1);
+
+    b_address = entry->page * EEPROM_AT24CXX_CACHE_LINE_SIZE;
+    valid = entry->valid;
+    MEMCPY(page_data, entry->data, EEPROM_AT24CXX_CACHE_LINE_SIZE);
+    entry->dirty = 0;
+    entry->flushing = 1;
+    _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+
+    _eeprom_at24cxx_bus_acquire(device);
+    status = EEPROM_STATUS_OK;
+    if((valid & span) != span)
+    {
+        //FILL HOLES WITH EEPROM CONTENT
+        status = _eeprom_at24cxx_bus_read(device, b_address, eeprom_data, EEPROM_AT24CXX_CACHE_LINE_SIZE);
+        for(i = 0; i < EEPROM_AT24CXX_CACHE_LINE_SIZE; i++)
+        {
+            if(!(valid & (((uint32_t)1) << i)))
+            {
+                page_data[i] = eeprom_data[i];
+            }
+        }
+    }
+    if(status == EEPROM_STATUS_OK)
+    {
+        status = _eeprom_at24cxx_write_span_locked(device, b_address + first, &page_data[first], last - first + 1);
+    }
+    _eeprom_at24cxx_bus_release(device);
+
+    _EEPROM_AT24CXX_LOCK(device->cache_lock);
+    entry->flushing = 0;
+    if(status != EEPROM_STATUS_OK)
+    {
+        entry->used = 0;
+    }
+    device->cache_generation++;
+    return status;
+}
+
+static void PUTINFLASH _eeprom_at24cxx_cache_write(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len)
+{
+    //MERGE WRITE INTO CACHED PAGES AND MARK THE BYTES DIRTY
+    //CALLED WITH CACHE LOCK HELD
+
+    EEPROM_AT24CXX_CACHE_PAGE* entry;
+    uint32_t offset;
+    uint32_t chunk_len;
+    uint32_t mask;
+
+    while(data_len > 0)
+    {
+        offset = b_address % EEPROM_AT24CXX_CACHE_LINE_SIZE;
+        chunk_len = EEPROM_AT24CXX_CACHE_LINE_SIZE - offset;
+        if(chunk_len > data_len)
+        {
+            chunk_len = data_len;
+        }
+
+        entry = _eeprom_at24cxx_cache_get(device, b_address / EEPROM_AT24CXX_CACHE_LINE_SIZE);
+        MEMCPY(&entry->data[offset], data, chunk_len);
+        mask = _eeprom_at24cxx_cache_mask(offset, chunk_len);
+        if(entry->dirty == 0)
+        {
+            entry->dirty_us = (device->get_time_us != NULL) ? (*device->get_time_us)() : 0;
+        }
+        entry->valid |= mask;
+        entry->dirty |= mask;
+
+        b_address += chunk_len;
+        data += chunk_len;
+        data_len -= chunk_len;
+    }
+}
+
+static void PUTINFLASH _eeprom_at24cxx_cache_overlay(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len)
+{
+    //COPY CACHED BYTES OVER DATA READ FROM EEPROM
+    //VALID CACHED BYTES ARE NEVER OLDER THAN EEPROM CONTENT
+    //CALLED WITH CACHE LOCK HELD
+
+    EEPROM_AT24CXX_CACHE_PAGE* entry;
+    uint32_t offset;
+    uint32_t chunk_len;
+    uint32_t i;
+
+    while(data_len > 0)
+    {
+        offset = b_address % EEPROM_AT24CXX_CACHE_LINE_SIZE;
+        chunk_len = EEPROM_AT24CXX_CACHE_LINE_SIZE - offset;
+        if(chunk_len > data_len)
+        {
+            chunk_len = data_len;
+        }
+
+        entry = _eeprom_at24cxx_cache_find(device, b_address / EEPROM_AT24CXX_CACHE_LINE_SIZE);
+        if(entry != NULL)
+        {
+            for(i = 0; i < chunk_len; i++)
+            {
+                if(entry->valid & (((uint32_t)1) << (offset + i)))
+                {
+                    data[i] = entry->data[offset + i];
+                }
+            }
+        }
+
+        b_address += chunk_len;
+        data += chunk_len;
+        data_len -= chunk_len;
+    }
+}
+
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_cache_fill(EEPROM_AT24CXX_DEVICE* device, uint32_t page, uint32_t page_count)
+{
+    //LOAD CONSECUTIVE PAGES INTO CACHE WITH ONE SEQUENTIAL READ
+    //(EEPROM AUTO INCREMENTS ADDRESS ACROSS PAGES ON READ)
+    //BYTES ALREADY HELD IN CACHE ARE NOT OVERWRITTEN
+    //CALLED WITH CACHE LOCK HELD. LOCK IS DROPPED FOR THE BUS READ AND
+    //THE DATA IS DISCARDED IF A COMMIT FINISHED IN THE MEANTIME, AS IT
+    //MAY THEN BE STALE. CALLER LOOKS THE PAGE UP AGAIN AFTERWARDS
+    //NOTHING IS CACHED IF THE READ FAILS
+
+    EEPROM_AT24CXX_CACHE_PAGE* entry;
+    EEPROM_STATUS status;
+    uint8_t page_data[EEPROM_AT24CXX_CACHE_PREFETCH_PAGES * EEPROM_AT24CXX_CACHE_LINE_SIZE];
+    uint32_t generation;
+    uint32_t i;
+    uint32_t j;
+
+    generation = device->cache_generation;
+    _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+
+    _eeprom_at24cxx_bus_acquire(device);
+    status = _eeprom_at24cxx_bus_read(device, page * EEPROM_AT24CXX_CACHE_LINE_SIZE, page_data, page_count * EEPROM_AT24CXX_CACHE_LINE_SIZE);
+    _eeprom_at24cxx_bus_release(device);
+
+    _EEPROM_AT24CXX_LOCK(device->cache_lock);
+    for(i = 0; i < page_count && status == EEPROM_STATUS_OK; i++)
+    {
+        entry = _eeprom_at24cxx_cache_get(device, page + i);
+        if(generation != device->cache_generation)
+        {
+            break;
+        }
+        for(j = 0; j < EEPROM_AT24CXX_CACHE_LINE_SIZE; j++)
+        {
+            if(!(entry->valid & (((uint32_t)1) << j)))
+            {
+                entry->data[j] = page_data[(i * EEPROM_AT24CXX_CACHE_LINE_SIZE) + j];
+            }
+        }
+        entry->valid = 0xFFFFFFFF;
+    }
+    return status;
+}
+
+static void PUTINFLASH _eeprom_at24cxx_cache_read(EEPROM_AT24CXX_DEVICE* device, uint32_t b_address, uint8_t* data, uint32_t data_len)
+{
+    //READ DATA THROUGH THE PAGE CACHE
+    //ON A MISS THE PAGE AND THE FOLLOWING ONES (UP TO THE PREFETCH
+    //DEPTH OR THE END OF THE READ, WHICHEVER IS LARGER) ARE LOADED
+    //IF THAT FAILS THE REST OF data READS AS ERASED (0xFF)
+    //CALLED WITH CACHE LOCK HELD
+
+    EEPROM_AT24CXX_CACHE_PAGE* entry;
+    uint32_t offset;
+    uint32_t chunk_len;
+    uint32_t page;
+    uint32_t page_count;
+    uint32_t mask;
+
+    while(data_len > 0)
+    {
+        offset = b_address % EEPROM_AT24CXX_CACHE_LINE_SIZE;
+        chunk_len = EEPROM_AT24CXX_CACHE_LINE_SIZE - offset;
+        if(chunk_len > data_len)
+        {
+            chunk_len = data_len;
+        }
+        page = b_address / EEPROM_AT24CXX_CACHE_LINE_SIZE;
+        mask = _eeprom_at24cxx_cache_mask(offset, chunk_len);
+
+        entry = _eeprom_at24cxx_cache_find(device, page);
+        if(entry == NULL || (entry->valid & mask) != mask)
+        {
+            _EEPROM_AT24CXX_STATS_INC(device, cache_misses);
+            page_count = (offset + data_len + EEPROM_AT24CXX_CACHE_LINE_SIZE - 1) / EEPROM_AT24CXX_CACHE_LINE_SIZE;
+            if(page_count < device->cache_prefetch)
+                page_count = device->cache_prefetch;
+            if(page_count > EEPROM_AT24CXX_CACHE_PREFETCH_PAGES)
+                page_count = EEPROM_AT24CXX_CACHE_PREFETCH_PAGES;
+            while(page_count > 1 && !_eeprom_at24cxx_validate_byte_address(device, ((page + page_count) * EEPROM_AT24CXX_CACHE_LINE_SIZE) - 1))
+                page_count--;
+
+            if(_eeprom_at24cxx_cache_fill(device, page, page_count) != EEPROM_STATUS_OK)
+            {
+                MEMSET(data, 0xFF, data_len);
+                return;
+            }
+            continue;
+        }
+        _EEPROM_AT24CXX_STATS_INC(device, cache_hits);
+        MEMCPY(data, &entry->data[offset], chunk_len);
+
+        b_address += chunk_len;
+        data += chunk_len;
+        data_len -= chunk_len;
+    }
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_cache_flush_one(EEPROM_AT24CXX_DEVICE* device)
+{
+    //COMMIT ONE DIRTY CACHED PAGE (USED BY Tick TO FLUSH A PAGE AT A TIME)
+    //RETURN 1 IF A PAGE WAS COMMITTED, 0 IF NOTHING WAS DIRTY
+
+    uint8_t i;
+
+    _EEPROM_AT24CXX_LOCK(device->cache_lock);
+    for(i = 0; i < EEPROM_AT24CXX_CACHE_PAGES; i++)
+    {
+        if(device->cache[i].used && device->cache[i].dirty && !device->cache[i].flushing)
+        {
+            _eeprom_at24cxx_cache_flush_page(device, &device->cache[i]);
+            _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+            return 1;
+        }
+    }
+    _EEPROM_AT24CXX_UNLOCK(device->cache_lock);
+    return 0;
+}
+
+static EEPROM_AT24CXX_CACHE_PAGE* PUTINFLASH _eeprom_at24cxx_cache_due(EEPROM_AT24CXX_DEVICE* device)
+{
+    //RETURN THE OLDEST DIRTY PAGE IF A WRITE BACK LIMIT SAYS IT MUST BE
+    //COMMITTED NOW (NOTE 17), ELSE NULL
+    //CALLED WITH CACHE LOCK HELD
+
+    EEPROM_AT24CXX_CACHE_PAGE* oldest = NULL;
+    uint32_t dirty_bytes = 0;
+    uint32_t now = 0;
+    uint32_t mask;
+    uint8_t i;
+
+    if(!device->power_fail && device->cache_max_age_us == 0 && device->cache_max_dirty == 0)
+    {
+        return NULL;
+    }
+    if(device->get_time_us != NULL)
+    {
+        now = (*device->get_time_us)();
+    }
+
+    for(i = 0; i < EEPROM_AT24CXX_CACHE_PAGES; i++)
+    {
+        if(!device->cache[i].used || device->cache[i].flushing || device->cache[i].dirty == 0)
+        {
+            continue;
+        }
+        for(mask = device->cache[i].dirty; mask != 0; mask &= mask - 1)
+        {
+            dirty_bytes++;
+        }
+        if(oldest == NULL || (now - device->cache[i].dirty_us) > (now - oldest->dirty_us))
+        {
+            oldest = &device->cache[i];
+        }
+    }
+
+    if(oldest == NULL)
+    {
+        return NULL;
+    }
+    if(device->power_fail ||
+        (device->cache_max_dirty != 0 && dirty_bytes > device->cache_max_dirty) ||
+        (device->cache_max_age_us != 0 && device->get_time_us != NULL && (now - oldest->dirty_us) >= device->cache_max_age_us))
+    {
+        return oldest;
     }
+    return NULL;
 }
+#endif
@@ -11,7 +11,8 @@
 *   (2) MUTIPLE DATA WRITE IS WRITTEN BIG ENDIAN ORDER (HIGHEST
 *       BITS WRITTEN FIRST IE AT THE LOWEST MEMORY LOCATION)
 *       EXCEPT THE WRITEBLOCK FUNCTION WHICH DATA IS WRITTEN
-*       AS IS
+*       AS IS. EEPROM_AT24CXX_REC.h WRITES WHOLE STRUCTS IN EITHER
+*       BYTE ORDER
 *
 *   (3) AT24CXX SERIES EEPROM HAS ADDRESS ROLLOVER FOR MULTIPLE
 *       BYTES READ / WRITE
@@ -21,13 +22,104 @@
 *       READ ROLLOVER  : THE ADDRESS ROLL OVERS FROM THE LAST BYTE
 *                         OF THE LAST PAGE TO THE FIRST BYTE OF
 *                         THE FIRST PAGE
+*       ALL MULTI BYTE WRITES ARE SPLIT INTO PAGE ALIGNED CHUNKS BY
+*       THE LIBRARY SO WRITE ROLLOVER NEVER CORRUPTS DATA
 *
 *   (4) ESP8266 SPECIFIC : HAD SOME ISSUES THE EEPROM I2C, FIRST I2C OPERATION
 *       WORKING BUT THE SECOND FAILED. TURNS OUT ITS SOMETHING TO DO WITH
 *       ESP8266 SOFT I2C IMPLEMENTATION IN i2c_master. HAD TO JACK
 *       UP THE SPEED TO ALMOST 500KHZ (BY DIVING THE delay PARAMETER
 *       BY 3 IN MY i2c_master_wait FUNCTION IN i2c_master FILE TO GET IT
-*       TO WORK PROPERLY)
+*       TO WORK PROPERLY). NO NEED TO HAND EDIT ANY MORE : SET AN I2C
+*       CLOCK FUNCTION THAT SETS THAT delay AND THE LIBRARY FINDS THE
+*       FASTEST STABLE RATE ITSELF (NOTE 18)
+*
+*   (5) LIBRARY DOES NOT USE THE HEAP. ALL SCRATCH BUFFERS ARE ON THE
+*       STACK OR STATIC. DEFINE EEPROM_AT24CXX_NO_HEAP TO DROP THE
+*       ZALLOC / FREE DEFINITIONS SO ANY HEAP USE FAILS TO BUILD
+*
+*   (6) DEFINE EEPROM_AT24CXX_THREAD_SAFE (LINUX / PTHREAD) TO MAKE ALL
+*       DEVICE FUNCTIONS SAFE TO CALL FROM MULTIPLE THREADS
+*
+*   (7) ASYNC API : ReadAsync / WriteAsync / FlushAsync QUEUE A REQUEST
+*       AND RETURN AT ONCE. Tick (CALLED FROM THE MAIN LOOP) DOES ONE
+*       BUS TRANSFER PER CALL AND NEVER WAITS FOR A WRITE CYCLE. SET A
+*       TIME FUNCTION OR ACK POLL FUNCTION, ELSE Tick HAS TO FALL BACK
+*       TO THE WORST CASE tWR DELAY
+*
+*   (8) ALSO BUILDS ON A LINUX / MAC HOST. EEPROM_AT24CXX_SIM PROVIDES A
+*       FILE BACKED SIMULATED EEPROM FOR THE I2C FUNCTIONS. DEFINE
+*       EEPROM_AT24CXX_SIM_TIME SO LIBRARY DELAYS RUN ON THE SIMULATED
+*       CLOCK. EEPROM_AT24CXX_LINUX DRIVES A REAL EEPROM ON /dev/i2c-N
+*
+*   (9) DEFINE EEPROM_AT24CXX_STATS TO KEEP PER DEVICE COUNTERS (OPS,
+*       BYTES, BUS TRANSFERS, ACK POLLS, CACHE HITS, LATENCY HISTOGRAM,
+*       WRITES PER PAGE). READ WITH GetStats, CLEAR WITH ResetStats.
+*       COUNTERS ARE NOT ATOMIC, SO WITH THREADS THEY ARE APPROXIMATE
+*
+*   (10) EEPROM_AT24CXX_LOG_LEVEL PICKS WHICH PRINTF MESSAGES ARE BUILT
+*        IN (NONE / ERROR / WARN / DEBUG). LEVELS ABOVE IT COMPILE OUT
+*        COMPLETELY. WARN AND DEBUG STILL NEED SetDebug(1) AT RUN TIME
+*
+*   (11) DEFINE EEPROM_AT24CXX_TRACE TO RECORD EVERY API CALL AND BUS
+*        TRANSFER (EVENT, ADDRESS, LENGTH, TIMESTAMP, DURATION, RESULT)
+*        IN A FIXED SIZE BINARY RING PER DEVICE. TraceDump SERIALIZES
+*        IT, tools/EEPROM_AT24CXX_TRACE_DECODE TURNS THE DUMP INTO A
+*        TIMELINE ON THE HOST
+*
+*   (12) WHOLE AT24C FAMILY (C01 ... CM01). SIZE, WRITE PAGE, ADDRESS
+*        WIDTH AND tWR COME FROM A CONST MODEL GEOMETRY TABLE. PARTS
+*        UP TO C16 SEND ONE ADDRESS BYTE AND CARRY THE HIGH ADDRESS
+*        BITS IN THE I2C ADDRESS (AS DOES THE CM01), SO THOSE PINS
+*        (A0 ...) ARE IGNORED. DEFINE EEPROM_AT24CXX_FIXED_MODEL TO ONE
+*        MODEL (E.G. EEPROM_MODEL_AT24C64) TO MAKE ALL GEOMETRY
+*        COMPILE TIME CONSTANTS
+*
+*   (13) VECTORED I/O : ReadV / WriteV TAKE AN ARRAY OF (ADDRESS, BUFFER,
+*        LENGTH) SEGMENTS AND WORK THROUGH THEM IN ADDRESS ORDER. READS
+*        SEPARATED BY SMALL GAPS BECOME ONE SEQUENTIAL READ, ALL BYTES
+*        FOR ONE PAGE GO OUT AS ONE PAGE WRITE (GAPS BETWEEN THEM ARE
+*        READ BACK AND REWRITTEN UNCHANGED). ON OVERLAP THE LATER
+*        SEGMENT IN THE ARRAY WINS
+*
+*   (14) IMAGE FUNCTIONS : Dump / Restore / Verify STREAM A RANGE (UP TO
+*        THE WHOLE CHIP) THROUGH A CALLER CALLBACK, SO THE IMAGE NEVER
+*        HAS TO FIT IN RAM. Restore READS EACH CHUNK BACK FIRST AND ONLY
+*        PROGRAMS PAGES THAT DIFFER, THEN CHECKS THE RESULT WITH A CRC32
+*        VERIFY PASS. Crc32 (ZLIB COMPATIBLE) IS EXPORTED FOR THE CALLER
+*        SIDE OF THE CHECK
+*
+*   (15) COMPARE BEFORE WRITE : WITH SetCompareWrite(1) (OR PER CALL WITH
+*        WriteBlockIfChanged) THE TARGET RANGE IS READ FIRST (THROUGH THE
+*        PAGE CACHE IF ON) AND ONLY THE CHANGED SPAN OF EACH PAGE IS
+*        WRITTEN. PAGES ALREADY HOLDING THE DATA COST NO WRITE CYCLE AND
+*        ARE COUNTED IN GetWritesElided. APPLIES TO Write8 / 16 / 32,
+*        WriteBlock AND ARRAY WRITES, NOT TO THE ASYNC QUEUE
+*
+*   (16) Crc32 IS TABLE DRIVEN (SLICING BY 8 ON HOST BUILDS, SEE
+*        EEPROM_AT24CXX_CRC32_TABLES) OR USES THE ARMv8 CRC32
+*        INSTRUCTIONS WHERE AVAILABLE. EEPROM_AT24CXX_CRC.h ADDS AN
+*        OPTIONAL PER PAGE CRC INTEGRITY LAYER ON TOP OF THE DEVICE API
+*
+*   (17) WRITE BACK THRESHOLDS : THE PAGE CACHE ABSORBS REPEATED WRITES
+*        TO THE SAME PAGES. SetWriteBack BOUNDS HOW LONG THEY STAY
+*        THERE : A PAGE IS COMMITTED ONCE IT HAS BEEN DIRTY FOR max_age
+*        OR WHEN MORE THAN max_dirty BYTES ARE DIRTY (OLDEST PAGE FIRST).
+*        CHECKED ON EVERY WRITE AND BY Tick (ONE PAGE PER CALL, NO
+*        WAITING), Flush IS THE EXPLICIT SYNC. PowerFail (SAFE FROM AN
+*        INTERRUPT, ONLY SETS A FLAG) MAKES Tick COMMIT EVERY DIRTY PAGE
+*        BEFORE ANY QUEUED REQUEST AND TURNS LATER WRITES WRITE THROUGH
+*
+*   (18) ERRORS : THE I2C FUNCTIONS RETURN AN EEPROM_STATUS, SO DO ALL
+*        CALLS THAT CAN FAIL (Read8 / 16 / 32 RETURN DATA, GetLastStatus
+*        GIVES THEIR STATUS). AN ADDRESS NACK RIGHT AFTER A WRITE IS THE
+*        WRITE CYCLE STILL RUNNING : IT IS WAITED OUT (UP TO tWR) AND IS
+*        NOT A FAULT. ANY OTHER FAILURE IS RETRIED UP TO
+*        EEPROM_AT24CXX_RETRY_MAX TIMES WITH EXPONENTIAL BACKOFF. WRITE
+*        CYCLE WAITS LEARN THE REAL tWR OF EACH DEVICE AND SLEEP THROUGH
+*        MOST OF IT, THEN POLL WITH A GROWING INTERVAL. WITH AN I2C CLOCK
+*        FUNCTION (SetI2CClockFunction) A FAULT STEPS THE DEVICE'S BUS
+*        CLOCK DOWN AND A RUN OF CLEAN TRANSFERS PROBES A FASTER ONE
 *
 * AUGUST 28 2017
 *
@@ -49,62 +141,642 @@
   #include "espconn.h"
   #include "os_type.h"
   #include "mem.h"
+  #include "user_interface.h"
 
   #define PRINTF      os_printf
   #define PUTINFLASH  ICACHE_FLASH_ATTR
-  #define ZALLOC      os_zalloc
-  #define FREE        os_free
+  #if !defined(EEPROM_AT24CXX_NO_HEAP)
+    #define ZALLOC    os_zalloc
+    #define FREE      os_free
+  #endif
+  #define DELAY_US    os_delay_us
+  #define MEMCPY      os_memcpy
+  #define MEMSET      os_memset
+  #define MEMCMP      os_memcmp
+#elif defined(__unix__) || defined(__APPLE__)
+  //HOST BUILD (SIMULATOR, BENCHMARKS)
+  #include <stdio.h>
+  #include <stdint.h>
+  #include <stdlib.h>
+  #include <string.h>
+  #include <unistd.h>
+
+  #define PRINTF      printf
+  #define PUTINFLASH
+  #if !defined(EEPROM_AT24CXX_NO_HEAP)
+    #define ZALLOC(x) calloc(1, (x))
+    #define FREE      free
+  #endif
+  #if defined(EEPROM_AT24CXX_SIM_TIME)
+    //DELAYS ADVANCE THE SIMULATOR CLOCK INSTEAD OF SLEEPING
+    void EEPROM_AT24CXX_SimDelayUs(uint32_t us);
+    #define DELAY_US  EEPROM_AT24CXX_SimDelayUs
+  #else
+    #define DELAY_US  usleep
+  #endif
+  #define MEMCPY      memcpy
+  #define MEMSET      memset
+  #define MEMCMP      memcmp
+#endif
+
+#if defined(EEPROM_AT24CXX_THREAD_SAFE)
+  #include <pthread.h>
+#endif
+
+//LOGGING
+//ERROR : ALWAYS PRINTED, WARN : INVALID ADDRESSES / TIMEOUTS,
+//DEBUG : CONFIGURATION AND EVERY READ / WRITE
+#define EEPROM_AT24CXX_LOG_LEVEL_NONE         0
+#define EEPROM_AT24CXX_LOG_LEVEL_ERROR        1
+#define EEPROM_AT24CXX_LOG_LEVEL_WARN         2
+#define EEPROM_AT24CXX_LOG_LEVEL_DEBUG        3
+#ifndef EEPROM_AT24CXX_LOG_LEVEL
+  #define EEPROM_AT24CXX_LOG_LEVEL            EEPROM_AT24CXX_LOG_LEVEL_DEBUG
+#endif
+#if (EEPROM_AT24CXX_LOG_LEVEL >= EEPROM_AT24CXX_LOG_LEVEL_ERROR)
+  #define EEPROM_AT24CXX_LOG_ERROR(...)       PRINTF(__VA_ARGS__)
+#else
+  #define EEPROM_AT24CXX_LOG_ERROR(...)
 #endif
 
 #define EEPROM_AT24CXX_I2C_ADDRESS            0x50
-#define EEPROM_GET_BYTE_ADDRESS_FROM_PAGE(x)  ((x) * 32)
+
+//LIBRARY PAGE : PAGE OF THE AT24C32 / AT24C64, ALSO THE UNIT OF CACHE
+//LINES, ARRAY STRIPES AND KV PAGES ON EVERY MODEL. ADDRESS_TYPE_PAGE
+//ADDRESSES ARE IN DEVICE PAGES (SEE DeviceGetPageSize)
+#define EEPROM_AT24CXX_PAGE_SIZE              32
+#define EEPROM_GET_BYTE_ADDRESS_FROM_PAGE(x)  ((x) * EEPROM_AT24CXX_PAGE_SIZE)
+#define EEPROM_AT24CXX_CACHE_LINE_SIZE        EEPROM_AT24CXX_PAGE_SIZE
+
+//MAXIMUM DEVICES IN A MULTI DEVICE ARRAY (8 = ALL A2 A1 A0 COMBINATIONS)
+#define EEPROM_AT24CXX_ARRAY_MAX_DEVICES      8
+
+//DEPTH OF PER DEVICE REQUEST QUEUE
+#ifndef EEPROM_AT24CXX_QUEUE_DEPTH
+  #define EEPROM_AT24CXX_QUEUE_DEPTH          8
+#endif
+
+//WRITE CYCLE (tWR) TIMING
+//WORST CASE tWR FROM DATASHEET (PER MODEL IN THE GEOMETRY TABLE, THIS
+//IS THE LARGEST). USED AS ACK POLL TIMEOUT, OR AS FIXED DELAY IF NO
+//ACK POLL FUNCTION IS SET
+//ACK POLL INTERVAL STARTS AT EEPROM_AT24CXX_ACK_POLL_INTERVAL_US AND
+//DOUBLES UP TO EEPROM_AT24CXX_ACK_POLL_MAX_US
+#define EEPROM_AT24CXX_WRITE_CYCLE_MAX_US     10000
+#define EEPROM_AT24CXX_ACK_POLL_INTERVAL_US   100
+#define EEPROM_AT24CXX_ACK_POLL_MAX_US        800
+
+//RETRY ENGINE (NOTE 18)
+//A FAULTED TRANSFER IS RETRIED UP TO EEPROM_AT24CXX_RETRY_MAX TIMES,
+//FIRST AFTER EEPROM_AT24CXX_RETRY_BACKOFF_US, DOUBLING EACH TIME
+#ifndef EEPROM_AT24CXX_RETRY_MAX
+  #define EEPROM_AT24CXX_RETRY_MAX            3
+#endif
+#ifndef EEPROM_AT24CXX_RETRY_BACKOFF_US
+  #define EEPROM_AT24CXX_RETRY_BACKOFF_US     50
+#endif
+
+//ADAPTIVE BUS CLOCK (NOTE 18)
+//A FAULT STEPS THE CLOCK DOWN BY 1/4. AFTER EEPROM_AT24CXX_CLOCK_PROBE
+//CLEAN TRANSFERS 1/8 FASTER IS TRIED. A FASTER RATE THAT FAULTS IS
+//DROPPED AND THE RUN NEEDED BEFORE THE NEXT TRY DOUBLES
+#ifndef EEPROM_AT24CXX_CLOCK_PROBE
+  #define EEPROM_AT24CXX_CLOCK_PROBE          64
+#endif
+
+//PAGE CACHE (WRITE BACK + READ THROUGH)
+//NUMBER OF PAGES MIRRORED IN RAM. SET TO 0 TO COMPILE CACHE OUT
+//MAXIMUM NUMBER OF PAGES PULLED IN BY ONE SEQUENTIAL READ ON A CACHE
+//MISS. MUST NOT EXCEED NUMBER OF CACHED PAGES (DEFAULT 2, OR ALL OF
+//A SMALLER CACHE)
+#ifndef EEPROM_AT24CXX_CACHE_PAGES
+  #define EEPROM_AT24CXX_CACHE_PAGES          4
+#endif
+#ifndef EEPROM_AT24CXX_CACHE_PREFETCH_PAGES
+  #if (EEPROM_AT24CXX_CACHE_PAGES < 2)
+    #define EEPROM_AT24CXX_CACHE_PREFETCH_PAGES EEPROM_AT24CXX_CACHE_PAGES
+  #else
+    #define EEPROM_AT24CXX_CACHE_PREFETCH_PAGES 2
+  #endif
+#endif
+#if (EEPROM_AT24CXX_CACHE_PREFETCH_PAGES > EEPROM_AT24CXX_CACHE_PAGES) || \
+    (EEPROM_AT24CXX_CACHE_PREFETCH_PAGES * EEPROM_AT24CXX_CACHE_LINE_SIZE > 255)
+  #error "EEPROM : AT24CXX : invalid cache prefetch size"
+#endif
+
+//VECTORED I/O
+//MAXIMUM SEGMENTS PER ReadV / WriteV CALL, LARGEST GAP (BYTES) READ
+//AND DROPPED TO JOIN TWO READS, SIZE OF THE STACK SCRATCH BUFFER FOR
+//JOINED READS AND PAGE WRITES (POWER OF 2, PAGES LARGER THAN IT ARE
+//WRITTEN IN SCRATCH SIZED PIECES)
+#ifndef EEPROM_AT24CXX_IOV_MAX
+  #define EEPROM_AT24CXX_IOV_MAX              16
+#endif
+#ifndef EEPROM_AT24CXX_IOV_GAP
+  #define EEPROM_AT24CXX_IOV_GAP              8
+#endif
+#ifndef EEPROM_AT24CXX_IOV_SCRATCH
+  #define EEPROM_AT24CXX_IOV_SCRATCH          64
+#endif
+#if (EEPROM_AT24CXX_IOV_SCRATCH & (EEPROM_AT24CXX_IOV_SCRATCH - 1)) || \
+    (EEPROM_AT24CXX_IOV_SCRATCH < 8) || (EEPROM_AT24CXX_IOV_SCRATCH > 128)
+  #error "EEPROM : AT24CXX : invalid vectored I/O scratch size"
+#endif
+
+//IMAGE FUNCTIONS
+//BYTES MOVED PER CALLBACK AND COMPARED PER STEP OF A RESTORE (STACK
+//BUFFERS, TWO OF THIS SIZE IN Restore). POWER OF 2, AT MOST 128
+#ifndef EEPROM_AT24CXX_IMAGE_CHUNK
+  #define EEPROM_AT24CXX_IMAGE_CHUNK          128
+#endif
+#if (EEPROM_AT24CXX_IMAGE_CHUNK & (EEPROM_AT24CXX_IMAGE_CHUNK - 1)) || \
+    (EEPROM_AT24CXX_IMAGE_CHUNK < 8) || (EEPROM_AT24CXX_IMAGE_CHUNK > 128)
+  #error "EEPROM : AT24CXX : invalid image chunk size"
+#endif
+
+//CRC32
+//LOOKUP TABLES USED BY Crc32 (BUILT IN RAM ON FIRST USE) : 0 = BIT AT A
+//TIME (NO TABLE), 1 = ONE BYTE TABLE (1KB), 8 = SLICING BY 8 (8KB).
+//IGNORED ON ARMv8 CORES WITH THE CRC EXTENSION (__ARM_FEATURE_CRC32),
+//WHICH USE THE crc32b / crc32w INSTRUCTIONS
+#ifndef EEPROM_AT24CXX_CRC32_TABLES
+  #if defined(ESP8266)
+    #define EEPROM_AT24CXX_CRC32_TABLES       0
+  #else
+    #define EEPROM_AT24CXX_CRC32_TABLES       8
+  #endif
+#endif
+#if (EEPROM_AT24CXX_CRC32_TABLES != 0) && (EEPROM_AT24CXX_CRC32_TABLES != 1) && \
+    (EEPROM_AT24CXX_CRC32_TABLES != 8)
+  #error "EEPROM : AT24CXX : CRC32 tables must be 0, 1 or 8"
+#endif
+
+//STATISTICS
+//LATENCY HISTOGRAM BUCKET n HOLDS OPS TAKING [2^(n-1), 2^n) MICROSECONDS
+//(BUCKET 0 : UNDER 1us, LAST BUCKET : EVERYTHING ABOVE). PER PAGE WRITE
+//COUNTERS COVER THE FIRST EEPROM_AT24CXX_STATS_MAX_PAGES PAGES
+#if defined(EEPROM_AT24CXX_STATS)
+  #define EEPROM_AT24CXX_STATS_HIST_BUCKETS   16
+  #ifndef EEPROM_AT24CXX_STATS_MAX_PAGES
+    #define EEPROM_AT24CXX_STATS_MAX_PAGES    256
+  #endif
+#endif
+
+//TRACE
+//RING HOLDS THE LAST EEPROM_AT24CXX_TRACE_ENTRIES EVENTS (POWER OF 2)
+//DUMP LAYOUT (LITTLE ENDIAN) :
+//  HEADER : [MAGIC "AT24" 4][VERSION 1][I2C ADDRESS 1][ENTRIES 2][TOTAL 4]
+//  ENTRY  : [TIME US 4][DURATION US 4][ADDRESS 4][LEN 2][EVENT 1][RESULT 1]
+//TOTAL IS EVERY EVENT RECORDED SINCE RESET, SO TOTAL - ENTRIES WERE LOST
+#if defined(EEPROM_AT24CXX_TRACE)
+  #ifndef EEPROM_AT24CXX_TRACE_ENTRIES
+    #define EEPROM_AT24CXX_TRACE_ENTRIES      64
+  #endif
+  #if (EEPROM_AT24CXX_TRACE_ENTRIES & (EEPROM_AT24CXX_TRACE_ENTRIES - 1))
+    #error "EEPROM : AT24CXX : trace entries must be a power of 2"
+  #endif
+#endif
+#define EEPROM_AT24CXX_TRACE_VERSION          1
+#define EEPROM_AT24CXX_TRACE_HEADER_SIZE      12
+#define EEPROM_AT24CXX_TRACE_ENTRY_SIZE       16
 
 //CUSTOM VARIABLE STRUCTURES/////////////////////////////
 typedef enum
 {
     EEPROM_MODEL_AT24C32 = 0,
     EEPROM_MODEL_AT24C64,
+    EEPROM_MODEL_AT24C01,
+    EEPROM_MODEL_AT24C02,
+    EEPROM_MODEL_AT24C04,
+    EEPROM_MODEL_AT24C08,
+    EEPROM_MODEL_AT24C16,
+    EEPROM_MODEL_AT24C128,
+    EEPROM_MODEL_AT24C256,
+    EEPROM_MODEL_AT24C512,
+    EEPROM_MODEL_AT24CM01,
     EEPROM_MODEL_MAX
 } EEPROM_MODEL_TYPE;
 
+typedef struct
+{
+    uint32_t size;            //BYTES
+    uint16_t page_size;       //WRITE PAGE (BYTES)
+    uint8_t address_bytes;    //WORD ADDRESS BYTES SENT ON THE BUS
+    uint8_t block_bits;       //HIGH ADDRESS BITS CARRIED IN THE I2C ADDRESS
+    uint16_t write_cycle_us;  //WORST CASE tWR
+} EEPROM_AT24CXX_GEOMETRY;
+
 typedef enum
 {
     ADDRESS_TYPE_BYTE = 0,
     ADDRESS_TYPE_PAGE,
     ADDRESS_TYPE_MAX
 } EEPROM_ADDRESS_TYPE;
+
+typedef enum
+{
+    EEPROM_REQUEST_READ = 0,
+    EEPROM_REQUEST_WRITE,
+    EEPROM_REQUEST_FLUSH,
+    EEPROM_REQUEST_MAX
+} EEPROM_REQUEST_TYPE;
+
+typedef enum
+{
+    EEPROM_STATUS_OK = 0,
+    EEPROM_STATUS_INVALID,    //BAD ADDRESS, LENGTH OR ARGUMENT
+    EEPROM_STATUS_NACK,       //DEVICE DID NOT ACK ITS ADDRESS
+    EEPROM_STATUS_BUSY,       //WRITE CYCLE DID NOT END WITHIN tWR
+    EEPROM_STATUS_BUS_ERROR,  //ANY OTHER TRANSFER FAILURE (DATA NACK,
+                              //ARBITRATION LOST, STUCK BUS, TIMEOUT)
+    EEPROM_STATUS_MAX
+} EEPROM_STATUS;
+
+typedef struct _EEPROM_AT24CXX_REQUEST
+{
+    EEPROM_REQUEST_TYPE type;
+    uint32_t address;     //BYTE ADDRESS
+    uint8_t* data;
+    uint32_t data_len;
+    void (*callback)(struct _EEPROM_AT24CXX_REQUEST* request);
+    void* user_data;
+    uint32_t progress;    //BYTES DONE SO FAR
+    EEPROM_STATUS status; //RESULT, VALID ONCE done IS SET
+    volatile uint8_t done;
+} EEPROM_AT24CXX_REQUEST;
+
+typedef struct
+{
+    uint32_t address;     //BYTE ADDRESS
+    uint8_t* data;
+    uint32_t data_len;
+} EEPROM_AT24CXX_IOVEC;
+
+//IMAGE STREAM CALLBACK : MOVE len BYTES AT offset (FROM START OF THE
+//RANGE) TO / FROM data. RETURN 0 TO ABORT
+typedef uint8_t (*EEPROM_AT24CXX_IMAGE_IO)(void* user_data, uint32_t offset, uint8_t* data, uint32_t len);
+
+typedef enum
+{
+    EEPROM_TICK_IDLE = 0, //NOTHING QUEUED
+    EEPROM_TICK_BUSY,     //WRITE CYCLE STILL RUNNING, TRY AGAIN LATER
+    EEPROM_TICK_PROGRESS, //ONE TRANSFER DONE, REQUEST NOT FINISHED
+    EEPROM_TICK_DONE,     //REQUEST AT HEAD OF QUEUE FINISHED
+    EEPROM_TICK_MAX
+} EEPROM_TICK_STATE;
+
+typedef enum
+{
+    EEPROM_STATS_OP_READ8 = 0,
+    EEPROM_STATS_OP_READ16,
+    EEPROM_STATS_OP_READ32,
+    EEPROM_STATS_OP_READ_BLOCK,
+    EEPROM_STATS_OP_WRITE8,
+    EEPROM_STATS_OP_WRITE16,
+    EEPROM_STATS_OP_WRITE32,
+    EEPROM_STATS_OP_WRITE_BLOCK,
+    EEPROM_STATS_OP_FLUSH,
+    EEPROM_STATS_OP_MAX
+} EEPROM_STATS_OP;
+
+typedef enum
+{
+    //API CALLS ARE TRACED WITH THEIR EEPROM_STATS_OP VALUE
+    EEPROM_TRACE_BUS_READ = EEPROM_STATS_OP_MAX,
+    EEPROM_TRACE_BUS_WRITE,       //PAGE WRITE, STARTS A WRITE CYCLE
+    EEPROM_TRACE_WRITE_CYCLE,     //STALL ON A RUNNING WRITE CYCLE
+    EEPROM_TRACE_MAX
+} EEPROM_TRACE_EVENT;
+
+typedef struct
+{
+    uint32_t time_us;
+    uint32_t duration_us;
+    uint32_t address;
+    uint16_t len;
+    uint8_t event;
+    uint8_t result;     //1 OK, 0 INVALID ADDRESS / TIMEOUT
+} EEPROM_AT24CXX_TRACE_ENTRY;
+
+#if defined(EEPROM_AT24CXX_STATS)
+typedef struct
+{
+    //API CALLS
+    uint32_t op_count[EEPROM_STATS_OP_MAX];
+    uint32_t op_errors;           //REJECTED (INVALID ADDRESS / TYPE)
+    uint32_t bytes_read;
+    uint32_t bytes_written;
+
+    //BUS
+    uint32_t bus_reads;           //READ TRANSFERS
+    uint32_t bus_writes;          //WRITE TRANSFERS (= WRITE CYCLES)
+    uint32_t bus_bytes_read;
+    uint32_t bus_bytes_written;
+    uint32_t ackpolls;
+    uint32_t ackpoll_nacks;       //POLLS WHILE DEVICE WAS BUSY
+    uint32_t write_cycle_timeouts;
+    uint32_t busy_nacks;          //TRANSFERS NACKED BY A WRITE CYCLE
+    uint32_t retries;             //TRANSFERS REPEATED AFTER A FAULT
+    uint32_t bus_faults;          //TRANSFERS STILL FAILING AFTER RETRIES
+    uint32_t clock_steps_down;
+    uint32_t clock_steps_up;
+
+    //PAGE CACHE
+    uint32_t cache_hits;
+    uint32_t cache_misses;
+
+    //LATENCY PER OP (NEEDS A TIME FUNCTION)
+    uint32_t latency_hist[EEPROM_STATS_OP_MAX][EEPROM_AT24CXX_STATS_HIST_BUCKETS];
+
+    //WEAR
+    uint32_t page_writes[EEPROM_AT24CXX_STATS_MAX_PAGES];
+} EEPROM_AT24CXX_STATISTICS;
+#endif
+
+typedef struct
+{
+    uint8_t used;
+    uint8_t flushing; //BEING COMMITTED, MUST NOT BE EVICTED
+    uint32_t page;
+    uint32_t valid;   //BITMAP OF BYTES HOLDING CURRENT CONTENT
+    uint32_t dirty;   //BITMAP OF BYTES NOT YET COMMITTED TO EEPROM
+    uint32_t age;     //LRU STAMP
+    uint32_t dirty_us;  //WHEN THE PAGE WENT FROM CLEAN TO DIRTY
+    uint8_t data[EEPROM_AT24CXX_CACHE_LINE_SIZE];
+} EEPROM_AT24CXX_CACHE_PAGE;
+
+typedef struct
+{
+    //EEPROM RELATED
+    uint8_t model;
+    uint8_t i2c_address;
+
+    //I2C FUNCTION POINTERS
+    void (*i2c_init)(void);
+    EEPROM_STATUS (*i2c_writebyte)(uint8_t, uint32_t, uint8_t, uint8_t);
+    EEPROM_STATUS (*i2c_writebyte_multiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t);
+    EEPROM_STATUS (*i2c_readbyte)(uint8_t, uint32_t, uint8_t, uint8_t*);
+    EEPROM_STATUS (*i2c_readbyte_multiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t);
+    uint8_t (*i2c_ackpoll)(uint8_t);
+    void (*i2c_set_clock)(uint32_t);
+
+    //TIME SOURCE (MICROSECONDS, FREE RUNNING)
+    uint32_t (*get_time_us)(void);
+
+    //BUS STATE
+    uint8_t write_busy;       //WRITE CYCLE MAY STILL BE RUNNING
+    uint8_t write_unacked;    //NO ACK SEEN SINCE THE LAST WRITE
+    uint32_t write_start_us;  //WHEN LAST WRITE CYCLE STARTED
+    uint32_t write_cycle_us;  //LEARNT tWR (0 = NOT YET KNOWN)
+
+    //ERRORS
+    EEPROM_STATUS status;       //RESULT OF THE LAST CALL
+    EEPROM_STATUS fault_status; //LAST TRANSFER THAT FAILED FOR GOOD
+    uint32_t fault_count;
+
+    //ADAPTIVE BUS CLOCK
+    uint32_t clock_hz;
+    uint32_t clock_stable_hz; //LAST RATE WITHOUT FAULTS
+    uint32_t clock_min_hz;
+    uint32_t clock_max_hz;
+    uint16_t clock_clean;     //CLEAN TRANSFERS AT clock_hz
+    uint16_t clock_probe;     //CLEAN TRANSFERS BEFORE TRYING FASTER
+
+    //COMPARE BEFORE WRITE
+    uint8_t compare_write;
+    uint32_t writes_elided;   //PAGE WRITES SKIPPED, DATA ALREADY STORED
+
+    //REQUEST QUEUE
+    EEPROM_AT24CXX_REQUEST* queue[EEPROM_AT24CXX_QUEUE_DEPTH];
+    uint8_t queue_head;
+    uint8_t queue_count;
+
+    //LOCKS
+    #if defined(EEPROM_AT24CXX_THREAD_SAFE)
+        pthread_mutex_t bus_lock;
+        pthread_mutex_t cache_lock;
+        pthread_mutex_t queue_lock;
+        pthread_cond_t queue_done;
+    #endif
+
+    //PAGE CACHE
+    #if (EEPROM_AT24CXX_CACHE_PAGES > 0)
+        uint8_t cache_on;
+        uint8_t cache_prefetch;
+        uint32_t cache_clock;
+        uint32_t cache_generation;    //BUMPED WHEN EEPROM CONTENT CHANGES
+        uint32_t cache_max_age_us;    //WRITE BACK LIMITS (0 = NONE)
+        uint16_t cache_max_dirty;
+        volatile uint8_t power_fail;  //COMMIT EVERYTHING, WRITE THROUGH
+        EEPROM_AT24CXX_CACHE_PAGE cache[EEPROM_AT24CXX_CACHE_PAGES];
+    #endif
+
+    //STATISTICS
+    #if defined(EEPROM_AT24CXX_STATS)
+        EEPROM_AT24CXX_STATISTICS stats;
+    #endif
+
+    //TRACE RING
+    #if defined(EEPROM_AT24CXX_TRACE)
+        EEPROM_AT24CXX_TRACE_ENTRY trace[EEPROM_AT24CXX_TRACE_ENTRIES];
+        uint32_t trace_count;     //EVENTS RECORDED SINCE RESET
+    #endif
+} EEPROM_AT24CXX_DEVICE;
+
+typedef enum
+{
+    EEPROM_ARRAY_CONCAT = 0,
+    EEPROM_ARRAY_STRIPE,
+    EEPROM_ARRAY_MAX
+} EEPROM_ARRAY_TYPE;
+
+typedef struct
+{
+    EEPROM_ARRAY_TYPE type;
+    uint8_t device_count;
+    uint32_t size;
+    EEPROM_AT24CXX_DEVICE* device[EEPROM_AT24CXX_ARRAY_MAX_DEVICES];
+} EEPROM_AT24CXX_ARRAY;
 //END CUSTOM VARIABLE STRUCTURES/////////////////////////
 
 //FUNCTION PROTOTYPES/////////////////////////////////////
 //CONFIGURATION FUNCTIONS
 void PUTINFLASH EEPROM_AT24CXX_SetDebug(uint8_t debug_on);
 void PUTINFLASH EEPROM_AT24CXX_SetI2CFunctions(void (*i2c_init)(void),
-                                                void (*i2c_writebyte)(uint8_t, uint32_t, uint8_t, uint8_t),
-                                                void (*i2c_writebytemultiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t),
-                                                uint8_t (*i2c_readbyte)(uint8_t, uint32_t, uint8_t),
-                                                void (*i2c_readbytemultiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t));
+                                                EEPROM_STATUS (*i2c_writebyte)(uint8_t, uint32_t, uint8_t, uint8_t),
+                                                EEPROM_STATUS (*i2c_writebytemultiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t),
+                                                EEPROM_STATUS (*i2c_readbyte)(uint8_t, uint32_t, uint8_t, uint8_t*),
+                                                EEPROM_STATUS (*i2c_readbytemultiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t));
+void PUTINFLASH EEPROM_AT24CXX_SetI2CAckPollFunction(uint8_t (*i2c_ackpoll)(uint8_t));
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SetI2CClockFunction(void (*i2c_set_clock)(uint32_t), uint32_t min_hz, uint32_t max_hz);
+void PUTINFLASH EEPROM_AT24CXX_SetTimeFunction(uint32_t (*get_time_us)(void));
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SetCache(uint8_t cache_on);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SetCachePrefetch(uint8_t pages);
+void PUTINFLASH EEPROM_AT24CXX_SetCompareWrite(uint8_t compare_on);
+void PUTINFLASH EEPROM_AT24CXX_SetWriteBack(uint32_t max_age_ms, uint16_t max_dirty);
+void PUTINFLASH EEPROM_AT24CXX_PowerFail(void);
 
 
 //GET PARAMETER FUNCTIONS
 uint8_t PUTINFLASH EEPROM_AT24CXX_GetI2CAddress(void);
+uint32_t PUTINFLASH EEPROM_AT24CXX_GetSize(void);
+uint16_t PUTINFLASH EEPROM_AT24CXX_GetPageSize(void);
+uint32_t PUTINFLASH EEPROM_AT24CXX_GetWritesElided(void);
+uint32_t PUTINFLASH EEPROM_AT24CXX_GetClock(void);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_GetLastStatus(void);
+const EEPROM_AT24CXX_GEOMETRY* PUTINFLASH EEPROM_AT24CXX_GetModelGeometry(EEPROM_MODEL_TYPE model);
+#if defined(EEPROM_AT24CXX_STATS)
+void PUTINFLASH EEPROM_AT24CXX_GetStats(EEPROM_AT24CXX_STATISTICS* stats);
+void PUTINFLASH EEPROM_AT24CXX_ResetStats(void);
+#endif
+#if defined(EEPROM_AT24CXX_TRACE)
+uint32_t PUTINFLASH EEPROM_AT24CXX_TraceDump(uint8_t* buffer, uint32_t buffer_len);
+void PUTINFLASH EEPROM_AT24CXX_TraceReset(void);
+#endif
 
 //CONTROL FUNCTIONS
-void PUTINFLASH EEPROM_AT24CXX_Initialize(EEPROM_MODEL_TYPE model, uint8_t a2, uint8_t a1, uint8_t a0);
-void PUTINFLASH EEPROM_AT24CXX_Write8(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t data);
-void PUTINFLASH EEPROM_AT24CXX_Write16(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint16_t data);
-void PUTINFLASH EEPROM_AT24CXX_Write32(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint32_t data);
-void PUTINFLASH EEPROM_AT24CXX_WriteBlock(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint8_t data_len);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_Initialize(EEPROM_MODEL_TYPE model, uint8_t a2, uint8_t a1, uint8_t a0);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_Write8(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t data);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_Write16(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint16_t data);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_Write32(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint32_t data);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_WriteBlock(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_WriteBlockIfChanged(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_Flush(void);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_InvalidateCache(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint32_t data_len);
 
 uint8_t PUTINFLASH EEPROM_AT24CXX_Read8(uint32_t address, EEPROM_ADDRESS_TYPE address_type);
 uint16_t PUTINFLASH EEPROM_AT24CXX_Read16(uint32_t address, EEPROM_ADDRESS_TYPE address_type);
 uint32_t PUTINFLASH EEPROM_AT24CXX_Read32(uint32_t address, EEPROM_ADDRESS_TYPE address_type);
-void PUTINFLASH EEPROM_AT24CXX_ReadBlock(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint8_t data_len);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_ReadBlock(uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len);
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_ReadV(EEPROM_AT24CXX_IOVEC* vec, uint8_t count);
+uint8_t PUTINFLASH EEPROM_AT24CXX_WriteV(EEPROM_AT24CXX_IOVEC* vec, uint8_t count);
+
+//IMAGE FUNCTIONS
+uint32_t PUTINFLASH EEPROM_AT24CXX_Crc32(uint32_t crc, const uint8_t* data, uint32_t len);
+uint8_t PUTINFLASH EEPROM_AT24CXX_Dump(uint32_t address, uint32_t len, EEPROM_AT24CXX_IMAGE_IO sink, void* user_data, uint32_t* crc);
+uint8_t PUTINFLASH EEPROM_AT24CXX_Restore(uint32_t address, uint32_t len, EEPROM_AT24CXX_IMAGE_IO source, void* user_data, uint32_t* pages_written);
+uint8_t PUTINFLASH EEPROM_AT24CXX_Verify(uint32_t address, uint32_t len, uint32_t crc);
+
+//ASYNC FUNCTIONS
+uint8_t PUTINFLASH EEPROM_AT24CXX_ReadAsync(EEPROM_AT24CXX_REQUEST* request,
+                                            uint32_t address,
+                                            EEPROM_ADDRESS_TYPE address_type,
+                                            uint8_t* data,
+                                            uint32_t data_len,
+                                            void (*callback)(EEPROM_AT24CXX_REQUEST*),
+                                            void* user_data);
+uint8_t PUTINFLASH EEPROM_AT24CXX_WriteAsync(EEPROM_AT24CXX_REQUEST* request,
+                                            uint32_t address,
+                                            EEPROM_ADDRESS_TYPE address_type,
+                                            uint8_t* data,
+                                            uint32_t data_len,
+                                            void (*callback)(EEPROM_AT24CXX_REQUEST*),
+                                            void* user_data);
+uint8_t PUTINFLASH EEPROM_AT24CXX_FlushAsync(EEPROM_AT24CXX_REQUEST* request,
+                                            void (*callback)(EEPROM_AT24CXX_REQUEST*),
+                                            void* user_data);
+EEPROM_TICK_STATE PUTINFLASH EEPROM_AT24CXX_Tick(void);
+
+//DEVICE HANDLE FUNCTIONS
+//SAME AS ABOVE BUT OPERATE ON A CALLER OWNED DEVICE, SO MULTIPLE
+//EEPROMS (ON ONE OR MORE I2C BUSES) CAN BE DRIVEN AT ONCE
+void PUTINFLASH EEPROM_AT24CXX_DeviceSetI2CFunctions(EEPROM_AT24CXX_DEVICE* device,
+                                                    void (*i2c_init)(void),
+                                                    EEPROM_STATUS (*i2c_writebyte)(uint8_t, uint32_t, uint8_t, uint8_t),
+                                                    EEPROM_STATUS (*i2c_writebytemultiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t),
+                                                    EEPROM_STATUS (*i2c_readbyte)(uint8_t, uint32_t, uint8_t, uint8_t*),
+                                                    EEPROM_STATUS (*i2c_readbytemultiple)(uint8_t, uint32_t, uint8_t, uint8_t*, uint8_t));
+void PUTINFLASH EEPROM_AT24CXX_DeviceSetI2CAckPollFunction(EEPROM_AT24CXX_DEVICE* device, uint8_t (*i2c_ackpoll)(uint8_t));
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceSetI2CClockFunction(EEPROM_AT24CXX_DEVICE* device, void (*i2c_set_clock)(uint32_t), uint32_t min_hz, uint32_t max_hz);
+void PUTINFLASH EEPROM_AT24CXX_DeviceSetTimeFunction(EEPROM_AT24CXX_DEVICE* device, uint32_t (*get_time_us)(void));
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceSetCache(EEPROM_AT24CXX_DEVICE* device, uint8_t cache_on);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceSetCachePrefetch(EEPROM_AT24CXX_DEVICE* device, uint8_t pages);
+void PUTINFLASH EEPROM_AT24CXX_DeviceSetCompareWrite(EEPROM_AT24CXX_DEVICE* device, uint8_t compare_on);
+void PUTINFLASH EEPROM_AT24CXX_DeviceSetWriteBack(EEPROM_AT24CXX_DEVICE* device, uint32_t max_age_ms, uint16_t max_dirty);
+void PUTINFLASH EEPROM_AT24CXX_DevicePowerFail(EEPROM_AT24CXX_DEVICE* device);
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceGetI2CAddress(EEPROM_AT24CXX_DEVICE* device);
+uint32_t PUTINFLASH EEPROM_AT24CXX_DeviceGetSize(EEPROM_AT24CXX_DEVICE* device);
+uint16_t PUTINFLASH EEPROM_AT24CXX_DeviceGetPageSize(EEPROM_AT24CXX_DEVICE* device);
+uint32_t PUTINFLASH EEPROM_AT24CXX_DeviceGetWritesElided(EEPROM_AT24CXX_DEVICE* device);
+uint32_t PUTINFLASH EEPROM_AT24CXX_DeviceGetClock(EEPROM_AT24CXX_DEVICE* device);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceGetLastStatus(EEPROM_AT24CXX_DEVICE* device);
+#if defined(EEPROM_AT24CXX_STATS)
+void PUTINFLASH EEPROM_AT24CXX_DeviceGetStats(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_STATISTICS* stats);
+void PUTINFLASH EEPROM_AT24CXX_DeviceResetStats(EEPROM_AT24CXX_DEVICE* device);
+#endif
+#if defined(EEPROM_AT24CXX_TRACE)
+uint32_t PUTINFLASH EEPROM_AT24CXX_DeviceTraceDump(EEPROM_AT24CXX_DEVICE* device, uint8_t* buffer, uint32_t buffer_len);
+void PUTINFLASH EEPROM_AT24CXX_DeviceTraceReset(EEPROM_AT24CXX_DEVICE* device);
+#endif
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceInitialize(EEPROM_AT24CXX_DEVICE* device, EEPROM_MODEL_TYPE model, uint8_t a2, uint8_t a1, uint8_t a0);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceWrite8(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t data);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceWrite16(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint16_t data);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceWrite32(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint32_t data);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceWriteBlock(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceWriteBlockIfChanged(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceFlush(EEPROM_AT24CXX_DEVICE* device);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceInvalidateCache(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint32_t data_len);
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceRead8(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type);
+uint16_t PUTINFLASH EEPROM_AT24CXX_DeviceRead16(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type);
+uint32_t PUTINFLASH EEPROM_AT24CXX_DeviceRead32(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceReadBlock(EEPROM_AT24CXX_DEVICE* device, uint32_t address, EEPROM_ADDRESS_TYPE address_type, uint8_t* data, uint32_t data_len);
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceReadV(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_IOVEC* vec, uint8_t count);
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceWriteV(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_IOVEC* vec, uint8_t count);
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceDump(EEPROM_AT24CXX_DEVICE* device, uint32_t address, uint32_t len, EEPROM_AT24CXX_IMAGE_IO sink, void* user_data, uint32_t* crc);
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceRestore(EEPROM_AT24CXX_DEVICE* device, uint32_t address, uint32_t len, EEPROM_AT24CXX_IMAGE_IO source, void* user_data, uint32_t* pages_written);
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceVerify(EEPROM_AT24CXX_DEVICE* device, uint32_t address, uint32_t len, uint32_t crc);
+
+//REQUEST QUEUE FUNCTIONS
+//ANY THREAD SUBMITS, ONE BUS OWNER THREAD PROCESSES (BLOCKING WITH
+//ProcessQueue OR NON BLOCKING WITH Tick)
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceSubmit(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_REQUEST* request);
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceProcessQueue(EEPROM_AT24CXX_DEVICE* device, uint8_t max_requests);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_DeviceWaitRequest(EEPROM_AT24CXX_DEVICE* device, EEPROM_AT24CXX_REQUEST* request);
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceReadAsync(EEPROM_AT24CXX_DEVICE* device,
+                                                    EEPROM_AT24CXX_REQUEST* request,
+                                                    uint32_t address,
+                                                    EEPROM_ADDRESS_TYPE address_type,
+                                                    uint8_t* data,
+                                                    uint32_t data_len,
+                                                    void (*callback)(EEPROM_AT24CXX_REQUEST*),
+                                                    void* user_data);
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceWriteAsync(EEPROM_AT24CXX_DEVICE* device,
+                                                    EEPROM_AT24CXX_REQUEST* request,
+                                                    uint32_t address,
+                                                    EEPROM_ADDRESS_TYPE address_type,
+                                                    uint8_t* data,
+                                                    uint32_t data_len,
+                                                    void (*callback)(EEPROM_AT24CXX_REQUEST*),
+                                                    void* user_data);
+uint8_t PUTINFLASH EEPROM_AT24CXX_DeviceFlushAsync(EEPROM_AT24CXX_DEVICE* device,
+                                                    EEPROM_AT24CXX_REQUEST* request,
+                                                    void (*callback)(EEPROM_AT24CXX_REQUEST*),
+                                                    void* user_data);
+EEPROM_TICK_STATE PUTINFLASH EEPROM_AT24CXX_DeviceTick(EEPROM_AT24CXX_DEVICE* device);
 
-//INTERNAL FUNCTIONS
-static uint8_t PUTINFLASH _eeprom_at24cxx_validate_page_address(uint32_t p_address);
-static uint8_t PUTINFLASH _eeprom_at24cxx_validate_byte_address(uint32_t b_address);
+//MULTI DEVICE ARRAY FUNCTIONS
+//ARRAY ADDRESSES ARE ALWAYS BYTE ADDRESSES
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_ArrayInitialize(EEPROM_AT24CXX_ARRAY* array,
+                                                        EEPROM_ARRAY_TYPE type,
+                                                        EEPROM_AT24CXX_DEVICE** devices,
+                                                        uint8_t device_count);
+uint32_t PUTINFLASH EEPROM_AT24CXX_ArrayGetSize(EEPROM_AT24CXX_ARRAY* array);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_ArrayWriteBlock(EEPROM_AT24CXX_ARRAY* array, uint32_t address, uint8_t* data, uint32_t data_len);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_ArrayReadBlock(EEPROM_AT24CXX_ARRAY* array, uint32_t address, uint8_t* data, uint32_t data_len);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_ArrayFlush(EEPROM_AT24CXX_ARRAY* array);
 
 //END USER HELPER FUNCTION
-//ADD WEAR LEVELING FUNCTION HERE
+//WEAR LEVELING : SEE EEPROM_AT24CXX_KV.h
+//ATOMIC MULTI PAGE UPDATES : SEE EEPROM_AT24CXX_TXN.h
+//PER PAGE CRC : SEE EEPROM_AT24CXX_CRC.h
+//STRUCTS IN ONE BLOCK WRITE / READ : SEE EEPROM_AT24CXX_REC.h
+//NAMED BLOBS : SEE EEPROM_AT24CXX_FS.h
+//SEQUENTIAL READ / WRITE CURSORS : SEE EEPROM_AT24CXX_STREAM.h
+//COMPRESSED RECORDS : SEE EEPROM_AT24CXX_PACK.h
 //END FUNCTION PROTOTYPES/////////////////////////////////
 #endif
@@ -0,0 +1,359 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* PER PAGE CRC INTEGRITY LAYER
+*
+* NOTE
+* -------
+*   (1) EVERY PAGE OF A PROTECTED REGION HAS A CRC32 IN A TABLE KEPT
+*       RIGHT AFTER THE DATA, SO BIT ROT AND TORN WRITES (DATA WRITTEN,
+*       CRC NOT, OR THE OTHER WAY ROUND) SHOW UP AS A MISMATCH
+*
+*   (2) LAYOUT (REGION RELATIVE, ONE EEPROM_AT24CXX_PAGE_SIZE PAGE EACH)
+*       PAGE 0 ... n - 1 : DATA
+*       PAGE n ...       : CRC TABLE, [CRC32 4] PER DATA PAGE (8 PER PAGE)
+*
+*   (3) LAZY VERIFICATION : Read CHECKS A PAGE THE FIRST TIME IT IS
+*       TOUCHED (WHOLE PAGE + ITS CRC) AND REMEMBERS THE RESULT IN A RAM
+*       BITMAP, LATER READS OF IT COST NOTHING EXTRA. Scrub RECHECKS A
+*       BOUNDED NUMBER OF PAGES PER CALL (ROUND ROBIN) TO CATCH DECAY
+*       OF PAGES ALREADY MARKED GOOD, WITHOUT EVER STALLING A REQUEST
+*
+*   (4) Write UPDATES DATA FIRST, THEN THE CRC ENTRIES OF ALL PAGES IT
+*       TOUCHED (ONE TABLE PAGE WRITE COVERS 8 DATA PAGES). A PARTIAL
+*       PAGE WRITE REFUSES TO RESEAL A PAGE THAT FAILS ITS CHECK
+*
+*   (5) ONLY WRITES MADE THROUGH THIS LAYER KEEP THE TABLE CURRENT.
+*       CALL Seal ONCE ON A NEW REGION (OR AFTER WRITING IT DIRECTLY)
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#include "EEPROM_AT24CXX_CRC.h"
+
+#define _EEPROM_AT24CXX_CRC_VERIFIED(c, n)  (((c)->verified[(n) / 8] >> ((n) % 8)) & 1)
+
+//INTERNAL FUNCTIONS//////////////////////////////////////////
+static uint32_t PUTINFLASH _eeprom_at24cxx_crc_data_address(EEPROM_AT24CXX_CRC* crc, uint16_t page);
+static uint32_t PUTINFLASH _eeprom_at24cxx_crc_entry_address(EEPROM_AT24CXX_CRC* crc, uint16_t page);
+static uint8_t PUTINFLASH _eeprom_at24cxx_crc_check(EEPROM_AT24CXX_CRC* crc, uint16_t page, uint8_t* page_data, uint8_t refresh);
+static uint8_t PUTINFLASH _eeprom_at24cxx_crc_put(EEPROM_AT24CXX_CRC* crc, uint16_t page, uint8_t* page_data, uint8_t* entries, uint16_t* batch_first, uint8_t* batch_count);
+static uint8_t PUTINFLASH _eeprom_at24cxx_crc_put_flush(EEPROM_AT24CXX_CRC* crc, uint8_t* entries, uint16_t batch_first, uint8_t* batch_count);
+static uint8_t PUTINFLASH _eeprom_at24cxx_crc_range(EEPROM_AT24CXX_CRC* crc, uint32_t address, uint32_t len);
+//END INTERNAL FUNCTIONS//////////////////////////////////////
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_CRCInit(EEPROM_AT24CXX_CRC* crc,
+                                            EEPROM_AT24CXX_DEVICE* device,
+                                            uint16_t first_page,
+                                            uint16_t page_count)
+{
+    //ATTACH TO REGION. NO EEPROM ACCESS, EVERY PAGE STARTS UNVERIFIED
+
+    uint32_t device_pages;
+    uint32_t table_pages;
+
+    table_pages = ((uint32_t)page_count + EEPROM_AT24CXX_CRC_ENTRIES_PER_PAGE - 1) / EEPROM_AT24CXX_CRC_ENTRIES_PER_PAGE;
+    device_pages = EEPROM_AT24CXX_DeviceGetSize(device) / EEPROM_AT24CXX_PAGE_SIZE;
+    if(page_count == 0 || page_count > EEPROM_AT24CXX_CRC_MAX_PAGES ||
+        (uint32_t)first_page + page_count + table_pages > device_pages)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : CRC : Invalid region !\n");
+        return 0;
+    }
+
+    crc->device = device;
+    crc->first_page = first_page;
+    crc->page_count = page_count;
+    crc->table_page = first_page + page_count;
+    crc->scrub_next = 0;
+    crc->errors = 0;
+    memset(crc->verified, 0, sizeof(crc->verified));
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_CRCSeal(EEPROM_AT24CXX_CRC* crc)
+{
+    //RECOMPUTE AND STORE THE CRC OF EVERY DATA PAGE AS IT IS NOW
+
+    uint8_t page_data[EEPROM_AT24CXX_PAGE_SIZE];
+    uint8_t entries[EEPROM_AT24CXX_PAGE_SIZE];
+    uint16_t batch_first = 0;
+    uint8_t batch_count = 0;
+    uint16_t page;
+
+    for(page = 0; page < crc->page_count; page++)
+    {
+        if(EEPROM_AT24CXX_DeviceReadBlock(crc->device, _eeprom_at24cxx_crc_data_address(crc, page), ADDRESS_TYPE_BYTE, page_data, EEPROM_AT24CXX_PAGE_SIZE) != EEPROM_STATUS_OK ||
+            !_eeprom_at24cxx_crc_put(crc, page, page_data, entries, &batch_first, &batch_count))
+        {
+            return 0;
+        }
+    }
+    return _eeprom_at24cxx_crc_put_flush(crc, entries, batch_first, &batch_count);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_CRCRead(EEPROM_AT24CXX_CRC* crc, uint32_t address, uint8_t* data, uint32_t len)
+{
+    //READ, CHECKING EACH PAGE ON ITS FIRST READ
+    //RETURN 0 AT THE FIRST PAGE THAT FAILS ITS CHECK
+
+    uint8_t page_data[EEPROM_AT24CXX_PAGE_SIZE];
+    uint32_t offset;
+    uint32_t chunk_len;
+    uint16_t page;
+
+    if(!_eeprom_at24cxx_crc_range(crc, address, len))
+    {
+        return 0;
+    }
+
+    while(len > 0)
+    {
+        page = (uint16_t)(address / EEPROM_AT24CXX_PAGE_SIZE);
+        offset = address % EEPROM_AT24CXX_PAGE_SIZE;
+        chunk_len = EEPROM_AT24CXX_PAGE_SIZE - offset;
+        if(chunk_len > len)
+        {
+            chunk_len = len;
+        }
+
+        if(_EEPROM_AT24CXX_CRC_VERIFIED(crc, page))
+        {
+            if(EEPROM_AT24CXX_DeviceReadBlock(crc->device, _eeprom_at24cxx_crc_data_address(crc, page) + offset, ADDRESS_TYPE_BYTE, data, chunk_len) != EEPROM_STATUS_OK)
+            {
+                return 0;
+            }
+        }
+        else
+        {
+            if(!_eeprom_at24cxx_crc_check(crc, page, page_data, 0))
+            {
+                return 0;
+            }
+            memcpy(data, &page_data[offset], chunk_len);
+        }
+
+        address += chunk_len;
+        data += chunk_len;
+        len -= chunk_len;
+    }
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_CRCWrite(EEPROM_AT24CXX_CRC* crc, uint32_t address, uint8_t* data, uint32_t len)
+{
+    //WRITE DATA, THEN THE CRC ENTRIES OF THE PAGES IT TOUCHED
+    //A FAILED DATA WRITE STOPS HERE, PAGES ALREADY WRITTEN ARE STILL
+    //RESEALED AND THE FAILED ONE IS LEFT FOR THE NEXT READ TO CHECK
+
+    uint8_t page_data[EEPROM_AT24CXX_PAGE_SIZE];
+    uint8_t entries[EEPROM_AT24CXX_PAGE_SIZE];
+    uint16_t batch_first = 0;
+    uint8_t batch_count = 0;
+    uint32_t offset;
+    uint32_t chunk_len;
+    uint16_t page;
+    uint8_t known;
+
+    if(!_eeprom_at24cxx_crc_range(crc, address, len))
+    {
+        return 0;
+    }
+
+    while(len > 0)
+    {
+        page = (uint16_t)(address / EEPROM_AT24CXX_PAGE_SIZE);
+        offset = address % EEPROM_AT24CXX_PAGE_SIZE;
+        chunk_len = EEPROM_AT24CXX_PAGE_SIZE - offset;
+        if(chunk_len > len)
+        {
+            chunk_len = len;
+        }
+
+        //THE NEW CRC COVERS THE BYTES AROUND A PARTIAL WRITE TOO, SO
+        //THOSE MUST BE KNOWN GOOD FIRST
+        if(chunk_len < EEPROM_AT24CXX_PAGE_SIZE)
+        {
+            if(_EEPROM_AT24CXX_CRC_VERIFIED(crc, page))
+            {
+                known = (EEPROM_AT24CXX_DeviceReadBlock(crc->device, _eeprom_at24cxx_crc_data_address(crc, page), ADDRESS_TYPE_BYTE, page_data, EEPROM_AT24CXX_PAGE_SIZE) == EEPROM_STATUS_OK);
+            }
+            else
+            {
+                known = _eeprom_at24cxx_crc_check(crc, page, page_data, 0);
+            }
+            if(!known)
+            {
+                _eeprom_at24cxx_crc_put_flush(crc, entries, batch_first, &batch_count);
+                return 0;
+            }
+        }
+        memcpy(&page_data[offset], data, chunk_len);
+
+        if(EEPROM_AT24CXX_DeviceWriteBlock(crc->device, _eeprom_at24cxx_crc_data_address(crc, page) + offset, ADDRESS_TYPE_BYTE, data, chunk_len) != EEPROM_STATUS_OK)
+        {
+            crc->verified[page / 8] &= ~(1 << (page % 8));
+            _eeprom_at24cxx_crc_put_flush(crc, entries, batch_first, &batch_count);
+            return 0;
+        }
+        if(!_eeprom_at24cxx_crc_put(crc, page, page_data, entries, &batch_first, &batch_count))
+        {
+            return 0;
+        }
+
+        address += chunk_len;
+        data += chunk_len;
+        len -= chunk_len;
+    }
+    return _eeprom_at24cxx_crc_put_flush(crc, entries, batch_first, &batch_count);
+}
+
+uint16_t PUTINFLASH EEPROM_AT24CXX_CRCScrub(EEPROM_AT24CXX_CRC* crc, uint16_t max_pages)
+{
+    //RECHECK UP TO max_pages PAGES FROM THE EEPROM ITSELF (NOT THE PAGE
+    //CACHE), CONTINUING WHERE THE LAST CALL STOPPED
+    //RETURN NUMBER OF PAGES THAT FAILED
+
+    uint8_t page_data[EEPROM_AT24CXX_PAGE_SIZE];
+    uint16_t bad = 0;
+
+    if(max_pages > crc->page_count)
+    {
+        max_pages = crc->page_count;
+    }
+
+    while(max_pages--)
+    {
+        if(!_eeprom_at24cxx_crc_check(crc, crc->scrub_next, page_data, 1))
+        {
+            bad++;
+        }
+        crc->scrub_next = (crc->scrub_next + 1) % crc->page_count;
+    }
+    return bad;
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_CRCGetErrors(EEPROM_AT24CXX_CRC* crc)
+{
+    //RETURN NUMBER OF CRC MISMATCHES SEEN SINCE Init
+
+    return crc->errors;
+}
+
+static uint32_t PUTINFLASH _eeprom_at24cxx_crc_data_address(EEPROM_AT24CXX_CRC* crc, uint16_t page)
+{
+    //DATA PAGE TO DEVICE BYTE ADDRESS
+
+    return EEPROM_GET_BYTE_ADDRESS_FROM_PAGE((uint32_t)crc->first_page + page);
+}
+
+static uint32_t PUTINFLASH _eeprom_at24cxx_crc_entry_address(EEPROM_AT24CXX_CRC* crc, uint16_t page)
+{
+    //DATA PAGE TO DEVICE BYTE ADDRESS OF ITS CRC TABLE ENTRY
+
+    return EEPROM_GET_BYTE_ADDRESS_FROM_PAGE((uint32_t)crc->table_page) + (uint32_t)page * EEPROM_AT24CXX_CRC_ENTRY_SIZE;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_crc_check(EEPROM_AT24CXX_CRC* crc, uint16_t page, uint8_t* page_data, uint8_t refresh)
+{
+    //READ DATA PAGE INTO page_data AND CHECK IT AGAINST ITS TABLE ENTRY
+    //refresh DROPS CLEAN CACHED COPIES FIRST SO THE EEPROM IS READ
+    //UPDATE THE VERIFIED BITMAP, RETURN 1 IF THE PAGE IS GOOD
+    //A FAILED READ RETURNS 0 WITHOUT COUNTING A MISMATCH
+
+    uint8_t entry[EEPROM_AT24CXX_CRC_ENTRY_SIZE];
+    uint32_t stored;
+
+    if(refresh)
+    {
+        EEPROM_AT24CXX_DeviceInvalidateCache(crc->device, _eeprom_at24cxx_crc_data_address(crc, page), ADDRESS_TYPE_BYTE, EEPROM_AT24CXX_PAGE_SIZE);
+        EEPROM_AT24CXX_DeviceInvalidateCache(crc->device, _eeprom_at24cxx_crc_entry_address(crc, page), ADDRESS_TYPE_BYTE, EEPROM_AT24CXX_CRC_ENTRY_SIZE);
+    }
+    if(EEPROM_AT24CXX_DeviceReadBlock(crc->device, _eeprom_at24cxx_crc_data_address(crc, page), ADDRESS_TYPE_BYTE, page_data, EEPROM_AT24CXX_PAGE_SIZE) != EEPROM_STATUS_OK ||
+        EEPROM_AT24CXX_DeviceReadBlock(crc->device, _eeprom_at24cxx_crc_entry_address(crc, page), ADDRESS_TYPE_BYTE, entry, EEPROM_AT24CXX_CRC_ENTRY_SIZE) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+
+    stored = ((uint32_t)entry[0] << 24) | ((uint32_t)entry[1] << 16) | ((uint32_t)entry[2] << 8) | entry[3];
+    if(EEPROM_AT24CXX_Crc32(0, page_data, EEPROM_AT24CXX_PAGE_SIZE) != stored)
+    {
+        crc->verified[page / 8] &= ~(1 << (page % 8));
+        crc->errors++;
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : CRC : page %u failed check !\n", page);
+        return 0;
+    }
+    crc->verified[page / 8] |= (1 << (page % 8));
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_crc_put(EEPROM_AT24CXX_CRC* crc, uint16_t page, uint8_t* page_data, uint8_t* entries, uint16_t* batch_first, uint8_t* batch_count)
+{
+    //QUEUE THE CRC OF page_data AS THE NEW ENTRY OF page
+    //PAGES COME IN ASCENDING ORDER, ENTRIES GO OUT ONE TABLE PAGE AT A TIME
+    //RETURN 0 IF WRITING THE PREVIOUS TABLE PAGE FAILED
+
+    uint32_t value;
+    uint8_t* entry;
+
+    if(*batch_count > 0 && (page / EEPROM_AT24CXX_CRC_ENTRIES_PER_PAGE) != (*batch_first / EEPROM_AT24CXX_CRC_ENTRIES_PER_PAGE))
+    {
+        if(!_eeprom_at24cxx_crc_put_flush(crc, entries, *batch_first, batch_count))
+        {
+            return 0;
+        }
+    }
+    if(*batch_count == 0)
+    {
+        *batch_first = page;
+    }
+
+    value = EEPROM_AT24CXX_Crc32(0, page_data, EEPROM_AT24CXX_PAGE_SIZE);
+    entry = &entries[*batch_count * EEPROM_AT24CXX_CRC_ENTRY_SIZE];
+    entry[0] = (uint8_t)(value >> 24);
+    entry[1] = (uint8_t)(value >> 16);
+    entry[2] = (uint8_t)(value >> 8);
+    entry[3] = (uint8_t)value;
+    (*batch_count)++;
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_crc_put_flush(EEPROM_AT24CXX_CRC* crc, uint8_t* entries, uint16_t batch_first, uint8_t* batch_count)
+{
+    //WRITE QUEUED ENTRIES (ALL IN ONE TABLE PAGE)
+    //THEIR PAGES COUNT AS VERIFIED ONLY ONCE THE WRITE WENT THROUGH
+
+    uint8_t ok;
+    uint16_t page;
+
+    if(*batch_count == 0)
+    {
+        return 1;
+    }
+    ok = (EEPROM_AT24CXX_DeviceWriteBlock(crc->device, _eeprom_at24cxx_crc_entry_address(crc, batch_first), ADDRESS_TYPE_BYTE, entries, (uint32_t)*batch_count * EEPROM_AT24CXX_CRC_ENTRY_SIZE) == EEPROM_STATUS_OK);
+    for(page = batch_first; page < batch_first + *batch_count; page++)
+    {
+        if(ok)
+        {
+            crc->verified[page / 8] |= (1 << (page % 8));
+        }
+        else
+        {
+            crc->verified[page / 8] &= ~(1 << (page % 8));
+        }
+    }
+    *batch_count = 0;
+    return ok;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_crc_range(EEPROM_AT24CXX_CRC* crc, uint32_t address, uint32_t len)
+{
+    //RETURN 1 IF [address, address + len) LIES IN THE DATA
+
+    uint32_t size = (uint32_t)crc->page_count * EEPROM_AT24CXX_PAGE_SIZE;
+
+    return (len > 0 && address < size && len <= size - address);
+}
@@ -0,0 +1,83 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* PER PAGE CRC INTEGRITY LAYER
+*
+* NOTE
+* -------
+*   (1) EVERY PAGE OF A PROTECTED REGION HAS A CRC32 IN A TABLE KEPT
+*       RIGHT AFTER THE DATA, SO BIT ROT AND TORN WRITES (DATA WRITTEN,
+*       CRC NOT, OR THE OTHER WAY ROUND) SHOW UP AS A MISMATCH
+*
+*   (2) LAYOUT (REGION RELATIVE, ONE EEPROM_AT24CXX_PAGE_SIZE PAGE EACH)
+*       PAGE 0 ... n - 1 : DATA
+*       PAGE n ...       : CRC TABLE, [CRC32 4] PER DATA PAGE (8 PER PAGE)
+*
+*   (3) LAZY VERIFICATION : Read CHECKS A PAGE THE FIRST TIME IT IS
+*       TOUCHED (WHOLE PAGE + ITS CRC) AND REMEMBERS THE RESULT IN A RAM
+*       BITMAP, LATER READS OF IT COST NOTHING EXTRA. Scrub RECHECKS A
+*       BOUNDED NUMBER OF PAGES PER CALL (ROUND ROBIN) TO CATCH DECAY
+*       OF PAGES ALREADY MARKED GOOD, WITHOUT EVER STALLING A REQUEST
+*
+*   (4) Write UPDATES DATA FIRST, THEN THE CRC ENTRIES OF ALL PAGES IT
+*       TOUCHED (ONE TABLE PAGE WRITE COVERS 8 DATA PAGES). A PARTIAL
+*       PAGE WRITE REFUSES TO RESEAL A PAGE THAT FAILS ITS CHECK
+*
+*   (5) ONLY WRITES MADE THROUGH THIS LAYER KEEP THE TABLE CURRENT.
+*       CALL Seal ONCE ON A NEW REGION (OR AFTER WRITING IT DIRECTLY)
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#ifndef _EEPROM_AT24CXX_CRC_H_
+#define _EEPROM_AT24CXX_CRC_H_
+
+#include "EEPROM_AT24CXX.h"
+
+//LARGEST REGION IN DATA PAGES (SIZES THE RAM BITMAP, MULTIPLE OF 8)
+#ifndef EEPROM_AT24CXX_CRC_MAX_PAGES
+  #define EEPROM_AT24CXX_CRC_MAX_PAGES        256
+#endif
+#if (EEPROM_AT24CXX_CRC_MAX_PAGES % 8) || (EEPROM_AT24CXX_CRC_MAX_PAGES == 0)
+  #error "EEPROM : AT24CXX : CRC : max pages must be a multiple of 8"
+#endif
+
+#define EEPROM_AT24CXX_CRC_ENTRY_SIZE         4
+#define EEPROM_AT24CXX_CRC_ENTRIES_PER_PAGE   (EEPROM_AT24CXX_PAGE_SIZE / EEPROM_AT24CXX_CRC_ENTRY_SIZE)
+
+//CUSTOM VARIABLE STRUCTURES/////////////////////////////
+typedef struct
+{
+    EEPROM_AT24CXX_DEVICE* device;
+    uint16_t first_page;    //REGION START (DEVICE PAGE)
+    uint16_t page_count;    //DATA PAGES
+    uint16_t table_page;    //FIRST CRC TABLE PAGE (DEVICE PAGE)
+
+    uint16_t scrub_next;    //NEXT PAGE Scrub CHECKS
+    uint32_t errors;        //MISMATCHES SEEN SO FAR
+    uint8_t verified[EEPROM_AT24CXX_CRC_MAX_PAGES / 8];
+} EEPROM_AT24CXX_CRC;
+//END CUSTOM VARIABLE STRUCTURES/////////////////////////
+
+//FUNCTION PROTOTYPES/////////////////////////////////////
+//REGION HOLDS page_count DATA PAGES (DATA SIZE page_count *
+//EEPROM_AT24CXX_PAGE_SIZE) FROM first_page FOLLOWED BY ITS CRC TABLE
+//(page_count / 8 PAGES, ROUNDED UP). ADDRESSES ARE BYTE OFFSETS INTO
+//THE DATA. Read / Write RETURN 0 ON A CRC MISMATCH OR A FAILED TRANSFER
+//(SEE DeviceGetLastStatus, A PAGE WHOSE DATA WRITE FAILED IS NOT
+//RESEALED), Scrub RETURNS THE NUMBER OF BAD OR UNREADABLE PAGES IT
+//FOUND. OTHERS RETURN 1 ON SUCCESS, 0 ON FAILURE
+uint8_t PUTINFLASH EEPROM_AT24CXX_CRCInit(EEPROM_AT24CXX_CRC* crc,
+                                            EEPROM_AT24CXX_DEVICE* device,
+                                            uint16_t first_page,
+                                            uint16_t page_count);
+uint8_t PUTINFLASH EEPROM_AT24CXX_CRCSeal(EEPROM_AT24CXX_CRC* crc);
+uint8_t PUTINFLASH EEPROM_AT24CXX_CRCRead(EEPROM_AT24CXX_CRC* crc, uint32_t address, uint8_t* data, uint32_t len);
+uint8_t PUTINFLASH EEPROM_AT24CXX_CRCWrite(EEPROM_AT24CXX_CRC* crc, uint32_t address, uint8_t* data, uint32_t len);
+uint16_t PUTINFLASH EEPROM_AT24CXX_CRCScrub(EEPROM_AT24CXX_CRC* crc, uint16_t max_pages);
+uint32_t PUTINFLASH EEPROM_AT24CXX_CRCGetErrors(EEPROM_AT24CXX_CRC* crc);
+//END FUNCTION PROTOTYPES/////////////////////////////////
+#endif
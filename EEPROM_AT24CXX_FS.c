@@ -0,0 +1,753 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* NAMED BLOB STORE
+*
+* NOTE
+* -------
+*   (1) BLOBS ARE LOOKED UP BY NAME (UP TO EEPROM_AT24CXX_FS_NAME_LEN
+*       BYTES) AND GROW BY Append, SO NOTHING HAS A FIXED OFFSET AND
+*       RESIZING NEEDS NO LAYOUT CHANGE
+*
+*   (2) LAYOUT (REGION RELATIVE, ONE EEPROM_AT24CXX_PAGE_SIZE PAGE EACH)
+*       PAGE 0          : SUPER  [MAGIC "FS" 2][VERSION 1][PAGES 2]
+*                                [FILES 1][CRC32 4]
+*       PAGE 1 ... F    : DIRECTORY, ONE ENTRY PER PAGE
+*                         [NAME 12][SIZE 4][EXTENT (START 2, LEN 1) x 5]
+*                         [CRC8 1], ALL 0xFF = FREE
+*       PAGE F + 1 ...  : DATA, ALLOCATED A PAGE AT A TIME
+*       A BLOB IS UP TO EEPROM_AT24CXX_FS_MAX_EXTENTS RUNS OF PAGES.
+*       BLOB OFFSET n IS AT OFFSET n % PAGE_SIZE OF ITS PAGE, SO AN
+*       APPEND THAT STAYS IN ONE PAGE IS ONE PAGE WRITE
+*
+*   (3) Mount READS THE SUPER AND DIRECTORY PAGES ONCE AND BUILDS THE
+*       RAM DIRECTORY (NAME HASH INDEX) AND THE PAGE ALLOCATION BITMAP
+*       FROM THE EXTENTS. Open / LOOKUP / ALLOCATION NEVER TOUCH THE
+*       EEPROM, DATA PAGES ARE NEVER SCANNED
+*
+*   (4) DIRECTORY CHANGES (CREATE, SIZE, EXTENTS, DELETE) STAY IN RAM
+*       TILL Sync, WHICH WRITES ONE PAGE PER CHANGED ENTRY. PAGES FREED
+*       BY Truncate / Delete ARE ONLY REUSED AFTER Sync. AN Append BELOW
+*       THE SYNCED SIZE (AFTER A Truncate INSIDE A PAGE) FIRST COPIES
+*       THE KEPT PART OF THE TAIL PAGE TO A NEW PAGE, SO A RESET AT ANY
+*       POINT LEAVES THE STATE OF THE LAST Sync INTACT
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#include "EEPROM_AT24CXX_FS.h"
+
+#define _EEPROM_AT24CXX_FS_MAGIC_0          'F'
+#define _EEPROM_AT24CXX_FS_MAGIC_1          'S'
+#define _EEPROM_AT24CXX_FS_SUPER_SIZE       10
+#define _EEPROM_AT24CXX_FS_EXTENT_OFFSET    (EEPROM_AT24CXX_FS_NAME_LEN + 4)
+#define _EEPROM_AT24CXX_FS_CRC_OFFSET       (EEPROM_AT24CXX_PAGE_SIZE - 1)
+#define _EEPROM_AT24CXX_FS_INDEX_SLOTS      (EEPROM_AT24CXX_FS_MAX_FILES * 2)
+
+#if (_EEPROM_AT24CXX_FS_EXTENT_OFFSET + EEPROM_AT24CXX_FS_MAX_EXTENTS * 3 > _EEPROM_AT24CXX_FS_CRC_OFFSET)
+  #error "EEPROM : AT24CXX : FS : directory entry does not fit a page"
+#endif
+
+#define _EEPROM_AT24CXX_FS_BIT(map, n)      (((map)[(n) / 8] >> ((n) % 8)) & 1)
+#define _EEPROM_AT24CXX_FS_SET(map, n)      ((map)[(n) / 8] |= (1 << ((n) % 8)))
+#define _EEPROM_AT24CXX_FS_CLEAR(map, n)    ((map)[(n) / 8] &= ~(1 << ((n) % 8)))
+
+//INTERNAL FUNCTIONS//////////////////////////////////////////
+static uint8_t PUTINFLASH _eeprom_at24cxx_fs_setup(EEPROM_AT24CXX_FS* fs, EEPROM_AT24CXX_DEVICE* device, uint16_t first_page, uint16_t page_count, uint8_t file_count);
+static uint32_t PUTINFLASH _eeprom_at24cxx_fs_page_address(EEPROM_AT24CXX_FS* fs, uint16_t page);
+static uint8_t PUTINFLASH _eeprom_at24cxx_fs_hash(const char* name);
+static uint8_t PUTINFLASH _eeprom_at24cxx_fs_name_equal(EEPROM_AT24CXX_FS_ENTRY* entry, const char* name);
+static int8_t PUTINFLASH _eeprom_at24cxx_fs_find(EEPROM_AT24CXX_FS* fs, const char* name);
+static void PUTINFLASH _eeprom_at24cxx_fs_index_rebuild(EEPROM_AT24CXX_FS* fs);
+static EEPROM_AT24CXX_FS_ENTRY* PUTINFLASH _eeprom_at24cxx_fs_get(EEPROM_AT24CXX_FS* fs, int8_t id);
+static uint16_t PUTINFLASH _eeprom_at24cxx_fs_map(EEPROM_AT24CXX_FS_ENTRY* entry, uint32_t page, uint16_t* run);
+static uint8_t PUTINFLASH _eeprom_at24cxx_fs_alloc(EEPROM_AT24CXX_FS* fs, EEPROM_AT24CXX_FS_ENTRY* entry);
+static uint8_t PUTINFLASH _eeprom_at24cxx_fs_unshare_tail(EEPROM_AT24CXX_FS* fs, EEPROM_AT24CXX_FS_ENTRY* entry);
+static void PUTINFLASH _eeprom_at24cxx_fs_encode(EEPROM_AT24CXX_FS_ENTRY* entry, uint8_t* page_data);
+static uint8_t PUTINFLASH _eeprom_at24cxx_fs_decode(EEPROM_AT24CXX_FS* fs, EEPROM_AT24CXX_FS_ENTRY* entry, uint8_t* page_data);
+//END INTERNAL FUNCTIONS//////////////////////////////////////
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_FSFormat(EEPROM_AT24CXX_FS* fs,
+                                            EEPROM_AT24CXX_DEVICE* device,
+                                            uint16_t first_page,
+                                            uint16_t page_count,
+                                            uint8_t file_count)
+{
+    //WRITE AN EMPTY DIRECTORY AND THE SUPER PAGE (LAST, SO A RESET
+    //DURING FORMAT LEAVES NO VALID STORE)
+    //DATA PAGES ARE NOT TOUCHED
+
+    uint8_t page_data[EEPROM_AT24CXX_PAGE_SIZE];
+    uint32_t crc;
+    uint16_t i;
+
+    if(!_eeprom_at24cxx_fs_setup(fs, device, first_page, page_count, file_count))
+    {
+        return 0;
+    }
+
+    memset(page_data, 0xFF, EEPROM_AT24CXX_PAGE_SIZE);
+    for(i = 0; i <= fs->file_count; i++)
+    {
+        if(EEPROM_AT24CXX_DeviceWriteBlock(fs->device, _eeprom_at24cxx_fs_page_address(fs, i), ADDRESS_TYPE_BYTE, page_data, EEPROM_AT24CXX_PAGE_SIZE) != EEPROM_STATUS_OK)
+        {
+            return 0;
+        }
+    }
+    if(EEPROM_AT24CXX_DeviceFlush(fs->device) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+
+    page_data[0] = _EEPROM_AT24CXX_FS_MAGIC_0;
+    page_data[1] = _EEPROM_AT24CXX_FS_MAGIC_1;
+    page_data[2] = EEPROM_AT24CXX_FS_VERSION;
+    page_data[3] = (uint8_t)(page_count >> 8);
+    page_data[4] = (uint8_t)page_count;
+    page_data[5] = file_count;
+    crc = EEPROM_AT24CXX_Crc32(0, page_data, 6);
+    page_data[6] = (uint8_t)(crc >> 24);
+    page_data[7] = (uint8_t)(crc >> 16);
+    page_data[8] = (uint8_t)(crc >> 8);
+    page_data[9] = (uint8_t)crc;
+    if(EEPROM_AT24CXX_DeviceWriteBlock(fs->device, _eeprom_at24cxx_fs_page_address(fs, 0), ADDRESS_TYPE_BYTE, page_data, _EEPROM_AT24CXX_FS_SUPER_SIZE) != EEPROM_STATUS_OK ||
+        EEPROM_AT24CXX_DeviceFlush(fs->device) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_FSMount(EEPROM_AT24CXX_FS* fs, EEPROM_AT24CXX_DEVICE* device, uint16_t first_page)
+{
+    //READ SUPER AND DIRECTORY PAGES, BUILD RAM DIRECTORY AND BITMAP
+
+    uint8_t page_data[EEPROM_AT24CXX_PAGE_SIZE];
+    uint32_t crc;
+    uint8_t i;
+
+    if(EEPROM_AT24CXX_DeviceReadBlock(device, EEPROM_GET_BYTE_ADDRESS_FROM_PAGE((uint32_t)first_page), ADDRESS_TYPE_BYTE, page_data, _EEPROM_AT24CXX_FS_SUPER_SIZE) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+    crc = ((uint32_t)page_data[6] << 24) | ((uint32_t)page_data[7] << 16) | ((uint32_t)page_data[8] << 8) | page_data[9];
+    if(page_data[0] != _EEPROM_AT24CXX_FS_MAGIC_0 || page_data[1] != _EEPROM_AT24CXX_FS_MAGIC_1 ||
+        page_data[2] != EEPROM_AT24CXX_FS_VERSION || EEPROM_AT24CXX_Crc32(0, page_data, 6) != crc)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : FS : no store found !\n");
+        return 0;
+    }
+    if(!_eeprom_at24cxx_fs_setup(fs, device, first_page, ((uint16_t)page_data[3] << 8) | page_data[4], page_data[5]))
+    {
+        return 0;
+    }
+
+    for(i = 0; i < fs->file_count; i++)
+    {
+        if(EEPROM_AT24CXX_DeviceReadBlock(fs->device, _eeprom_at24cxx_fs_page_address(fs, i + 1), ADDRESS_TYPE_BYTE, page_data, EEPROM_AT24CXX_PAGE_SIZE) != EEPROM_STATUS_OK ||
+            !_eeprom_at24cxx_fs_decode(fs, &fs->entry[i], page_data))
+        {
+            return 0;
+        }
+    }
+    _eeprom_at24cxx_fs_index_rebuild(fs);
+    return 1;
+}
+
+int8_t PUTINFLASH EEPROM_AT24CXX_FSOpen(EEPROM_AT24CXX_FS* fs, const char* name, uint8_t create)
+{
+    //LOOK UP BLOB BY NAME, CREATE IT (EMPTY) IF ASKED TO
+    //RAM ONLY, A NEW BLOB IS STORED BY THE NEXT Sync
+
+    EEPROM_AT24CXX_FS_ENTRY* entry;
+    int8_t id;
+    uint8_t i;
+
+    if(name == NULL || name[0] == '\0' || strlen(name) > EEPROM_AT24CXX_FS_NAME_LEN)
+    {
+        return -1;
+    }
+
+    id = _eeprom_at24cxx_fs_find(fs, name);
+    if(id >= 0 || !create)
+    {
+        return id;
+    }
+
+    for(i = 0; i < fs->file_count; i++)
+    {
+        entry = &fs->entry[i];
+        if(!entry->used)
+        {
+            memset(entry, 0, sizeof(EEPROM_AT24CXX_FS_ENTRY));
+            strncpy(entry->name, name, EEPROM_AT24CXX_FS_NAME_LEN);
+            entry->used = 1;
+            entry->dirty = 1;
+            _eeprom_at24cxx_fs_index_rebuild(fs);
+            return (int8_t)i;
+        }
+    }
+    EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : FS : directory full !\n");
+    return -1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_FSAppend(EEPROM_AT24CXX_FS* fs, int8_t id, uint8_t* data, uint32_t len)
+{
+    //ADD len BYTES AT THE END OF THE BLOB
+    //EVERY PAGE TOUCHED IS ONE PAGE WRITE, NEW PAGES ARE TAKEN FROM THE
+    //RAM BITMAP. RETURN 0 (WITH WHAT FITTED APPENDED) IF SPACE RUNS OUT
+    //OR A WRITE FAILS
+
+    EEPROM_AT24CXX_FS_ENTRY* entry;
+    uint32_t offset;
+    uint32_t chunk_len;
+    uint16_t page;
+
+    entry = _eeprom_at24cxx_fs_get(fs, id);
+    if(entry == NULL)
+    {
+        return 0;
+    }
+
+    //TAIL PAGE STILL HOLDS SYNCED BYTES PAST THE END (NOTE 4)
+    if(len > 0 && entry->size < entry->shared_size && (entry->size % EEPROM_AT24CXX_PAGE_SIZE) != 0 &&
+        !_eeprom_at24cxx_fs_unshare_tail(fs, entry))
+    {
+        return 0;
+    }
+
+    while(len > 0)
+    {
+        page = _eeprom_at24cxx_fs_map(entry, entry->size / EEPROM_AT24CXX_PAGE_SIZE, NULL);
+        if(page == 0)
+        {
+            if(!_eeprom_at24cxx_fs_alloc(fs, entry))
+            {
+                EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : FS : no space !\n");
+                return 0;
+            }
+            page = _eeprom_at24cxx_fs_map(entry, entry->size / EEPROM_AT24CXX_PAGE_SIZE, NULL);
+        }
+
+        offset = entry->size % EEPROM_AT24CXX_PAGE_SIZE;
+        chunk_len = EEPROM_AT24CXX_PAGE_SIZE - offset;
+        if(chunk_len > len)
+        {
+            chunk_len = len;
+        }
+        if(EEPROM_AT24CXX_DeviceWriteBlock(fs->device, _eeprom_at24cxx_fs_page_address(fs, page) + offset, ADDRESS_TYPE_BYTE, data, chunk_len) != EEPROM_STATUS_OK)
+        {
+            return 0;
+        }
+
+        entry->size += chunk_len;
+        entry->dirty = 1;
+        data += chunk_len;
+        len -= chunk_len;
+    }
+    return 1;
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_FSRead(EEPROM_AT24CXX_FS* fs, int8_t id, uint32_t offset, uint8_t* data, uint32_t len)
+{
+    //READ UP TO len BYTES FROM BLOB OFFSET offset
+    //ONE READ PER CONTIGUOUS RUN OF PAGES
+    //RETURN NUMBER OF BYTES READ
+
+    EEPROM_AT24CXX_FS_ENTRY* entry;
+    uint32_t done = 0;
+    uint32_t chunk_len;
+    uint16_t page;
+    uint16_t run = 0;
+
+    entry = _eeprom_at24cxx_fs_get(fs, id);
+    if(entry == NULL || offset >= entry->size)
+    {
+        return 0;
+    }
+    if(len > entry->size - offset)
+    {
+        len = entry->size - offset;
+    }
+
+    while(done < len)
+    {
+        page = _eeprom_at24cxx_fs_map(entry, offset / EEPROM_AT24CXX_PAGE_SIZE, &run);
+        if(page == 0)
+        {
+            break;
+        }
+        chunk_len = (uint32_t)run * EEPROM_AT24CXX_PAGE_SIZE - (offset % EEPROM_AT24CXX_PAGE_SIZE);
+        if(chunk_len > len - done)
+        {
+            chunk_len = len - done;
+        }
+        if(EEPROM_AT24CXX_DeviceReadBlock(fs->device,
+                                            _eeprom_at24cxx_fs_page_address(fs, page) + (offset % EEPROM_AT24CXX_PAGE_SIZE),
+                                            ADDRESS_TYPE_BYTE,
+                                            data + done,
+                                            chunk_len) != EEPROM_STATUS_OK)
+        {
+            break;
+        }
+        offset += chunk_len;
+        done += chunk_len;
+    }
+    return done;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_FSTruncate(EEPROM_AT24CXX_FS* fs, int8_t id, uint32_t size)
+{
+    //SHRINK BLOB TO size BYTES, RELEASING PAGES PAST THE NEW END
+    //(REUSABLE AFTER THE NEXT Sync)
+
+    EEPROM_AT24CXX_FS_ENTRY* entry;
+    uint32_t keep;
+    uint32_t pages = 0;
+    uint16_t page;
+    uint8_t i;
+
+    entry = _eeprom_at24cxx_fs_get(fs, id);
+    if(entry == NULL || size > entry->size)
+    {
+        return 0;
+    }
+
+    keep = (size + EEPROM_AT24CXX_PAGE_SIZE - 1) / EEPROM_AT24CXX_PAGE_SIZE;
+    for(i = 0; i < EEPROM_AT24CXX_FS_MAX_EXTENTS; i++)
+    {
+        if(pages >= keep)
+        {
+            for(page = 0; page < entry->extent_len[i]; page++)
+            {
+                _EEPROM_AT24CXX_FS_SET(fs->pending_free, entry->extent_start[i] + page);
+            }
+            entry->extent_len[i] = 0;
+        }
+        else if(pages + entry->extent_len[i] > keep)
+        {
+            for(page = keep - pages; page < entry->extent_len[i]; page++)
+            {
+                _EEPROM_AT24CXX_FS_SET(fs->pending_free, entry->extent_start[i] + page);
+            }
+            entry->extent_len[i] = (uint8_t)(keep - pages);
+        }
+        pages += entry->extent_len[i];
+    }
+
+    entry->size = size;
+    entry->dirty = 1;
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_FSDelete(EEPROM_AT24CXX_FS* fs, int8_t id)
+{
+    //REMOVE BLOB (STORED BY THE NEXT Sync)
+
+    if(!EEPROM_AT24CXX_FSTruncate(fs, id, 0))
+    {
+        return 0;
+    }
+    fs->entry[id].used = 0;
+    _eeprom_at24cxx_fs_index_rebuild(fs);
+    return 1;
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_FSGetSize(EEPROM_AT24CXX_FS* fs, int8_t id)
+{
+    //RETURN BLOB SIZE IN BYTES (0 FOR AN INVALID ID)
+
+    EEPROM_AT24CXX_FS_ENTRY* entry = _eeprom_at24cxx_fs_get(fs, id);
+
+    return (entry != NULL) ? entry->size : 0;
+}
+
+uint16_t PUTINFLASH EEPROM_AT24CXX_FSGetFreePages(EEPROM_AT24CXX_FS* fs)
+{
+    //RETURN NUMBER OF DATA PAGES AN Append CAN TAKE RIGHT NOW
+
+    uint16_t count = 0;
+    uint16_t page;
+
+    for(page = fs->file_count + 1; page < fs->page_count; page++)
+    {
+        if(!_EEPROM_AT24CXX_FS_BIT(fs->bitmap, page))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_FSSync(EEPROM_AT24CXX_FS* fs)
+{
+    //STORE CHANGED DIRECTORY ENTRIES (ONE PAGE WRITE EACH) AFTER ALL
+    //DATA IS DURABLE, THEN RELEASE PAGES FREED SINCE THE LAST Sync
+    //ON A FAILED TRANSFER NOTHING IS MARKED CLEAN OR RELEASED
+
+    uint8_t page_data[EEPROM_AT24CXX_PAGE_SIZE];
+    uint16_t i;
+
+    if(EEPROM_AT24CXX_DeviceFlush(fs->device) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+    for(i = 0; i < fs->file_count; i++)
+    {
+        if(!fs->entry[i].dirty)
+        {
+            continue;
+        }
+        if(fs->entry[i].used)
+        {
+            _eeprom_at24cxx_fs_encode(&fs->entry[i], page_data);
+        }
+        else
+        {
+            memset(page_data, 0xFF, EEPROM_AT24CXX_PAGE_SIZE);
+        }
+        if(EEPROM_AT24CXX_DeviceWriteBlock(fs->device, _eeprom_at24cxx_fs_page_address(fs, i + 1), ADDRESS_TYPE_BYTE, page_data, EEPROM_AT24CXX_PAGE_SIZE) != EEPROM_STATUS_OK)
+        {
+            return 0;
+        }
+    }
+    if(EEPROM_AT24CXX_DeviceFlush(fs->device) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+
+    for(i = 0; i < fs->file_count; i++)
+    {
+        fs->entry[i].dirty = 0;
+        fs->entry[i].shared_size = fs->entry[i].size;
+    }
+
+    for(i = 0; i < sizeof(fs->bitmap); i++)
+    {
+        fs->bitmap[i] &= ~fs->pending_free[i];
+        fs->pending_free[i] = 0;
+    }
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_fs_setup(EEPROM_AT24CXX_FS* fs, EEPROM_AT24CXX_DEVICE* device, uint16_t first_page, uint16_t page_count, uint8_t file_count)
+{
+    //VALIDATE REGION AND RESET RAM STATE
+
+    uint16_t page;
+
+    if(file_count == 0 || file_count > EEPROM_AT24CXX_FS_MAX_FILES ||
+        page_count <= (uint16_t)file_count + 1 || page_count > EEPROM_AT24CXX_FS_MAX_PAGES ||
+        (uint32_t)first_page + page_count > EEPROM_AT24CXX_DeviceGetSize(device) / EEPROM_AT24CXX_PAGE_SIZE)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : FS : Invalid region !\n");
+        return 0;
+    }
+
+    fs->device = device;
+    fs->first_page = first_page;
+    fs->page_count = page_count;
+    fs->file_count = file_count;
+    memset(fs->entry, 0, sizeof(fs->entry));
+    memset(fs->index, 0, sizeof(fs->index));
+    memset(fs->bitmap, 0, sizeof(fs->bitmap));
+    memset(fs->pending_free, 0, sizeof(fs->pending_free));
+
+    //SUPER AND DIRECTORY PAGES ARE NEVER ALLOCATED
+    for(page = 0; page <= file_count; page++)
+    {
+        _EEPROM_AT24CXX_FS_SET(fs->bitmap, page);
+    }
+    return 1;
+}
+
+static uint32_t PUTINFLASH _eeprom_at24cxx_fs_page_address(EEPROM_AT24CXX_FS* fs, uint16_t page)
+{
+    //REGION PAGE TO DEVICE BYTE ADDRESS
+
+    return EEPROM_GET_BYTE_ADDRESS_FROM_PAGE((uint32_t)fs->first_page + page);
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_fs_hash(const char* name)
+{
+    //FNV-1a OF THE NAME, REDUCED TO AN INDEX SLOT
+
+    uint32_t hash = 2166136261UL;
+    uint8_t i;
+
+    for(i = 0; i < EEPROM_AT24CXX_FS_NAME_LEN && name[i] != '\0'; i++)
+    {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619UL;
+    }
+    return (uint8_t)(hash % _EEPROM_AT24CXX_FS_INDEX_SLOTS);
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_fs_name_equal(EEPROM_AT24CXX_FS_ENTRY* entry, const char* name)
+{
+    //RETURN 1 IF entry IS NAMED name
+
+    return (strncmp(entry->name, name, EEPROM_AT24CXX_FS_NAME_LEN) == 0);
+}
+
+static int8_t PUTINFLASH _eeprom_at24cxx_fs_find(EEPROM_AT24CXX_FS* fs, const char* name)
+{
+    //PROBE THE RAM HASH INDEX, RETURN BLOB ID OR -1
+
+    uint8_t slot;
+    uint8_t n;
+
+    slot = _eeprom_at24cxx_fs_hash(name);
+    for(n = 0; n < _EEPROM_AT24CXX_FS_INDEX_SLOTS; n++)
+    {
+        if(fs->index[slot] == 0)
+        {
+            return -1;
+        }
+        if(_eeprom_at24cxx_fs_name_equal(&fs->entry[fs->index[slot] - 1], name))
+        {
+            return (int8_t)(fs->index[slot] - 1);
+        }
+        slot = (slot + 1) % _EEPROM_AT24CXX_FS_INDEX_SLOTS;
+    }
+    return -1;
+}
+
+static void PUTINFLASH _eeprom_at24cxx_fs_index_rebuild(EEPROM_AT24CXX_FS* fs)
+{
+    //REBUILD THE NAME HASH INDEX FROM THE RAM DIRECTORY
+    //(OPEN ADDRESSING, LINEAR PROBING, HALF FULL AT MOST)
+
+    uint8_t slot;
+    uint8_t i;
+
+    memset(fs->index, 0, sizeof(fs->index));
+    for(i = 0; i < fs->file_count; i++)
+    {
+        if(!fs->entry[i].used)
+        {
+            continue;
+        }
+        slot = _eeprom_at24cxx_fs_hash(fs->entry[i].name);
+        while(fs->index[slot] != 0)
+        {
+            slot = (slot + 1) % _EEPROM_AT24CXX_FS_INDEX_SLOTS;
+        }
+        fs->index[slot] = i + 1;
+    }
+}
+
+static EEPROM_AT24CXX_FS_ENTRY* PUTINFLASH _eeprom_at24cxx_fs_get(EEPROM_AT24CXX_FS* fs, int8_t id)
+{
+    //RETURN ENTRY OF AN OPEN BLOB ID, NULL IF INVALID
+
+    if(id < 0 || id >= fs->file_count || !fs->entry[id].used)
+    {
+        return NULL;
+    }
+    return &fs->entry[id];
+}
+
+static uint16_t PUTINFLASH _eeprom_at24cxx_fs_map(EEPROM_AT24CXX_FS_ENTRY* entry, uint32_t page, uint16_t* run)
+{
+    //BLOB PAGE TO REGION PAGE (0 = NOT ALLOCATED)
+    //run (OPTIONAL) RECEIVES THE NUMBER OF CONTIGUOUS PAGES FROM THERE
+
+    uint8_t i;
+
+    for(i = 0; i < EEPROM_AT24CXX_FS_MAX_EXTENTS; i++)
+    {
+        if(page < entry->extent_len[i])
+        {
+            if(run != NULL)
+            {
+                *run = entry->extent_len[i] - (uint16_t)page;
+            }
+            return entry->extent_start[i] + (uint16_t)page;
+        }
+        page -= entry->extent_len[i];
+    }
+    return 0;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_fs_alloc(EEPROM_AT24CXX_FS* fs, EEPROM_AT24CXX_FS_ENTRY* entry)
+{
+    //ADD ONE PAGE AT THE END OF THE BLOB
+    //GROW THE LAST EXTENT IF THE NEXT PAGE IS FREE, ELSE START A NEW ONE
+    //AT THE FIRST FREE PAGE
+
+    uint16_t page;
+    int8_t last = -1;
+    uint8_t i;
+
+    for(i = 0; i < EEPROM_AT24CXX_FS_MAX_EXTENTS; i++)
+    {
+        if(entry->extent_len[i] != 0)
+        {
+            last = (int8_t)i;
+        }
+    }
+
+    if(last >= 0 && entry->extent_len[last] < 255)
+    {
+        page = entry->extent_start[last] + entry->extent_len[last];
+        if(page < fs->page_count && !_EEPROM_AT24CXX_FS_BIT(fs->bitmap, page))
+        {
+            _EEPROM_AT24CXX_FS_SET(fs->bitmap, page);
+            entry->extent_len[last]++;
+            return 1;
+        }
+    }
+
+    if(last + 1 >= EEPROM_AT24CXX_FS_MAX_EXTENTS)
+    {
+        return 0;
+    }
+    for(page = fs->file_count + 1; page < fs->page_count; page++)
+    {
+        if(!_EEPROM_AT24CXX_FS_BIT(fs->bitmap, page))
+        {
+            _EEPROM_AT24CXX_FS_SET(fs->bitmap, page);
+            entry->extent_start[last + 1] = page;
+            entry->extent_len[last + 1] = 1;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_fs_unshare_tail(EEPROM_AT24CXX_FS* fs, EEPROM_AT24CXX_FS_ENTRY* entry)
+{
+    //MOVE THE KEPT PART OF A PARTLY USED TAIL PAGE TO A NEW PAGE BEFORE
+    //Append WRITES OVER BYTES THE LAST Sync STILL COUNTS AS DATA
+    //THE OLD PAGE IS FREED BY THE NEXT Sync LIKE A TRUNCATED ONE
+    //RETURN 0 (NOTHING CHANGED) IF THERE IS NO SPACE OR A TRANSFER FAILED
+
+    uint8_t page_data[EEPROM_AT24CXX_PAGE_SIZE];
+    uint16_t extent_start[EEPROM_AT24CXX_FS_MAX_EXTENTS];
+    uint8_t extent_len[EEPROM_AT24CXX_FS_MAX_EXTENTS];
+    uint32_t kept = entry->size % EEPROM_AT24CXX_PAGE_SIZE;
+    uint16_t old_page;
+    uint16_t new_page;
+    int8_t last = -1;
+    uint8_t i;
+
+    old_page = _eeprom_at24cxx_fs_map(entry, entry->size / EEPROM_AT24CXX_PAGE_SIZE, NULL);
+    if(old_page == 0 ||
+        EEPROM_AT24CXX_DeviceReadBlock(fs->device, _eeprom_at24cxx_fs_page_address(fs, old_page), ADDRESS_TYPE_BYTE, page_data, kept) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+
+    //TAIL PAGE IS THE LAST PAGE OF THE LAST EXTENT (Truncate DROPS THE REST)
+    memcpy(extent_start, entry->extent_start, sizeof(extent_start));
+    memcpy(extent_len, entry->extent_len, sizeof(extent_len));
+    for(i = 0; i < EEPROM_AT24CXX_FS_MAX_EXTENTS; i++)
+    {
+        if(entry->extent_len[i] != 0)
+        {
+            last = (int8_t)i;
+        }
+    }
+    entry->extent_len[last]--;
+
+    if(!_eeprom_at24cxx_fs_alloc(fs, entry))
+    {
+        memcpy(entry->extent_start, extent_start, sizeof(extent_start));
+        memcpy(entry->extent_len, extent_len, sizeof(extent_len));
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : FS : no space !\n");
+        return 0;
+    }
+    new_page = _eeprom_at24cxx_fs_map(entry, entry->size / EEPROM_AT24CXX_PAGE_SIZE, NULL);
+    if(EEPROM_AT24CXX_DeviceWriteBlock(fs->device, _eeprom_at24cxx_fs_page_address(fs, new_page), ADDRESS_TYPE_BYTE, page_data, kept) != EEPROM_STATUS_OK)
+    {
+        _EEPROM_AT24CXX_FS_CLEAR(fs->bitmap, new_page);
+        memcpy(entry->extent_start, extent_start, sizeof(extent_start));
+        memcpy(entry->extent_len, extent_len, sizeof(extent_len));
+        return 0;
+    }
+
+    _EEPROM_AT24CXX_FS_SET(fs->pending_free, old_page);
+    entry->shared_size = entry->size;
+    entry->dirty = 1;
+    return 1;
+}
+
+static void PUTINFLASH _eeprom_at24cxx_fs_encode(EEPROM_AT24CXX_FS_ENTRY* entry, uint8_t* page_data)
+{
+    //RAM ENTRY TO DIRECTORY PAGE
+
+    uint8_t* extent;
+    uint8_t i;
+
+    memset(page_data, 0xFF, EEPROM_AT24CXX_PAGE_SIZE);
+    memcpy(page_data, entry->name, EEPROM_AT24CXX_FS_NAME_LEN);
+    page_data[EEPROM_AT24CXX_FS_NAME_LEN + 0] = (uint8_t)(entry->size >> 24);
+    page_data[EEPROM_AT24CXX_FS_NAME_LEN + 1] = (uint8_t)(entry->size >> 16);
+    page_data[EEPROM_AT24CXX_FS_NAME_LEN + 2] = (uint8_t)(entry->size >> 8);
+    page_data[EEPROM_AT24CXX_FS_NAME_LEN + 3] = (uint8_t)entry->size;
+    for(i = 0; i < EEPROM_AT24CXX_FS_MAX_EXTENTS; i++)
+    {
+        extent = &page_data[_EEPROM_AT24CXX_FS_EXTENT_OFFSET + i * 3];
+        extent[0] = (uint8_t)(entry->extent_start[i] >> 8);
+        extent[1] = (uint8_t)entry->extent_start[i];
+        extent[2] = entry->extent_len[i];
+    }
+    page_data[_EEPROM_AT24CXX_FS_CRC_OFFSET] = (uint8_t)EEPROM_AT24CXX_Crc32(0, page_data, _EEPROM_AT24CXX_FS_CRC_OFFSET);
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_fs_decode(EEPROM_AT24CXX_FS* fs, EEPROM_AT24CXX_FS_ENTRY* entry, uint8_t* page_data)
+{
+    //DIRECTORY PAGE TO RAM ENTRY, MARKING ITS PAGES IN THE BITMAP
+    //A FREE OR TORN ENTRY LOADS AS UNUSED
+    //RETURN 0 IF THE ENTRY CLAIMS PAGES OUTSIDE THE DATA AREA OR
+    //ALREADY CLAIMED (STORE IS CORRUPT)
+
+    uint8_t* extent;
+    uint32_t pages = 0;
+    uint16_t page;
+    uint8_t i;
+
+    memset(entry, 0, sizeof(EEPROM_AT24CXX_FS_ENTRY));
+    if(page_data[0] == 0xFF)
+    {
+        return 1;
+    }
+    if((uint8_t)EEPROM_AT24CXX_Crc32(0, page_data, _EEPROM_AT24CXX_FS_CRC_OFFSET) != page_data[_EEPROM_AT24CXX_FS_CRC_OFFSET])
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : FS : torn directory entry dropped !\n");
+        return 1;
+    }
+
+    memcpy(entry->name, page_data, EEPROM_AT24CXX_FS_NAME_LEN);
+    entry->size = ((uint32_t)page_data[EEPROM_AT24CXX_FS_NAME_LEN] << 24) |
+                    ((uint32_t)page_data[EEPROM_AT24CXX_FS_NAME_LEN + 1] << 16) |
+                    ((uint32_t)page_data[EEPROM_AT24CXX_FS_NAME_LEN + 2] << 8) |
+                    page_data[EEPROM_AT24CXX_FS_NAME_LEN + 3];
+    for(i = 0; i < EEPROM_AT24CXX_FS_MAX_EXTENTS; i++)
+    {
+        extent = &page_data[_EEPROM_AT24CXX_FS_EXTENT_OFFSET + i * 3];
+        entry->extent_start[i] = ((uint16_t)extent[0] << 8) | extent[1];
+        entry->extent_len[i] = extent[2];
+        for(page = entry->extent_start[i]; page < entry->extent_start[i] + entry->extent_len[i]; page++)
+        {
+            if(page <= fs->file_count || page >= fs->page_count || _EEPROM_AT24CXX_FS_BIT(fs->bitmap, page))
+            {
+                EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : FS : corrupt extent !\n");
+                return 0;
+            }
+            _EEPROM_AT24CXX_FS_SET(fs->bitmap, page);
+        }
+        pages += entry->extent_len[i];
+    }
+    if(entry->size > pages * EEPROM_AT24CXX_PAGE_SIZE)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : FS : corrupt size !\n");
+        return 0;
+    }
+    entry->shared_size = entry->size;
+    entry->used = 1;
+    return 1;
+}
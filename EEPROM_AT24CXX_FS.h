@@ -0,0 +1,114 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* NAMED BLOB STORE
+*
+* NOTE
+* -------
+*   (1) BLOBS ARE LOOKED UP BY NAME (UP TO EEPROM_AT24CXX_FS_NAME_LEN
+*       BYTES) AND GROW BY Append, SO NOTHING HAS A FIXED OFFSET AND
+*       RESIZING NEEDS NO LAYOUT CHANGE
+*
+*   (2) LAYOUT (REGION RELATIVE, ONE EEPROM_AT24CXX_PAGE_SIZE PAGE EACH)
+*       PAGE 0          : SUPER  [MAGIC "FS" 2][VERSION 1][PAGES 2]
+*                                [FILES 1][CRC32 4]
+*       PAGE 1 ... F    : DIRECTORY, ONE ENTRY PER PAGE
+*                         [NAME 12][SIZE 4][EXTENT (START 2, LEN 1) x 5]
+*                         [CRC8 1], ALL 0xFF = FREE
+*       PAGE F + 1 ...  : DATA, ALLOCATED A PAGE AT A TIME
+*       A BLOB IS UP TO EEPROM_AT24CXX_FS_MAX_EXTENTS RUNS OF PAGES.
+*       BLOB OFFSET n IS AT OFFSET n % PAGE_SIZE OF ITS PAGE, SO AN
+*       APPEND THAT STAYS IN ONE PAGE IS ONE PAGE WRITE
+*
+*   (3) Mount READS THE SUPER AND DIRECTORY PAGES ONCE AND BUILDS THE
+*       RAM DIRECTORY (NAME HASH INDEX) AND THE PAGE ALLOCATION BITMAP
+*       FROM THE EXTENTS. Open / LOOKUP / ALLOCATION NEVER TOUCH THE
+*       EEPROM, DATA PAGES ARE NEVER SCANNED
+*
+*   (4) DIRECTORY CHANGES (CREATE, SIZE, EXTENTS, DELETE) STAY IN RAM
+*       TILL Sync, WHICH WRITES ONE PAGE PER CHANGED ENTRY. PAGES FREED
+*       BY Truncate / Delete ARE ONLY REUSED AFTER Sync. AN Append BELOW
+*       THE SYNCED SIZE (AFTER A Truncate INSIDE A PAGE) FIRST COPIES
+*       THE KEPT PART OF THE TAIL PAGE TO A NEW PAGE, SO A RESET AT ANY
+*       POINT LEAVES THE STATE OF THE LAST Sync INTACT
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#ifndef _EEPROM_AT24CXX_FS_H_
+#define _EEPROM_AT24CXX_FS_H_
+
+#include "EEPROM_AT24CXX.h"
+
+//LARGEST REGION IN PAGES (SIZES THE RAM BITMAPS, 256 = WHOLE AT24C64)
+#ifndef EEPROM_AT24CXX_FS_MAX_PAGES
+  #define EEPROM_AT24CXX_FS_MAX_PAGES         256
+#endif
+
+//MAXIMUM NUMBER OF BLOBS (DIRECTORY ENTRIES HELD IN RAM)
+#ifndef EEPROM_AT24CXX_FS_MAX_FILES
+  #define EEPROM_AT24CXX_FS_MAX_FILES         16
+#endif
+#if (EEPROM_AT24CXX_FS_MAX_FILES > 127)
+  #error "EEPROM : AT24CXX : FS : too many files"
+#endif
+
+#define EEPROM_AT24CXX_FS_NAME_LEN            12
+#define EEPROM_AT24CXX_FS_MAX_EXTENTS         5
+#define EEPROM_AT24CXX_FS_VERSION             1
+
+//CUSTOM VARIABLE STRUCTURES/////////////////////////////
+typedef struct
+{
+    uint8_t used;
+    uint8_t dirty;          //CHANGED SINCE LAST Sync
+    char name[EEPROM_AT24CXX_FS_NAME_LEN];    //NUL PADDED
+    uint32_t size;
+    uint32_t shared_size;   //TAIL PAGE BYTES BELOW THIS BELONG TO THE LAST Sync
+    uint16_t extent_start[EEPROM_AT24CXX_FS_MAX_EXTENTS];    //REGION PAGE
+    uint8_t extent_len[EEPROM_AT24CXX_FS_MAX_EXTENTS];       //0 = UNUSED
+} EEPROM_AT24CXX_FS_ENTRY;
+
+typedef struct
+{
+    EEPROM_AT24CXX_DEVICE* device;
+    uint16_t first_page;    //REGION START (DEVICE PAGE)
+    uint16_t page_count;    //REGION LENGTH IN PAGES
+    uint8_t file_count;     //DIRECTORY ENTRIES
+
+    //RAM DIRECTORY
+    EEPROM_AT24CXX_FS_ENTRY entry[EEPROM_AT24CXX_FS_MAX_FILES];
+    uint8_t index[EEPROM_AT24CXX_FS_MAX_FILES * 2];     //NAME HASH -> ENTRY + 1
+
+    //PAGE ALLOCATION
+    uint8_t bitmap[(EEPROM_AT24CXX_FS_MAX_PAGES + 7) / 8];        //IN USE
+    uint8_t pending_free[(EEPROM_AT24CXX_FS_MAX_PAGES + 7) / 8];  //FREED, NOT SYNCED
+} EEPROM_AT24CXX_FS;
+//END CUSTOM VARIABLE STRUCTURES/////////////////////////
+
+//FUNCTION PROTOTYPES/////////////////////////////////////
+//REGION IS page_count PAGES FROM first_page, file_count OF THEM HOLD
+//THE DIRECTORY. name IS A NUL TERMINATED STRING. Open RETURNS A BLOB
+//ID (-1 = NOT FOUND / NO ROOM), Read RETURNS BYTES READ, GetSize THE
+//BLOB SIZE. OTHERS RETURN 1 ON SUCCESS, 0 ON FAILURE. A FAILED TRANSFER
+//STOPS THE CALL (Read RETURNS SHORT), SEE DeviceGetLastStatus. AFTER A
+//FAILED Append OR Sync, Mount AGAIN TO GO BACK TO THE LAST Sync
+uint8_t PUTINFLASH EEPROM_AT24CXX_FSFormat(EEPROM_AT24CXX_FS* fs,
+                                            EEPROM_AT24CXX_DEVICE* device,
+                                            uint16_t first_page,
+                                            uint16_t page_count,
+                                            uint8_t file_count);
+uint8_t PUTINFLASH EEPROM_AT24CXX_FSMount(EEPROM_AT24CXX_FS* fs, EEPROM_AT24CXX_DEVICE* device, uint16_t first_page);
+int8_t PUTINFLASH EEPROM_AT24CXX_FSOpen(EEPROM_AT24CXX_FS* fs, const char* name, uint8_t create);
+uint8_t PUTINFLASH EEPROM_AT24CXX_FSAppend(EEPROM_AT24CXX_FS* fs, int8_t id, uint8_t* data, uint32_t len);
+uint32_t PUTINFLASH EEPROM_AT24CXX_FSRead(EEPROM_AT24CXX_FS* fs, int8_t id, uint32_t offset, uint8_t* data, uint32_t len);
+uint8_t PUTINFLASH EEPROM_AT24CXX_FSTruncate(EEPROM_AT24CXX_FS* fs, int8_t id, uint32_t size);
+uint8_t PUTINFLASH EEPROM_AT24CXX_FSDelete(EEPROM_AT24CXX_FS* fs, int8_t id);
+uint32_t PUTINFLASH EEPROM_AT24CXX_FSGetSize(EEPROM_AT24CXX_FS* fs, int8_t id);
+uint16_t PUTINFLASH EEPROM_AT24CXX_FSGetFreePages(EEPROM_AT24CXX_FS* fs);
+uint8_t PUTINFLASH EEPROM_AT24CXX_FSSync(EEPROM_AT24CXX_FS* fs);
+//END FUNCTION PROTOTYPES/////////////////////////////////
+#endif
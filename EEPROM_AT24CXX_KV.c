@@ -0,0 +1,651 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* WEAR LEVELING KEY / VALUE STORE
+*
+* NOTE
+* -------
+*   (1) LOG STRUCTURED : EVERY PUT APPENDS A RECORD AT THE LOG HEAD,
+*       SO REWRITING THE SAME KEY MOVES ACROSS THE WHOLE REGION
+*       INSTEAD OF WEARING OUT ONE LOCATION
+*
+*   (2) LAYOUT (ONE EEPROM PAGE AT A TIME)
+*       PAGE   : [SEQ 4][SPAN 2][CRC8 1][RECORD][RECORD]...[0xFF..]
+*       RECORD : [KEY 2][LEN 1][CRC8 1][VALUE LEN]
+*       SPAN IS THE NUMBER OF LOG PAGES (TAIL TO THIS PAGE) WHEN THE PAGE
+*       WAS OPENED. Mount WALKS BACK FROM THE HEAD NO FURTHER, SO PAGES
+*       RECLAIMED BEFORE THAT ARE NOT TAKEN AS PART OF THE LOG
+*       A PAGE IS OPENED WITH ONE FULL PAGE WRITE (HEADER, FIRST
+*       RECORD, REST 0xFF), FURTHER RECORDS ARE APPENDED INTO THE 0xFF
+*       AREA. A RECORD NEVER SPANS TWO PAGES. LEN 0 DELETES THE KEY
+*
+*   (3) THE OLDEST PAGE IS RECLAIMED (LIVE RECORDS COPIED TO THE HEAD)
+*       WHEN FEWER THAN EEPROM_AT24CXX_KV_RESERVE_PAGES ARE FREE
+*
+*   (4) LOOKUPS GO THROUGH A RAM HASH INDEX REBUILT BY Mount, SO A Get
+*       IS ONE EEPROM READ. INDEX SIZE IS FIXED AT COMPILE TIME
+*
+*   (5) WITH THE PAGE CACHE ON, CALL EEPROM_AT24CXX_DeviceFlush TO
+*       MAKE PUTS DURABLE. A FAILED Flush DROPS THE PAGES IT COULD NOT
+*       WRITE, Mount AGAIN THEN TO REBUILD THE INDEX FROM THE EEPROM
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#include "EEPROM_AT24CXX_KV.h"
+
+#define _EEPROM_AT24CXX_KV_INDEX_SIZE   (EEPROM_AT24CXX_KV_MAX_KEYS * 2)
+
+//INTERNAL FUNCTIONS//////////////////////////////////////////
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_crc8(uint8_t crc, uint8_t* data, uint8_t len);
+static uint32_t PUTINFLASH _eeprom_at24cxx_kv_page_address(EEPROM_AT24CXX_KV* kv, uint16_t page);
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_setup(EEPROM_AT24CXX_KV* kv, EEPROM_AT24CXX_DEVICE* device, uint16_t first_page, uint16_t page_count);
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_read_header(EEPROM_AT24CXX_KV* kv, uint16_t page, uint32_t* seq, uint16_t* span);
+static uint16_t PUTINFLASH _eeprom_at24cxx_kv_hash(uint16_t key);
+static EEPROM_AT24CXX_KV_ENTRY* PUTINFLASH _eeprom_at24cxx_kv_find(EEPROM_AT24CXX_KV* kv, uint16_t key);
+static EEPROM_AT24CXX_KV_ENTRY* PUTINFLASH _eeprom_at24cxx_kv_insert(EEPROM_AT24CXX_KV* kv, uint16_t key);
+static void PUTINFLASH _eeprom_at24cxx_kv_remove(EEPROM_AT24CXX_KV* kv, EEPROM_AT24CXX_KV_ENTRY* entry);
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_append(EEPROM_AT24CXX_KV* kv, uint16_t key, uint8_t* value, uint8_t len, uint16_t* page, uint8_t* offset);
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_make_room(EEPROM_AT24CXX_KV* kv);
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_gc_tail(EEPROM_AT24CXX_KV* kv);
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_page_live(EEPROM_AT24CXX_KV* kv, uint16_t page);
+//END INTERNAL FUNCTIONS//////////////////////////////////////
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_KVFormat(EEPROM_AT24CXX_KV* kv,
+                                            EEPROM_AT24CXX_DEVICE* device,
+                                            uint16_t first_page,
+                                            uint16_t page_count)
+{
+    //ERASE REGION (ALL 0xFF) AND LEAVE AN EMPTY MOUNTED STORE
+
+    uint8_t page_data[EEPROM_AT24CXX_PAGE_SIZE];
+    uint16_t i;
+
+    if(!_eeprom_at24cxx_kv_setup(kv, device, first_page, page_count))
+    {
+        return 0;
+    }
+
+    for(i = 0; i < EEPROM_AT24CXX_PAGE_SIZE; i++)
+    {
+        page_data[i] = 0xFF;
+    }
+    for(i = 0; i < kv->page_count; i++)
+    {
+        if(EEPROM_AT24CXX_DeviceWriteBlock(kv->device, _eeprom_at24cxx_kv_page_address(kv, i), ADDRESS_TYPE_BYTE, page_data, EEPROM_AT24CXX_PAGE_SIZE) != EEPROM_STATUS_OK)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_KVMount(EEPROM_AT24CXX_KV* kv,
+                                            EEPROM_AT24CXX_DEVICE* device,
+                                            uint16_t first_page,
+                                            uint16_t page_count)
+{
+    //FIND LOG HEAD (HIGHEST PAGE SEQUENCE), WALK BACK TO THE TAIL AND
+    //REPLAY ALL RECORDS OLDEST FIRST TO REBUILD THE RAM INDEX
+
+    uint8_t page_data[EEPROM_AT24CXX_PAGE_SIZE];
+    EEPROM_AT24CXX_KV_ENTRY* entry;
+    uint32_t seq;
+    uint16_t page;
+    uint16_t prev;
+    uint16_t span;
+    uint16_t head_span = 0;
+    uint16_t n;
+    uint16_t key;
+    uint8_t offset;
+    uint8_t len;
+    uint8_t found = 0;
+
+    if(!_eeprom_at24cxx_kv_setup(kv, device, first_page, page_count))
+    {
+        return 0;
+    }
+
+    for(page = 0; page < kv->page_count; page++)
+    {
+        if(_eeprom_at24cxx_kv_read_header(kv, page, &seq, &span) && (!found || seq > kv->head_seq))
+        {
+            kv->head = page;
+            kv->head_seq = seq;
+            head_span = span;
+            found = 1;
+        }
+        if(EEPROM_AT24CXX_DeviceGetLastStatus(kv->device) != EEPROM_STATUS_OK)
+        {
+            return 0;
+        }
+    }
+    if(!found)
+    {
+        //EMPTY STORE
+        return 1;
+    }
+
+    //LOG PAGES HAVE CONSECUTIVE SEQUENCE NUMBERS BACK FROM THE HEAD.
+    //RECLAIMED PAGES KEEP THEIRS TILL OVERWRITTEN, SO STOP AT THE SPAN
+    //RECORDED IN THE HEAD
+    page = kv->head;
+    for(n = 1; n < head_span && n < kv->page_count; n++)
+    {
+        prev = (page == 0) ? (kv->page_count - 1) : (page - 1);
+        if(!_eeprom_at24cxx_kv_read_header(kv, prev, &seq, NULL) || seq != kv->head_seq - n)
+        {
+            if(EEPROM_AT24CXX_DeviceGetLastStatus(kv->device) != EEPROM_STATUS_OK)
+            {
+                return 0;
+            }
+            break;
+        }
+        page = prev;
+    }
+    kv->tail = page;
+    kv->used_pages = n;
+
+    //REPLAY
+    for(n = 0; n < kv->used_pages; n++)
+    {
+        page = (kv->tail + n) % kv->page_count;
+        if(EEPROM_AT24CXX_DeviceReadBlock(kv->device, _eeprom_at24cxx_kv_page_address(kv, page), ADDRESS_TYPE_BYTE, page_data, EEPROM_AT24CXX_PAGE_SIZE) != EEPROM_STATUS_OK)
+        {
+            return 0;
+        }
+
+        offset = EEPROM_AT24CXX_KV_PAGE_HEADER_SIZE;
+        while(offset + EEPROM_AT24CXX_KV_RECORD_HEADER_SIZE <= EEPROM_AT24CXX_PAGE_SIZE)
+        {
+            key = ((uint16_t)page_data[offset] << 8) | page_data[offset + 1];
+            len = page_data[offset + 2];
+            if(key == EEPROM_AT24CXX_KV_KEY_EMPTY)
+            {
+                break;
+            }
+            if(offset + EEPROM_AT24CXX_KV_RECORD_HEADER_SIZE + len > EEPROM_AT24CXX_PAGE_SIZE ||
+                _eeprom_at24cxx_kv_crc8(_eeprom_at24cxx_kv_crc8(0, &page_data[offset], 3),
+                                        &page_data[offset + EEPROM_AT24CXX_KV_RECORD_HEADER_SIZE],
+                                        len) != page_data[offset + 3])
+            {
+                //TORN APPEND (POWER LOSS). NOTHING AFTER IT IS TRUSTED
+                //AND NO MORE APPENDS GO INTO THIS PAGE
+                offset = EEPROM_AT24CXX_PAGE_SIZE;
+                break;
+            }
+
+            if(len == 0)
+            {
+                entry = _eeprom_at24cxx_kv_find(kv, key);
+                if(entry != NULL)
+                {
+                    _eeprom_at24cxx_kv_remove(kv, entry);
+                }
+            }
+            else
+            {
+                entry = _eeprom_at24cxx_kv_insert(kv, key);
+                if(entry == NULL)
+                {
+                    EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : KV : index full !\n");
+                    return 0;
+                }
+                entry->page = page;
+                entry->offset = offset;
+                entry->len = len;
+            }
+            offset += EEPROM_AT24CXX_KV_RECORD_HEADER_SIZE + len;
+        }
+        kv->head_offset = offset;
+    }
+
+    //A GC AFTER THE HEAD WAS OPENED (Compact) IS NOT IN ITS SPAN. OLDEST
+    //PAGES NO LIVE KEY POINTS INTO ARE DROPPED, SAME AS A GC WOULD
+    while(kv->used_pages > 1 && !_eeprom_at24cxx_kv_page_live(kv, kv->tail))
+    {
+        kv->tail = (kv->tail + 1) % kv->page_count;
+        kv->used_pages--;
+    }
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_KVPut(EEPROM_AT24CXX_KV* kv, uint16_t key, uint8_t* value, uint8_t len)
+{
+    //STORE VALUE (1 .. EEPROM_AT24CXX_KV_MAX_VALUE_LEN BYTES) FOR KEY
+    //RETURN 0 IF KEY / LENGTH IS INVALID, INDEX IS FULL OR THERE IS
+    //NO ROOM LEFT AFTER RECLAIMING PAGES
+
+    EEPROM_AT24CXX_KV_ENTRY* entry;
+    uint16_t page;
+    uint8_t offset;
+
+    if(key == EEPROM_AT24CXX_KV_KEY_EMPTY || len == 0 || len > EEPROM_AT24CXX_KV_MAX_VALUE_LEN)
+    {
+        return 0;
+    }
+
+    if(_eeprom_at24cxx_kv_find(kv, key) == NULL && kv->key_count >= EEPROM_AT24CXX_KV_MAX_KEYS)
+    {
+        return 0;
+    }
+
+    if(!_eeprom_at24cxx_kv_append(kv, key, value, len, &page, &offset))
+    {
+        return 0;
+    }
+
+    //LOOK UP AGAIN, RECLAIMING MAY HAVE MOVED INDEX ENTRIES
+    entry = _eeprom_at24cxx_kv_insert(kv, key);
+    entry->page = page;
+    entry->offset = offset;
+    entry->len = len;
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_KVGet(EEPROM_AT24CXX_KV* kv, uint16_t key, uint8_t* value, uint8_t max_len)
+{
+    //COPY UP TO max_len BYTES OF THE VALUE OF KEY INTO value
+    //RETURN STORED VALUE LENGTH, 0 IF KEY IS NOT FOUND
+
+    EEPROM_AT24CXX_KV_ENTRY* entry;
+    uint8_t len;
+
+    entry = _eeprom_at24cxx_kv_find(kv, key);
+    if(entry == NULL)
+    {
+        return 0;
+    }
+
+    len = (entry->len < max_len) ? entry->len : max_len;
+    if(len > 0 &&
+        EEPROM_AT24CXX_DeviceReadBlock(kv->device,
+                                        _eeprom_at24cxx_kv_page_address(kv, entry->page) + entry->offset + EEPROM_AT24CXX_KV_RECORD_HEADER_SIZE,
+                                        ADDRESS_TYPE_BYTE,
+                                        value,
+                                        len) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+    return entry->len;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_KVDelete(EEPROM_AT24CXX_KV* kv, uint16_t key)
+{
+    //APPEND A DELETE RECORD FOR KEY
+    //RETURN 0 IF KEY IS NOT FOUND OR THERE IS NO ROOM
+
+    EEPROM_AT24CXX_KV_ENTRY* entry;
+    uint16_t page;
+    uint8_t offset;
+
+    if(_eeprom_at24cxx_kv_find(kv, key) == NULL)
+    {
+        return 0;
+    }
+
+    if(!_eeprom_at24cxx_kv_append(kv, key, NULL, 0, &page, &offset))
+    {
+        return 0;
+    }
+
+    entry = _eeprom_at24cxx_kv_find(kv, key);
+    _eeprom_at24cxx_kv_remove(kv, entry);
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_KVCompact(EEPROM_AT24CXX_KV* kv)
+{
+    //RECLAIM EVERY PAGE BEHIND THE HEAD, PACKING LIVE RECORDS AT THE
+    //HEAD AND DROPPING OVERWRITTEN / DELETED ONES
+
+    uint16_t n;
+
+    if(kv->used_pages <= 1)
+    {
+        return 1;
+    }
+
+    for(n = kv->used_pages - 1; n > 0; n--)
+    {
+        if(kv->used_pages >= kv->page_count || !_eeprom_at24cxx_kv_gc_tail(kv))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+uint16_t PUTINFLASH EEPROM_AT24CXX_KVGetFreePages(EEPROM_AT24CXX_KV* kv)
+{
+    //RETURN PAGES NOT HOLDING ANY PART OF THE LOG
+
+    return kv->page_count - kv->used_pages;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_crc8(uint8_t crc, uint8_t* data, uint8_t len)
+{
+    //CRC-8 (POLY 0x07)
+
+    uint8_t i;
+
+    while(len--)
+    {
+        crc ^= *data++;
+        for(i = 0; i < 8; i++)
+        {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint32_t PUTINFLASH _eeprom_at24cxx_kv_page_address(EEPROM_AT24CXX_KV* kv, uint16_t page)
+{
+    //REGION RELATIVE PAGE TO DEVICE BYTE ADDRESS
+
+    return EEPROM_GET_BYTE_ADDRESS_FROM_PAGE((uint32_t)kv->first_page + page);
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_setup(EEPROM_AT24CXX_KV* kv, EEPROM_AT24CXX_DEVICE* device, uint16_t first_page, uint16_t page_count)
+{
+    //VALIDATE REGION AND RESET STORE TO EMPTY
+
+    uint32_t device_pages;
+    uint16_t i;
+
+    device_pages = EEPROM_AT24CXX_DeviceGetSize(device) / EEPROM_AT24CXX_PAGE_SIZE;
+    if(page_count == 0 && first_page < device_pages)
+    {
+        page_count = device_pages - first_page;
+    }
+    if((uint32_t)first_page + page_count > device_pages || page_count < EEPROM_AT24CXX_KV_RESERVE_PAGES + 2)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : KV : Invalid region !\n");
+        return 0;
+    }
+
+    kv->device = device;
+    kv->first_page = first_page;
+    kv->page_count = page_count;
+    kv->head = 0;
+    kv->head_offset = EEPROM_AT24CXX_PAGE_SIZE;
+    kv->tail = 0;
+    kv->used_pages = 0;
+    kv->head_seq = 0;
+    kv->in_gc = 0;
+    kv->key_count = 0;
+    for(i = 0; i < _EEPROM_AT24CXX_KV_INDEX_SIZE; i++)
+    {
+        kv->index[i].key = EEPROM_AT24CXX_KV_KEY_EMPTY;
+    }
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_read_header(EEPROM_AT24CXX_KV* kv, uint16_t page, uint32_t* seq, uint16_t* span)
+{
+    //READ PAGE HEADER (span OPTIONAL)
+    //RETURN 1 IF PAGE BELONGS TO THE LOG
+
+    uint8_t header[EEPROM_AT24CXX_KV_PAGE_HEADER_SIZE];
+
+    if(EEPROM_AT24CXX_DeviceReadBlock(kv->device, _eeprom_at24cxx_kv_page_address(kv, page), ADDRESS_TYPE_BYTE, header, EEPROM_AT24CXX_KV_PAGE_HEADER_SIZE) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+    *seq = ((uint32_t)header[0] << 24) | ((uint32_t)header[1] << 16) | ((uint32_t)header[2] << 8) | header[3];
+    if(span != NULL)
+    {
+        *span = ((uint16_t)header[4] << 8) | header[5];
+    }
+    return (*seq != 0xFFFFFFFF && _eeprom_at24cxx_kv_crc8(0, header, 6) == header[6]);
+}
+
+static uint16_t PUTINFLASH _eeprom_at24cxx_kv_hash(uint16_t key)
+{
+    //INDEX HOME SLOT FOR KEY
+
+    return (uint16_t)(((uint32_t)key * 40503u) >> 4) & (_EEPROM_AT24CXX_KV_INDEX_SIZE - 1);
+}
+
+static EEPROM_AT24CXX_KV_ENTRY* PUTINFLASH _eeprom_at24cxx_kv_find(EEPROM_AT24CXX_KV* kv, uint16_t key)
+{
+    //RETURN INDEX ENTRY FOR KEY, NULL IF NOT PRESENT
+
+    uint16_t i;
+
+    i = _eeprom_at24cxx_kv_hash(key);
+    while(kv->index[i].key != EEPROM_AT24CXX_KV_KEY_EMPTY)
+    {
+        if(kv->index[i].key == key)
+        {
+            return &kv->index[i];
+        }
+        i = (i + 1) & (_EEPROM_AT24CXX_KV_INDEX_SIZE - 1);
+    }
+    return NULL;
+}
+
+static EEPROM_AT24CXX_KV_ENTRY* PUTINFLASH _eeprom_at24cxx_kv_insert(EEPROM_AT24CXX_KV* kv, uint16_t key)
+{
+    //RETURN INDEX ENTRY FOR KEY, ADDING IT IF NOT PRESENT
+    //NULL IF INDEX IS FULL
+
+    uint16_t i;
+
+    i = _eeprom_at24cxx_kv_hash(key);
+    while(kv->index[i].key != EEPROM_AT24CXX_KV_KEY_EMPTY)
+    {
+        if(kv->index[i].key == key)
+        {
+            return &kv->index[i];
+        }
+        i = (i + 1) & (_EEPROM_AT24CXX_KV_INDEX_SIZE - 1);
+    }
+
+    if(kv->key_count >= EEPROM_AT24CXX_KV_MAX_KEYS)
+    {
+        return NULL;
+    }
+    kv->index[i].key = key;
+    kv->key_count++;
+    return &kv->index[i];
+}
+
+static void PUTINFLASH _eeprom_at24cxx_kv_remove(EEPROM_AT24CXX_KV* kv, EEPROM_AT24CXX_KV_ENTRY* entry)
+{
+    //REMOVE INDEX ENTRY, SHIFTING BACK FOLLOWING ENTRIES OF THE PROBE
+    //CHAIN SO LOOKUPS NEVER NEED TOMBSTONES
+
+    uint16_t hole;
+    uint16_t i;
+    uint16_t home;
+
+    hole = entry - kv->index;
+    i = hole;
+    while(1)
+    {
+        i = (i + 1) & (_EEPROM_AT24CXX_KV_INDEX_SIZE - 1);
+        if(kv->index[i].key == EEPROM_AT24CXX_KV_KEY_EMPTY)
+        {
+            break;
+        }
+        home = _eeprom_at24cxx_kv_hash(kv->index[i].key);
+        //MOVE ENTRY INTO HOLE UNLESS ITS HOME LIES CYCLICALLY IN (hole, i]
+        if((i > hole && (home <= hole || home > i)) ||
+            (i < hole && (home <= hole && home > i)))
+        {
+            kv->index[hole] = kv->index[i];
+            hole = i;
+        }
+    }
+    kv->index[hole].key = EEPROM_AT24CXX_KV_KEY_EMPTY;
+    kv->key_count--;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_append(EEPROM_AT24CXX_KV* kv, uint16_t key, uint8_t* value, uint8_t len, uint16_t* page, uint8_t* offset)
+{
+    //APPEND RECORD AT LOG HEAD, OPENING A NEW PAGE IF IT DOES NOT FIT
+    //RETURN PAGE AND OFFSET THE RECORD WAS WRITTEN AT
+    //LOG STATE ONLY MOVES ONCE THE WRITE SUCCEEDED
+
+    uint8_t page_data[EEPROM_AT24CXX_PAGE_SIZE];
+    uint8_t* record;
+    uint8_t record_len;
+    uint16_t new_page;
+    uint32_t seq = kv->head_seq + 1;
+    uint8_t i;
+
+    record_len = EEPROM_AT24CXX_KV_RECORD_HEADER_SIZE + len;
+
+    if(kv->used_pages == 0 || kv->head_offset + record_len > EEPROM_AT24CXX_PAGE_SIZE)
+    {
+        if(!kv->in_gc && !_eeprom_at24cxx_kv_make_room(kv))
+        {
+            return 0;
+        }
+    }
+
+    //RECLAIMING MAY HAVE LEFT ROOM IN THE HEAD PAGE
+    if(kv->used_pages == 0 || kv->head_offset + record_len > EEPROM_AT24CXX_PAGE_SIZE)
+    {
+        if(kv->used_pages >= kv->page_count)
+        {
+            EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : KV : store full !\n");
+            return 0;
+        }
+        new_page = (kv->used_pages == 0) ? kv->tail : (kv->head + 1) % kv->page_count;
+
+        for(i = 0; i < EEPROM_AT24CXX_PAGE_SIZE; i++)
+        {
+            page_data[i] = 0xFF;
+        }
+        page_data[0] = (uint8_t)(seq >> 24);
+        page_data[1] = (uint8_t)(seq >> 16);
+        page_data[2] = (uint8_t)(seq >> 8);
+        page_data[3] = (uint8_t)seq;
+        page_data[4] = (uint8_t)((kv->used_pages + 1) >> 8);
+        page_data[5] = (uint8_t)(kv->used_pages + 1);
+        page_data[6] = _eeprom_at24cxx_kv_crc8(0, page_data, 6);
+        record = &page_data[EEPROM_AT24CXX_KV_PAGE_HEADER_SIZE];
+    }
+    else
+    {
+        new_page = kv->head;
+        record = page_data;
+    }
+
+    record[0] = (uint8_t)(key >> 8);
+    record[1] = (uint8_t)key;
+    record[2] = len;
+    for(i = 0; i < len; i++)
+    {
+        record[EEPROM_AT24CXX_KV_RECORD_HEADER_SIZE + i] = value[i];
+    }
+    record[3] = _eeprom_at24cxx_kv_crc8(_eeprom_at24cxx_kv_crc8(0, record, 3), &record[EEPROM_AT24CXX_KV_RECORD_HEADER_SIZE], len);
+
+    if(record != page_data)
+    {
+        //OPEN NEW PAGE WITH ONE FULL PAGE WRITE
+        if(EEPROM_AT24CXX_DeviceWriteBlock(kv->device, _eeprom_at24cxx_kv_page_address(kv, new_page), ADDRESS_TYPE_BYTE, page_data, EEPROM_AT24CXX_PAGE_SIZE) != EEPROM_STATUS_OK)
+        {
+            return 0;
+        }
+        kv->head_seq = seq;
+        kv->head = new_page;
+        kv->head_offset = EEPROM_AT24CXX_KV_PAGE_HEADER_SIZE;
+        kv->used_pages++;
+    }
+    else if(EEPROM_AT24CXX_DeviceWriteBlock(kv->device, _eeprom_at24cxx_kv_page_address(kv, new_page) + kv->head_offset, ADDRESS_TYPE_BYTE, record, record_len) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+
+    *page = kv->head;
+    *offset = kv->head_offset;
+    kv->head_offset += record_len;
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_make_room(EEPROM_AT24CXX_KV* kv)
+{
+    //RECLAIM OLDEST PAGES TILL ENOUGH ARE FREE FOR A NEW PAGE PLUS THE
+    //RESERVE. GIVES UP IF A FULL PASS OVER THE LOG FREES NOTHING (LIVE
+    //DATA FILLS THE REGION)
+
+    uint16_t guard;
+
+    guard = kv->page_count;
+    while(kv->page_count - kv->used_pages < EEPROM_AT24CXX_KV_RESERVE_PAGES)
+    {
+        if(kv->used_pages <= 1 || guard-- == 0 || !_eeprom_at24cxx_kv_gc_tail(kv))
+        {
+            EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : KV : store full !\n");
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_gc_tail(EEPROM_AT24CXX_KV* kv)
+{
+    //COPY LIVE RECORDS OF THE TAIL PAGE TO THE HEAD AND DROP THE PAGE
+    //FROM THE LOG. THE PAGE ITSELF IS NOT WRITTEN, IT IS SIMPLY
+    //OVERWRITTEN WHEN THE HEAD WRAPS ROUND TO IT
+
+    uint8_t value[EEPROM_AT24CXX_KV_MAX_VALUE_LEN];
+    EEPROM_AT24CXX_KV_ENTRY* entry;
+    uint16_t page;
+    uint16_t i;
+
+    if(kv->used_pages <= 1)
+    {
+        return 0;
+    }
+
+    kv->in_gc = 1;
+    for(i = 0; i < _EEPROM_AT24CXX_KV_INDEX_SIZE; i++)
+    {
+        entry = &kv->index[i];
+        if(entry->key == EEPROM_AT24CXX_KV_KEY_EMPTY || entry->page != kv->tail)
+        {
+            continue;
+        }
+
+        if(EEPROM_AT24CXX_DeviceReadBlock(kv->device,
+                                            _eeprom_at24cxx_kv_page_address(kv, entry->page) + entry->offset + EEPROM_AT24CXX_KV_RECORD_HEADER_SIZE,
+                                            ADDRESS_TYPE_BYTE,
+                                            value,
+                                            entry->len) != EEPROM_STATUS_OK ||
+            !_eeprom_at24cxx_kv_append(kv, entry->key, value, entry->len, &page, &entry->offset))
+        {
+            kv->in_gc = 0;
+            return 0;
+        }
+        entry->page = page;
+    }
+    kv->in_gc = 0;
+
+    kv->tail = (kv->tail + 1) % kv->page_count;
+    kv->used_pages--;
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_kv_page_live(EEPROM_AT24CXX_KV* kv, uint16_t page)
+{
+    //RETURN 1 IF ANY INDEXED KEY HAS ITS LATEST RECORD IN page
+
+    uint16_t i;
+
+    for(i = 0; i < _EEPROM_AT24CXX_KV_INDEX_SIZE; i++)
+    {
+        if(kv->index[i].key != EEPROM_AT24CXX_KV_KEY_EMPTY && kv->index[i].page == page)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* WEAR LEVELING KEY / VALUE STORE
+*
+* NOTE
+* -------
+*   (1) LOG STRUCTURED : EVERY PUT APPENDS A RECORD AT THE LOG HEAD,
+*       SO REWRITING THE SAME KEY MOVES ACROSS THE WHOLE REGION
+*       INSTEAD OF WEARING OUT ONE LOCATION
+*
+*   (2) LAYOUT (ONE EEPROM PAGE AT A TIME)
+*       PAGE   : [SEQ 4][SPAN 2][CRC8 1][RECORD][RECORD]...[0xFF..]
+*       RECORD : [KEY 2][LEN 1][CRC8 1][VALUE LEN]
+*       SPAN IS THE NUMBER OF LOG PAGES (TAIL TO THIS PAGE) WHEN THE PAGE
+*       WAS OPENED. Mount WALKS BACK FROM THE HEAD NO FURTHER, SO PAGES
+*       RECLAIMED BEFORE THAT ARE NOT TAKEN AS PART OF THE LOG
+*       A PAGE IS OPENED WITH ONE FULL PAGE WRITE (HEADER, FIRST
+*       RECORD, REST 0xFF), FURTHER RECORDS ARE APPENDED INTO THE 0xFF
+*       AREA. A RECORD NEVER SPANS TWO PAGES. LEN 0 DELETES THE KEY
+*
+*   (3) THE OLDEST PAGE IS RECLAIMED (LIVE RECORDS COPIED TO THE HEAD)
+*       WHEN FEWER THAN EEPROM_AT24CXX_KV_RESERVE_PAGES ARE FREE
+*
+*   (4) LOOKUPS GO THROUGH A RAM HASH INDEX REBUILT BY Mount, SO A Get
+*       IS ONE EEPROM READ. INDEX SIZE IS FIXED AT COMPILE TIME
+*
+*   (5) WITH THE PAGE CACHE ON, CALL EEPROM_AT24CXX_DeviceFlush TO
+*       MAKE PUTS DURABLE. A FAILED Flush DROPS THE PAGES IT COULD NOT
+*       WRITE, Mount AGAIN THEN TO REBUILD THE INDEX FROM THE EEPROM
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#ifndef _EEPROM_AT24CXX_KV_H_
+#define _EEPROM_AT24CXX_KV_H_
+
+#include "EEPROM_AT24CXX.h"
+
+//MAXIMUM NUMBER OF KEYS HELD IN THE RAM INDEX (POWER OF 2)
+#ifndef EEPROM_AT24CXX_KV_MAX_KEYS
+  #define EEPROM_AT24CXX_KV_MAX_KEYS          32
+#endif
+#if (EEPROM_AT24CXX_KV_MAX_KEYS & (EEPROM_AT24CXX_KV_MAX_KEYS - 1))
+  #error "EEPROM : AT24CXX : KV : max keys must be a power of 2"
+#endif
+
+//FREE PAGES KEPT BACK SO THE OLDEST PAGE CAN ALWAYS BE RECLAIMED
+#define EEPROM_AT24CXX_KV_RESERVE_PAGES       2
+
+#define EEPROM_AT24CXX_KV_PAGE_HEADER_SIZE    7
+#define EEPROM_AT24CXX_KV_RECORD_HEADER_SIZE  4
+#define EEPROM_AT24CXX_KV_MAX_VALUE_LEN       (EEPROM_AT24CXX_PAGE_SIZE - \
+                                                EEPROM_AT24CXX_KV_PAGE_HEADER_SIZE - \
+                                                EEPROM_AT24CXX_KV_RECORD_HEADER_SIZE)
+#define EEPROM_AT24CXX_KV_KEY_EMPTY           0xFFFF
+
+//CUSTOM VARIABLE STRUCTURES/////////////////////////////
+typedef struct
+{
+    uint16_t key;     //EEPROM_AT24CXX_KV_KEY_EMPTY IF SLOT IS FREE
+    uint16_t page;    //REGION RELATIVE PAGE OF LATEST RECORD
+    uint8_t offset;   //RECORD OFFSET IN PAGE
+    uint8_t len;      //VALUE LENGTH
+} EEPROM_AT24CXX_KV_ENTRY;
+
+typedef struct
+{
+    EEPROM_AT24CXX_DEVICE* device;
+    uint16_t first_page;    //REGION START (DEVICE PAGE)
+    uint16_t page_count;    //REGION LENGTH IN PAGES
+
+    //LOG STATE
+    uint16_t head;          //PAGE RECEIVING APPENDS
+    uint8_t head_offset;    //NEXT FREE BYTE IN HEAD PAGE
+    uint16_t tail;          //OLDEST PAGE IN THE LOG
+    uint16_t used_pages;    //PAGES FROM TAIL TO HEAD
+    uint32_t head_seq;      //SEQUENCE NUMBER OF HEAD PAGE
+    uint8_t in_gc;
+
+    //RAM INDEX (OPEN ADDRESSING, LINEAR PROBING)
+    uint16_t key_count;
+    EEPROM_AT24CXX_KV_ENTRY index[EEPROM_AT24CXX_KV_MAX_KEYS * 2];
+} EEPROM_AT24CXX_KV;
+//END CUSTOM VARIABLE STRUCTURES/////////////////////////
+
+//FUNCTION PROTOTYPES/////////////////////////////////////
+//REGION IS page_count PAGES FROM first_page (page_count 0 = TO END OF
+//DEVICE). ALL FUNCTIONS RETURN 1 ON SUCCESS, 0 ON FAILURE, EXCEPT
+//Get WHICH RETURNS THE STORED VALUE LENGTH (0 = KEY NOT FOUND). A
+//FAILED TRANSFER STOPS THE CALL WITH THE INDEX UNCHANGED AND RETURNS 0
+//(SEE EEPROM_AT24CXX_DeviceGetLastStatus)
+uint8_t PUTINFLASH EEPROM_AT24CXX_KVFormat(EEPROM_AT24CXX_KV* kv,
+                                            EEPROM_AT24CXX_DEVICE* device,
+                                            uint16_t first_page,
+                                            uint16_t page_count);
+uint8_t PUTINFLASH EEPROM_AT24CXX_KVMount(EEPROM_AT24CXX_KV* kv,
+                                            EEPROM_AT24CXX_DEVICE* device,
+                                            uint16_t first_page,
+                                            uint16_t page_count);
+uint8_t PUTINFLASH EEPROM_AT24CXX_KVPut(EEPROM_AT24CXX_KV* kv, uint16_t key, uint8_t* value, uint8_t len);
+uint8_t PUTINFLASH EEPROM_AT24CXX_KVGet(EEPROM_AT24CXX_KV* kv, uint16_t key, uint8_t* value, uint8_t max_len);
+uint8_t PUTINFLASH EEPROM_AT24CXX_KVDelete(EEPROM_AT24CXX_KV* kv, uint16_t key);
+uint8_t PUTINFLASH EEPROM_AT24CXX_KVCompact(EEPROM_AT24CXX_KV* kv);
+uint16_t PUTINFLASH EEPROM_AT24CXX_KVGetFreePages(EEPROM_AT24CXX_KV* kv);
+//END FUNCTION PROTOTYPES/////////////////////////////////
+#endif
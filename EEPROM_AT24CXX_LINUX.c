@@ -0,0 +1,272 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* LINUX i2c-dev BACKEND
+*
+* NOTE
+* -------
+*   (1) DRIVES A REAL EEPROM THROUGH /dev/i2c-N WITH I2C_RDWR. A READ
+*       IS ONE ioctl CARRYING TWO MESSAGES (ADDRESS WRITE + DATA READ,
+*       REPEATED START BETWEEN THEM), A PAGE WRITE IS ONE MESSAGE. NO
+*       PER BYTE read() / write() AND NO I2C_SLAVE SWITCHING
+*
+*   (2) THE ADAPTER MUST REPORT I2C_FUNC_I2C (PLAIN I2C TRANSFERS).
+*       SMBUS ONLY ADAPTERS ARE REFUSED BY LinuxOpen. ACK POLLING USES
+*       A ZERO LENGTH WRITE IF THE ADAPTER HAS I2C_FUNC_SMBUS_QUICK,
+*       ELSE A ONE BYTE READ
+*
+*   (3) ONE BUS PER PROCESS (THE I2C CALLBACKS CARRY NO CONTEXT), ANY
+*       NUMBER OF DEVICES ON IT. LinuxSetIoctl REPLACES THE ioctl CALL
+*       SO THE BACKEND CAN RUN AGAINST A SIMULATED ADAPTER IN TESTS
+*
+*   (4) LinuxAttach ALSO SETS A CLOCK_MONOTONIC TIME FUNCTION, SO
+*       WRITE CYCLE WAITS AND Tick USE REAL ELAPSED TIME
+*
+*   (5) A TRANSFER THE ADAPTER REPORTS AS NOT ACKED (ENXIO, EREMOTEIO)
+*       RETURNS EEPROM_STATUS_NACK, ANY OTHER FAILURE
+*       EEPROM_STATUS_BUS_ERROR. i2c-dev CANNOT CHANGE THE BUS RATE, SO
+*       THERE IS NO I2C CLOCK FUNCTION : SET IT WITH THE ADAPTER'S
+*       clock-frequency IN THE DEVICE TREE
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*   LINUX Documentation/i2c/dev-interface.rst
+*
+****************************************************************/
+
+#include "EEPROM_AT24CXX_LINUX.h"
+
+#if defined(__linux__)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+//LARGEST ADDRESS FIELD (CM01 / C512 : 2 BYTES)
+#define _EEPROM_AT24CXX_LINUX_MAX_ADDRESS_BYTES   2
+
+//LOCAL LIBRARY VARIABLES/////////////////////////////////////
+static int _eeprom_at24cxx_linux_fd = -1;
+static uint8_t _eeprom_at24cxx_linux_quick;
+static int (*_eeprom_at24cxx_linux_ioctl)(int, unsigned long, void*);
+
+//INTERNAL FUNCTIONS//////////////////////////////////////////
+static int PUTINFLASH _eeprom_at24cxx_linux_sys_ioctl(int fd, unsigned long request, void* arg);
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_linux_transfer(struct i2c_msg* msgs, uint8_t count);
+static uint8_t PUTINFLASH _eeprom_at24cxx_linux_address(uint8_t* buffer, uint32_t address, uint8_t address_bytes);
+//END INTERNAL FUNCTIONS//////////////////////////////////////
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_LinuxOpen(const char* path)
+{
+    //OPEN AN i2c-dev BUS (E.G. "/dev/i2c-1") AND CHECK IT CAN DO
+    //COMBINED I2C_RDWR TRANSFERS
+    //RETURN 1 ON SUCCESS
+
+    unsigned long funcs = 0;
+
+    if(_eeprom_at24cxx_linux_ioctl == NULL)
+    {
+        _eeprom_at24cxx_linux_ioctl = _eeprom_at24cxx_linux_sys_ioctl;
+    }
+
+    EEPROM_AT24CXX_LinuxClose();
+    _eeprom_at24cxx_linux_fd = open(path, O_RDWR);
+    if(_eeprom_at24cxx_linux_fd < 0)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : LINUX : cannot open %s !\n", path);
+        return 0;
+    }
+
+    if((*_eeprom_at24cxx_linux_ioctl)(_eeprom_at24cxx_linux_fd, I2C_FUNCS, &funcs) < 0 ||
+        !(funcs & I2C_FUNC_I2C))
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : LINUX : %s has no plain I2C support !\n", path);
+        EEPROM_AT24CXX_LinuxClose();
+        return 0;
+    }
+    _eeprom_at24cxx_linux_quick = ((funcs & I2C_FUNC_SMBUS_QUICK) != 0);
+    return 1;
+}
+
+void PUTINFLASH EEPROM_AT24CXX_LinuxClose(void)
+{
+    //CLOSE THE BUS (IF OPEN)
+
+    if(_eeprom_at24cxx_linux_fd >= 0)
+    {
+        close(_eeprom_at24cxx_linux_fd);
+        _eeprom_at24cxx_linux_fd = -1;
+    }
+}
+
+void PUTINFLASH EEPROM_AT24CXX_LinuxAttach(EEPROM_AT24CXX_DEVICE* device)
+{
+    //POINT ALL I2C, ACK POLL AND TIME FUNCTIONS OF A DRIVER DEVICE AT
+    //THE OPEN i2c-dev BUS
+
+    EEPROM_AT24CXX_DeviceSetI2CFunctions(device,
+                                        EEPROM_AT24CXX_LinuxI2CInit,
+                                        EEPROM_AT24CXX_LinuxI2CWriteByte,
+                                        EEPROM_AT24CXX_LinuxI2CWriteByteMultiple,
+                                        EEPROM_AT24CXX_LinuxI2CReadByte,
+                                        EEPROM_AT24CXX_LinuxI2CReadByteMultiple);
+    EEPROM_AT24CXX_DeviceSetI2CAckPollFunction(device, EEPROM_AT24CXX_LinuxI2CAckPoll);
+    EEPROM_AT24CXX_DeviceSetTimeFunction(device, EEPROM_AT24CXX_LinuxGetTimeUs);
+}
+
+void PUTINFLASH EEPROM_AT24CXX_LinuxSetIoctl(int (*ioctl_function)(int, unsigned long, void*))
+{
+    //REPLACE THE ioctl CALL (NULL = SYSTEM ioctl)
+    //SET BEFORE LinuxOpen
+
+    _eeprom_at24cxx_linux_ioctl = (ioctl_function != NULL) ? ioctl_function : _eeprom_at24cxx_linux_sys_ioctl;
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_LinuxGetTimeUs(void)
+{
+    //RETURN MONOTONIC CLOCK IN MICROSECONDS (WRAPS LIKE A HARDWARE TIMER)
+
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000);
+}
+
+void PUTINFLASH EEPROM_AT24CXX_LinuxI2CInit(void)
+{
+    //NOTHING TO DO, THE KERNEL DRIVER OWNS THE BUS
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_LinuxI2CWriteByte(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t data)
+{
+    //START + ADDRESS + 1 DATA BYTE + STOP
+
+    return EEPROM_AT24CXX_LinuxI2CWriteByteMultiple(i2c_address, address, address_bytes, &data, 1);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_LinuxI2CWriteByteMultiple(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data, uint8_t len)
+{
+    //START + ADDRESS + len DATA BYTES + STOP, ONE MESSAGE
+
+    uint8_t buffer[_EEPROM_AT24CXX_LINUX_MAX_ADDRESS_BYTES + 255];
+    struct i2c_msg msg;
+    uint8_t n;
+
+    n = _eeprom_at24cxx_linux_address(buffer, address, address_bytes);
+    memcpy(&buffer[n], data, len);
+
+    msg.addr = i2c_address;
+    msg.flags = 0;
+    msg.len = n + len;
+    msg.buf = buffer;
+    return _eeprom_at24cxx_linux_transfer(&msg, 1);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_LinuxI2CReadByte(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data)
+{
+    //RANDOM READ OF ONE BYTE
+
+    return EEPROM_AT24CXX_LinuxI2CReadByteMultiple(i2c_address, address, address_bytes, data, 1);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_LinuxI2CReadByteMultiple(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data, uint8_t len)
+{
+    //START + ADDRESS WRITE + REPEATED START + len BYTES READ + STOP
+    //BOTH MESSAGES GO IN ONE I2C_RDWR CALL
+    //ON FAILURE data IS FILLED WITH 0xFF (WHAT A NACKING BUS READS)
+
+    uint8_t buffer[_EEPROM_AT24CXX_LINUX_MAX_ADDRESS_BYTES];
+    struct i2c_msg msgs[2];
+    EEPROM_STATUS status;
+
+    msgs[0].addr = i2c_address;
+    msgs[0].flags = 0;
+    msgs[0].len = _eeprom_at24cxx_linux_address(buffer, address, address_bytes);
+    msgs[0].buf = buffer;
+    msgs[1].addr = i2c_address;
+    msgs[1].flags = I2C_M_RD;
+    msgs[1].len = len;
+    msgs[1].buf = data;
+    status = _eeprom_at24cxx_linux_transfer(msgs, 2);
+    if(status != EEPROM_STATUS_OK)
+    {
+        memset(data, 0xFF, len);
+    }
+    return status;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_LinuxI2CAckPoll(uint8_t i2c_address)
+{
+    //ADDRESS THE DEVICE ONLY
+    //RETURN 1 IF DEVICE ACKS (NOT IN A WRITE CYCLE)
+
+    struct i2c_msg msg;
+    uint8_t dummy;
+
+    msg.addr = i2c_address;
+    if(_eeprom_at24cxx_linux_quick)
+    {
+        msg.flags = 0;
+        msg.len = 0;
+    }
+    else
+    {
+        msg.flags = I2C_M_RD;
+        msg.len = 1;
+    }
+    msg.buf = &dummy;
+    return (_eeprom_at24cxx_linux_transfer(&msg, 1) == EEPROM_STATUS_OK);
+}
+
+static int PUTINFLASH _eeprom_at24cxx_linux_sys_ioctl(int fd, unsigned long request, void* arg)
+{
+    //DEFAULT ioctl FUNCTION
+
+    return ioctl(fd, request, arg);
+}
+
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_linux_transfer(struct i2c_msg* msgs, uint8_t count)
+{
+    //RUN count MESSAGES AS ONE COMBINED TRANSFER (ONE STOP AT THE END)
+    //ADAPTERS REPORT A MISSING ADDRESS ACK AS ENXIO OR EREMOTEIO
+
+    struct i2c_rdwr_ioctl_data rdwr;
+    int ret;
+
+    if(_eeprom_at24cxx_linux_fd < 0)
+    {
+        return EEPROM_STATUS_BUS_ERROR;
+    }
+    rdwr.msgs = msgs;
+    rdwr.nmsgs = count;
+    ret = (*_eeprom_at24cxx_linux_ioctl)(_eeprom_at24cxx_linux_fd, I2C_RDWR, &rdwr);
+    if(ret == (int)count)
+    {
+        return EEPROM_STATUS_OK;
+    }
+    if(ret < 0 && (errno == ENXIO || errno == EREMOTEIO))
+    {
+        return EEPROM_STATUS_NACK;
+    }
+    return EEPROM_STATUS_BUS_ERROR;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_linux_address(uint8_t* buffer, uint32_t address, uint8_t address_bytes)
+{
+    //PUT MEMORY ADDRESS (MSB FIRST) IN buffer, RETURN ITS LENGTH
+
+    if(address_bytes >= 2)
+    {
+        buffer[0] = (uint8_t)(address >> 8);
+        buffer[1] = (uint8_t)address;
+        return 2;
+    }
+    buffer[0] = (uint8_t)address;
+    return 1;
+}
+
+#endif
@@ -0,0 +1,65 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* LINUX i2c-dev BACKEND
+*
+* NOTE
+* -------
+*   (1) DRIVES A REAL EEPROM THROUGH /dev/i2c-N WITH I2C_RDWR. A READ
+*       IS ONE ioctl CARRYING TWO MESSAGES (ADDRESS WRITE + DATA READ,
+*       REPEATED START BETWEEN THEM), A PAGE WRITE IS ONE MESSAGE. NO
+*       PER BYTE read() / write() AND NO I2C_SLAVE SWITCHING
+*
+*   (2) THE ADAPTER MUST REPORT I2C_FUNC_I2C (PLAIN I2C TRANSFERS).
+*       SMBUS ONLY ADAPTERS ARE REFUSED BY LinuxOpen. ACK POLLING USES
+*       A ZERO LENGTH WRITE IF THE ADAPTER HAS I2C_FUNC_SMBUS_QUICK,
+*       ELSE A ONE BYTE READ
+*
+*   (3) ONE BUS PER PROCESS (THE I2C CALLBACKS CARRY NO CONTEXT), ANY
+*       NUMBER OF DEVICES ON IT. LinuxSetIoctl REPLACES THE ioctl CALL
+*       SO THE BACKEND CAN RUN AGAINST A SIMULATED ADAPTER IN TESTS
+*
+*   (4) LinuxAttach ALSO SETS A CLOCK_MONOTONIC TIME FUNCTION, SO
+*       WRITE CYCLE WAITS AND Tick USE REAL ELAPSED TIME
+*
+*   (5) A TRANSFER THE ADAPTER REPORTS AS NOT ACKED (ENXIO, EREMOTEIO)
+*       RETURNS EEPROM_STATUS_NACK, ANY OTHER FAILURE
+*       EEPROM_STATUS_BUS_ERROR. i2c-dev CANNOT CHANGE THE BUS RATE, SO
+*       THERE IS NO I2C CLOCK FUNCTION : SET IT WITH THE ADAPTER'S
+*       clock-frequency IN THE DEVICE TREE
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*   LINUX Documentation/i2c/dev-interface.rst
+*
+****************************************************************/
+
+#ifndef _EEPROM_AT24CXX_LINUX_H_
+#define _EEPROM_AT24CXX_LINUX_H_
+
+#include "EEPROM_AT24CXX.h"
+
+#if defined(__linux__)
+
+//FUNCTION PROTOTYPES/////////////////////////////////////
+//CONFIGURATION FUNCTIONS
+//Open RETURNS 1 ON SUCCESS, 0 IF THE BUS CANNOT BE OPENED OR LACKS
+//PLAIN I2C SUPPORT
+uint8_t PUTINFLASH EEPROM_AT24CXX_LinuxOpen(const char* path);
+void PUTINFLASH EEPROM_AT24CXX_LinuxClose(void);
+void PUTINFLASH EEPROM_AT24CXX_LinuxAttach(EEPROM_AT24CXX_DEVICE* device);
+void PUTINFLASH EEPROM_AT24CXX_LinuxSetIoctl(int (*ioctl_function)(int, unsigned long, void*));
+uint32_t PUTINFLASH EEPROM_AT24CXX_LinuxGetTimeUs(void);
+
+//I2C FUNCTIONS (SAME SIGNATURES AS EEPROM_AT24CXX_SetI2CFunctions)
+void PUTINFLASH EEPROM_AT24CXX_LinuxI2CInit(void);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_LinuxI2CWriteByte(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t data);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_LinuxI2CWriteByteMultiple(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data, uint8_t len);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_LinuxI2CReadByte(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_LinuxI2CReadByteMultiple(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data, uint8_t len);
+uint8_t PUTINFLASH EEPROM_AT24CXX_LinuxI2CAckPoll(uint8_t i2c_address);
+//END FUNCTION PROTOTYPES/////////////////////////////////
+
+#endif
+#endif
@@ -0,0 +1,606 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* COMPRESSED RECORDS
+*
+* NOTE
+* -------
+*   (1) Write COMPRESSES A BLOCK (CALIBRATION TABLE, LOG CHUNK, CONFIG)
+*       INTO THE CALLER'S WORK BUFFER AND STORES IT AS ONE RECORD
+*       STARTING ON A DEVICE PAGE. HEADER AND PAYLOAD GO OUT TOGETHER
+*       (WriteV), SO EVERY PAGE OF THE RECORD COSTS ONE WRITE CYCLE.
+*       FEWER BYTES ARE FEWER PAGE WRITES AND LESS BUS TIME
+*
+*   (2) Read FETCHES THE HEADER, THEN THE WHOLE PAYLOAD WITH ONE
+*       SEQUENTIAL READ AND DECODES IT INTO THE CALLER'S BUFFER. AN
+*       UNCOMPRESSED RECORD IS READ STRAIGHT INTO IT
+*
+*   (3) CODECS (PICKED PER RECORD, NONE ALLOCATES MEMORY)
+*       LZ      : LZ77 WITH LZ4 STYLE TOKENS ([LITERALS 4 | MATCH 4]
+*                 [LITERALS][OFFSET 2 LE]). MATCHES FROM 3 BYTES, UP TO
+*                 64KB BACK. THE MATCH FINDER IS A STACK HASH TABLE OF
+*                 2^EEPROM_AT24CXX_PACK_HASH_BITS ENTRIES (2 BYTES EACH).
+*                 DECODING NEEDS NO MEMORY BESIDES THE OUTPUT
+*       DELTA8 / DELTA16 / DELTA32 : TABLES OF 1 / 2 / 4 BYTE INTEGERS
+*                 (HOST BYTE ORDER) STORED AS THE ZIGZAG VARINT OF THE
+*                 DIFFERENCE TO THE PREVIOUS ELEMENT. SMOOTH CURVES AND
+*                 COUNTERS SHRINK TO ABOUT A BYTE PER ELEMENT
+*       A RECORD THE CODEC DOES NOT SHRINK IS STORED AS IS (NONE)
+*
+*   (4) RECORD : [CODEC 1][RAW LEN 2][PACKED LEN 2][CRC32 4][PAYLOAD]
+*       LENGTHS LITTLE ENDIAN, CRC32 OF THE RAW DATA. ERASED EEPROM
+*       (0xFF) IS NOT A VALID CODEC. A RECORD THAT FAILS ITS CRC OR DOES
+*       NOT DECODE IS REPORTED AS MISSING
+*
+*   (5) CAPACITY ITSELF IS FIXED BY THE PART (4KB ON THE AT24C32), THIS
+*       ONLY STORES MORE IN IT
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#include "EEPROM_AT24CXX_PACK.h"
+
+//LZ TOKENS
+#define _EEPROM_AT24CXX_PACK_MIN_MATCH        3
+#define _EEPROM_AT24CXX_PACK_HASH(p)          ((((((uint32_t)(p)[0]) << 16) | (((uint32_t)(p)[1]) << 8) | (p)[2]) * 2654435761U) \
+                                                >> (32 - EEPROM_AT24CXX_PACK_HASH_BITS))
+
+//INTERNAL FUNCTIONS//////////////////////////////////////////
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_check(EEPROM_AT24CXX_DEVICE* device, uint32_t address, uint32_t len);
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_header(EEPROM_AT24CXX_DEVICE* device, uint32_t address, uint8_t* codec, uint32_t* raw_len, uint32_t* packed_len, uint32_t* crc);
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_element_size(uint8_t codec);
+static uint32_t PUTINFLASH _eeprom_at24cxx_pack_lz(const uint8_t* in, uint32_t len, uint8_t* out, uint32_t out_len);
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_lz_emit(uint8_t* out, uint32_t* pos, uint32_t out_len, const uint8_t* literals, uint32_t literal_len, uint32_t offset, uint32_t match_len);
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_unlz(const uint8_t* in, uint32_t in_len, uint8_t* out, uint32_t out_len);
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_lz_len(const uint8_t* in, uint32_t in_len, uint32_t* pos, uint32_t* len);
+static uint32_t PUTINFLASH _eeprom_at24cxx_pack_delta(const uint8_t* in, uint32_t len, uint8_t size, uint8_t* out, uint32_t out_len);
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_undelta(const uint8_t* in, uint32_t in_len, uint8_t size, uint8_t* out, uint32_t out_len);
+static uint32_t PUTINFLASH _eeprom_at24cxx_pack_load(const uint8_t* data, uint8_t size);
+static void PUTINFLASH _eeprom_at24cxx_pack_store(uint8_t* data, uint8_t size, uint32_t value);
+//END INTERNAL FUNCTIONS//////////////////////////////////////
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_PACKWrite(EEPROM_AT24CXX_DEVICE* device,
+                                            uint32_t address,
+                                            EEPROM_PACK_CODEC codec,
+                                            uint8_t* data,
+                                            uint32_t len,
+                                            uint8_t* work,
+                                            uint32_t work_len)
+{
+    //COMPRESS data AND STORE IT AS ONE RECORD AT address
+
+    EEPROM_AT24CXX_IOVEC vec[2];
+    uint8_t header[EEPROM_AT24CXX_PACK_HEADER_SIZE];
+    uint8_t* payload = data;
+    uint32_t payload_len = 0;
+    uint32_t limit;
+    uint32_t crc;
+    uint16_t page_size;
+    uint8_t size;
+
+    size = _eeprom_at24cxx_pack_element_size(codec);
+    if(codec >= EEPROM_PACK_MAX || len == 0 || len > EEPROM_AT24CXX_PACK_MAX_LEN || (len % size) != 0)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : PACK : Invalid record !\n");
+        return 0;
+    }
+
+    //PACKED PAYLOAD MUST FIT work AND BEAT THE RAW SIZE
+    limit = len - 1;
+    if(work == NULL)
+    {
+        limit = 0;
+    }
+    else if(limit > work_len)
+    {
+        limit = work_len;
+    }
+
+    if(limit > 0)
+    {
+        switch(codec)
+        {
+            case EEPROM_PACK_LZ:
+                payload_len = _eeprom_at24cxx_pack_lz(data, len, work, limit);
+                break;
+
+            case EEPROM_PACK_DELTA8:
+            case EEPROM_PACK_DELTA16:
+            case EEPROM_PACK_DELTA32:
+                payload_len = _eeprom_at24cxx_pack_delta(data, len, size, work, limit);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if(payload_len == 0)
+    {
+        codec = EEPROM_PACK_NONE;
+        payload_len = len;
+    }
+    else
+    {
+        payload = work;
+    }
+
+    if(!_eeprom_at24cxx_pack_check(device, address, EEPROM_AT24CXX_PACK_HEADER_SIZE + payload_len))
+    {
+        return 0;
+    }
+
+    crc = EEPROM_AT24CXX_Crc32(0, data, len);
+    header[0] = (uint8_t)codec;
+    header[1] = (uint8_t)len;
+    header[2] = (uint8_t)(len >> 8);
+    header[3] = (uint8_t)payload_len;
+    header[4] = (uint8_t)(payload_len >> 8);
+    header[5] = (uint8_t)crc;
+    header[6] = (uint8_t)(crc >> 8);
+    header[7] = (uint8_t)(crc >> 16);
+    header[8] = (uint8_t)(crc >> 24);
+
+    vec[0].address = address;
+    vec[0].data = header;
+    vec[0].data_len = EEPROM_AT24CXX_PACK_HEADER_SIZE;
+    vec[1].address = address + EEPROM_AT24CXX_PACK_HEADER_SIZE;
+    vec[1].data = payload;
+    vec[1].data_len = payload_len;
+    if(!EEPROM_AT24CXX_DeviceWriteV(device, vec, 2))
+    {
+        return 0;
+    }
+
+    page_size = EEPROM_AT24CXX_DeviceGetPageSize(device);
+    return ((EEPROM_AT24CXX_PACK_HEADER_SIZE + payload_len + page_size - 1) / page_size) * page_size;
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_PACKGetSize(EEPROM_AT24CXX_DEVICE* device, uint32_t address)
+{
+    //RETURN RAW LENGTH OF THE RECORD AT address (0 = NO RECORD)
+
+    uint32_t raw_len;
+    uint32_t packed_len;
+    uint32_t crc;
+    uint8_t codec;
+
+    if(!_eeprom_at24cxx_pack_header(device, address, &codec, &raw_len, &packed_len, &crc))
+    {
+        return 0;
+    }
+    return raw_len;
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_PACKRead(EEPROM_AT24CXX_DEVICE* device,
+                                            uint32_t address,
+                                            uint8_t* data,
+                                            uint32_t data_len,
+                                            uint8_t* work,
+                                            uint32_t work_len)
+{
+    //READ AND DECODE THE RECORD AT address INTO data
+    //work HOLDS THE PACKED PAYLOAD (NOT USED FOR AN UNCOMPRESSED RECORD)
+
+    uint32_t raw_len;
+    uint32_t packed_len;
+    uint32_t crc;
+    uint8_t codec;
+    uint8_t ok;
+
+    if(!_eeprom_at24cxx_pack_header(device, address, &codec, &raw_len, &packed_len, &crc))
+    {
+        return 0;
+    }
+    if(raw_len > data_len || (codec != EEPROM_PACK_NONE && (work == NULL || packed_len > work_len)))
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : PACK : buffer too small for record at %u !\n", address);
+        return 0;
+    }
+
+    //ONE SEQUENTIAL READ OF THE PAYLOAD
+    if(EEPROM_AT24CXX_DeviceReadBlock(device,
+                                        address + EEPROM_AT24CXX_PACK_HEADER_SIZE,
+                                        ADDRESS_TYPE_BYTE,
+                                        (codec == EEPROM_PACK_NONE) ? data : work,
+                                        packed_len) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+
+    switch(codec)
+    {
+        case EEPROM_PACK_LZ:
+            ok = _eeprom_at24cxx_pack_unlz(work, packed_len, data, raw_len);
+            break;
+
+        case EEPROM_PACK_DELTA8:
+        case EEPROM_PACK_DELTA16:
+        case EEPROM_PACK_DELTA32:
+            ok = _eeprom_at24cxx_pack_undelta(work, packed_len, _eeprom_at24cxx_pack_element_size(codec), data, raw_len);
+            break;
+
+        default:
+            ok = 1;
+            break;
+    }
+
+    if(!ok || EEPROM_AT24CXX_Crc32(0, data, raw_len) != crc)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : PACK : record at %u failed check !\n", address);
+        return 0;
+    }
+    return raw_len;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_check(EEPROM_AT24CXX_DEVICE* device, uint32_t address, uint32_t len)
+{
+    //RECORD MUST START ON A DEVICE PAGE AND FIT THE DEVICE
+
+    if((address % EEPROM_AT24CXX_DeviceGetPageSize(device)) != 0 ||
+        address >= EEPROM_AT24CXX_DeviceGetSize(device) ||
+        len > EEPROM_AT24CXX_DeviceGetSize(device) - address)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : PACK : Invalid address !\n");
+        return 0;
+    }
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_header(EEPROM_AT24CXX_DEVICE* device, uint32_t address, uint8_t* codec, uint32_t* raw_len, uint32_t* packed_len, uint32_t* crc)
+{
+    //READ AND SANITY CHECK A RECORD HEADER
+    //RETURN 0 IF THERE IS NO RECORD AT address
+
+    uint8_t header[EEPROM_AT24CXX_PACK_HEADER_SIZE];
+
+    if(!_eeprom_at24cxx_pack_check(device, address, EEPROM_AT24CXX_PACK_HEADER_SIZE))
+    {
+        return 0;
+    }
+    if(EEPROM_AT24CXX_DeviceReadBlock(device, address, ADDRESS_TYPE_BYTE, header, EEPROM_AT24CXX_PACK_HEADER_SIZE) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+
+    *codec = header[0];
+    *raw_len = ((uint32_t)header[1]) | (((uint32_t)header[2]) << 8);
+    *packed_len = ((uint32_t)header[3]) | (((uint32_t)header[4]) << 8);
+    *crc = ((uint32_t)header[5]) | (((uint32_t)header[6]) << 8) |
+            (((uint32_t)header[7]) << 16) | (((uint32_t)header[8]) << 24);
+
+    if(*codec >= EEPROM_PACK_MAX || *raw_len == 0 || *packed_len == 0 ||
+        (*codec == EEPROM_PACK_NONE && *packed_len != *raw_len) ||
+        (*codec != EEPROM_PACK_NONE && *packed_len >= *raw_len) ||
+        (*raw_len % _eeprom_at24cxx_pack_element_size(*codec)) != 0 ||
+        EEPROM_AT24CXX_PACK_HEADER_SIZE + *packed_len > EEPROM_AT24CXX_DeviceGetSize(device) - address)
+    {
+        return 0;
+    }
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_element_size(uint8_t codec)
+{
+    //DELTA ELEMENT SIZE IN BYTES (1 FOR BYTE STREAM CODECS)
+
+    switch(codec)
+    {
+        case EEPROM_PACK_DELTA16:
+            return 2;
+        case EEPROM_PACK_DELTA32:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+static uint32_t PUTINFLASH _eeprom_at24cxx_pack_lz(const uint8_t* in, uint32_t len, uint8_t* out, uint32_t out_len)
+{
+    //LZ77 COMPRESS in INTO out
+    //ONE HASH PROBE PER POSITION (LAST POSITION WITH THE SAME 3 BYTE
+    //HASH), MATCH EXTENDED AS FAR AS IT GOES
+    //RETURN PACKED LENGTH, 0 IF IT DOES NOT FIT out_len
+
+    uint16_t table[1 << EEPROM_AT24CXX_PACK_HASH_BITS];
+    uint32_t pos = 0;
+    uint32_t anchor = 0;
+    uint32_t i = 0;
+    uint32_t candidate;
+    uint32_t match_len;
+
+    memset(table, 0, sizeof(table));
+    while(i + _EEPROM_AT24CXX_PACK_MIN_MATCH <= len)
+    {
+        candidate = table[_EEPROM_AT24CXX_PACK_HASH(&in[i])];
+        table[_EEPROM_AT24CXX_PACK_HASH(&in[i])] = (uint16_t)i;
+        if(candidate >= i || in[candidate] != in[i] ||
+            in[candidate + 1] != in[i + 1] || in[candidate + 2] != in[i + 2])
+        {
+            i++;
+            continue;
+        }
+
+        match_len = _EEPROM_AT24CXX_PACK_MIN_MATCH;
+        while(i + match_len < len && in[candidate + match_len] == in[i + match_len])
+        {
+            match_len++;
+        }
+        if(!_eeprom_at24cxx_pack_lz_emit(out, &pos, out_len, &in[anchor], i - anchor, i - candidate, match_len))
+        {
+            return 0;
+        }
+
+        //INDEX THE MATCHED BYTES TOO, LATER REPEATS OFTEN START INSIDE
+        for(anchor = i + match_len, i++; i < anchor; i++)
+        {
+            if(i + _EEPROM_AT24CXX_PACK_MIN_MATCH <= len)
+            {
+                table[_EEPROM_AT24CXX_PACK_HASH(&in[i])] = (uint16_t)i;
+            }
+        }
+    }
+
+    if(!_eeprom_at24cxx_pack_lz_emit(out, &pos, out_len, &in[anchor], len - anchor, 0, 0))
+    {
+        return 0;
+    }
+    return pos;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_lz_emit(uint8_t* out, uint32_t* pos, uint32_t out_len, const uint8_t* literals, uint32_t literal_len, uint32_t offset, uint32_t match_len)
+{
+    //APPEND ONE SEQUENCE (match_len 0 : LAST ONE, LITERALS ONLY)
+    //A NIBBLE OF 15 IS EXTENDED BY BYTES ADDED ON TILL ONE IS NOT 255
+    //RETURN 0 IF IT DOES NOT FIT
+
+    uint32_t match_code = (match_len > 0) ? match_len - _EEPROM_AT24CXX_PACK_MIN_MATCH : 0;
+    uint32_t p = *pos;
+    uint32_t need;
+    uint32_t n;
+
+    need = 1 + literal_len;
+    if(literal_len >= 15)
+    {
+        need += ((literal_len - 15) / 255) + 1;
+    }
+    if(match_len > 0)
+    {
+        need += 2;
+        if(match_code >= 15)
+        {
+            need += ((match_code - 15) / 255) + 1;
+        }
+    }
+    if(need > out_len - p)
+    {
+        return 0;
+    }
+
+    out[p++] = (uint8_t)((((literal_len < 15) ? literal_len : 15) << 4) | ((match_code < 15) ? match_code : 15));
+    if(literal_len >= 15)
+    {
+        for(n = literal_len - 15; n >= 255; n -= 255)
+        {
+            out[p++] = 255;
+        }
+        out[p++] = (uint8_t)n;
+    }
+    MEMCPY(&out[p], literals, literal_len);
+    p += literal_len;
+
+    if(match_len > 0)
+    {
+        out[p++] = (uint8_t)offset;
+        out[p++] = (uint8_t)(offset >> 8);
+        if(match_code >= 15)
+        {
+            for(n = match_code - 15; n >= 255; n -= 255)
+            {
+                out[p++] = 255;
+            }
+            out[p++] = (uint8_t)n;
+        }
+    }
+    *pos = p;
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_unlz(const uint8_t* in, uint32_t in_len, uint8_t* out, uint32_t out_len)
+{
+    //DECODE LZ SEQUENCES FROM in, EVERY LENGTH AND OFFSET IS BOUNDS
+    //CHECKED SO A DAMAGED PAYLOAD CANNOT WRITE OUTSIDE out
+    //RETURN 1 IF EXACTLY out_len BYTES CAME OUT
+
+    uint32_t ip = 0;
+    uint32_t op = 0;
+    uint32_t len;
+    uint32_t offset;
+    uint8_t token;
+
+    while(ip < in_len)
+    {
+        token = in[ip++];
+
+        len = token >> 4;
+        if(!_eeprom_at24cxx_pack_lz_len(in, in_len, &ip, &len) ||
+            len > in_len - ip || len > out_len - op)
+        {
+            return 0;
+        }
+        MEMCPY(&out[op], &in[ip], len);
+        ip += len;
+        op += len;
+        if(ip == in_len)
+        {
+            break;
+        }
+
+        if(in_len - ip < 2)
+        {
+            return 0;
+        }
+        offset = ((uint32_t)in[ip]) | (((uint32_t)in[ip + 1]) << 8);
+        ip += 2;
+        len = token & 0x0F;
+        if(offset == 0 || offset > op || !_eeprom_at24cxx_pack_lz_len(in, in_len, &ip, &len))
+        {
+            return 0;
+        }
+        len += _EEPROM_AT24CXX_PACK_MIN_MATCH;
+        if(len > out_len - op)
+        {
+            return 0;
+        }
+
+        //BYTE BY BYTE, A MATCH MAY OVERLAP ITS OWN OUTPUT (RUNS)
+        for(; len > 0; len--, op++)
+        {
+            out[op] = out[op - offset];
+        }
+    }
+    return (op == out_len);
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_lz_len(const uint8_t* in, uint32_t in_len, uint32_t* pos, uint32_t* len)
+{
+    //ADD THE EXTENSION BYTES OF A NIBBLE OF 15 TO len
+
+    uint8_t extra;
+
+    if(*len != 15)
+    {
+        return 1;
+    }
+    do
+    {
+        if(*pos >= in_len || *len > EEPROM_AT24CXX_PACK_MAX_LEN)
+        {
+            return 0;
+        }
+        extra = in[(*pos)++];
+        *len += extra;
+    } while(extra == 255);
+    return 1;
+}
+
+static uint32_t PUTINFLASH _eeprom_at24cxx_pack_delta(const uint8_t* in, uint32_t len, uint8_t size, uint8_t* out, uint32_t out_len)
+{
+    //DELTA + ZIGZAG + VARINT (7 BITS PER BYTE, LOW FIRST) ENCODE in
+    //RETURN PACKED LENGTH, 0 IF IT DOES NOT FIT out_len
+
+    uint32_t previous = 0;
+    uint32_t value;
+    uint32_t zigzag;
+    uint32_t pos = 0;
+    uint32_t i;
+    int32_t delta;
+
+    for(i = 0; i < len; i += size)
+    {
+        value = _eeprom_at24cxx_pack_load(&in[i], size);
+
+        //DIFFERENCE WRAPS AT THE ELEMENT WIDTH, THEN SIGN EXTENDED
+        switch(size)
+        {
+            case 2:
+                delta = (int16_t)(value - previous);
+                break;
+            case 4:
+                delta = (int32_t)(value - previous);
+                break;
+            default:
+                delta = (int8_t)(value - previous);
+                break;
+        }
+        previous = value;
+
+        zigzag = (((uint32_t)delta) << 1) ^ ((delta < 0) ? 0xFFFFFFFF : 0);
+        do
+        {
+            if(pos >= out_len)
+            {
+                return 0;
+            }
+            out[pos++] = (uint8_t)((zigzag & 0x7F) | ((zigzag > 0x7F) ? 0x80 : 0));
+            zigzag >>= 7;
+        } while(zigzag != 0);
+    }
+    return pos;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_pack_undelta(const uint8_t* in, uint32_t in_len, uint8_t size, uint8_t* out, uint32_t out_len)
+{
+    //DECODE DELTA VARINTS FROM in INTO out_len BYTES OF ELEMENTS
+    //RETURN 1 IF in HELD EXACTLY THAT MANY ELEMENTS
+
+    uint32_t previous = 0;
+    uint32_t zigzag;
+    uint32_t pos = 0;
+    uint32_t i;
+    uint8_t shift;
+    uint8_t byte;
+
+    for(i = 0; i < out_len; i += size)
+    {
+        zigzag = 0;
+        shift = 0;
+        do
+        {
+            if(pos >= in_len || shift > 28)
+            {
+                return 0;
+            }
+            byte = in[pos++];
+            zigzag |= ((uint32_t)(byte & 0x7F)) << shift;
+            shift += 7;
+        } while(byte & 0x80);
+
+        previous += (zigzag >> 1) ^ (0 - (zigzag & 1));
+        _eeprom_at24cxx_pack_store(&out[i], size, previous);
+    }
+    return (pos == in_len);
+}
+
+static uint32_t PUTINFLASH _eeprom_at24cxx_pack_load(const uint8_t* data, uint8_t size)
+{
+    //ELEMENT AT data IN HOST BYTE ORDER (data MAY BE UNALIGNED)
+
+    uint16_t value16;
+    uint32_t value32;
+
+    switch(size)
+    {
+        case 2:
+            MEMCPY(&value16, data, 2);
+            return value16;
+        case 4:
+            MEMCPY(&value32, data, 4);
+            return value32;
+        default:
+            return data[0];
+    }
+}
+
+static void PUTINFLASH _eeprom_at24cxx_pack_store(uint8_t* data, uint8_t size, uint32_t value)
+{
+    //STORE LOW size BYTES OF value AT data IN HOST BYTE ORDER
+
+    uint16_t value16 = (uint16_t)value;
+
+    switch(size)
+    {
+        case 2:
+            MEMCPY(data, &value16, 2);
+            break;
+        case 4:
+            MEMCPY(data, &value, 4);
+            break;
+        default:
+            data[0] = (uint8_t)value;
+            break;
+    }
+}
@@ -0,0 +1,99 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* COMPRESSED RECORDS
+*
+* NOTE
+* -------
+*   (1) Write COMPRESSES A BLOCK (CALIBRATION TABLE, LOG CHUNK, CONFIG)
+*       INTO THE CALLER'S WORK BUFFER AND STORES IT AS ONE RECORD
+*       STARTING ON A DEVICE PAGE. HEADER AND PAYLOAD GO OUT TOGETHER
+*       (WriteV), SO EVERY PAGE OF THE RECORD COSTS ONE WRITE CYCLE.
+*       FEWER BYTES ARE FEWER PAGE WRITES AND LESS BUS TIME
+*
+*   (2) Read FETCHES THE HEADER, THEN THE WHOLE PAYLOAD WITH ONE
+*       SEQUENTIAL READ AND DECODES IT INTO THE CALLER'S BUFFER. AN
+*       UNCOMPRESSED RECORD IS READ STRAIGHT INTO IT
+*
+*   (3) CODECS (PICKED PER RECORD, NONE ALLOCATES MEMORY)
+*       LZ      : LZ77 WITH LZ4 STYLE TOKENS ([LITERALS 4 | MATCH 4]
+*                 [LITERALS][OFFSET 2 LE]). MATCHES FROM 3 BYTES, UP TO
+*                 64KB BACK. THE MATCH FINDER IS A STACK HASH TABLE OF
+*                 2^EEPROM_AT24CXX_PACK_HASH_BITS ENTRIES (2 BYTES EACH).
+*                 DECODING NEEDS NO MEMORY BESIDES THE OUTPUT
+*       DELTA8 / DELTA16 / DELTA32 : TABLES OF 1 / 2 / 4 BYTE INTEGERS
+*                 (HOST BYTE ORDER) STORED AS THE ZIGZAG VARINT OF THE
+*                 DIFFERENCE TO THE PREVIOUS ELEMENT. SMOOTH CURVES AND
+*                 COUNTERS SHRINK TO ABOUT A BYTE PER ELEMENT
+*       A RECORD THE CODEC DOES NOT SHRINK IS STORED AS IS (NONE)
+*
+*   (4) RECORD : [CODEC 1][RAW LEN 2][PACKED LEN 2][CRC32 4][PAYLOAD]
+*       LENGTHS LITTLE ENDIAN, CRC32 OF THE RAW DATA. ERASED EEPROM
+*       (0xFF) IS NOT A VALID CODEC. A RECORD THAT FAILS ITS CRC OR DOES
+*       NOT DECODE IS REPORTED AS MISSING
+*
+*   (5) CAPACITY ITSELF IS FIXED BY THE PART (4KB ON THE AT24C32), THIS
+*       ONLY STORES MORE IN IT
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#ifndef _EEPROM_AT24CXX_PACK_H_
+#define _EEPROM_AT24CXX_PACK_H_
+
+#include "EEPROM_AT24CXX.h"
+
+//LZ MATCH FINDER SIZE (STACK, 2 * 2^BITS BYTES DURING Write)
+#ifndef EEPROM_AT24CXX_PACK_HASH_BITS
+  #define EEPROM_AT24CXX_PACK_HASH_BITS       8
+#endif
+#if (EEPROM_AT24CXX_PACK_HASH_BITS < 6) || (EEPROM_AT24CXX_PACK_HASH_BITS > 12)
+  #error "EEPROM : AT24CXX : PACK : hash bits must be 6 ... 12"
+#endif
+
+#define EEPROM_AT24CXX_PACK_HEADER_SIZE       9
+
+//LARGEST RAW RECORD
+#define EEPROM_AT24CXX_PACK_MAX_LEN           0xFFFF
+
+//CUSTOM VARIABLE STRUCTURES/////////////////////////////
+typedef enum
+{
+    EEPROM_PACK_NONE = 0,
+    EEPROM_PACK_LZ,
+    EEPROM_PACK_DELTA8,
+    EEPROM_PACK_DELTA16,
+    EEPROM_PACK_DELTA32,
+    EEPROM_PACK_MAX
+} EEPROM_PACK_CODEC;
+//END CUSTOM VARIABLE STRUCTURES/////////////////////////
+
+//FUNCTION PROTOTYPES/////////////////////////////////////
+//address IS A DEVICE BYTE ADDRESS ON A DEVICE PAGE BOUNDARY
+//Write RETURNS THE BYTES THE RECORD TAKES, ROUNDED UP TO WHOLE DEVICE
+//PAGES (THE NEXT RECORD CAN GO AT address + THAT), 0 ON FAILURE. A
+//WORK BUFFER SMALLER THAN len ONLY LIMITS HOW MUCH A RECORD
+//MAY PACK TO, SHORT OF THAT IT IS STORED AS IS. DELTA len MUST BE A
+//MULTIPLE OF THE ELEMENT SIZE
+//GetSize RETURNS THE RAW LENGTH OF THE RECORD AT address (0 = NONE)
+//Read RETURNS THE RAW LENGTH, 0 IF THERE IS NO VALID RECORD, data OR
+//work IS TOO SMALL OR A TRANSFER FAILED (SEE DeviceGetLastStatus)
+uint32_t PUTINFLASH EEPROM_AT24CXX_PACKWrite(EEPROM_AT24CXX_DEVICE* device,
+                                            uint32_t address,
+                                            EEPROM_PACK_CODEC codec,
+                                            uint8_t* data,
+                                            uint32_t len,
+                                            uint8_t* work,
+                                            uint32_t work_len);
+uint32_t PUTINFLASH EEPROM_AT24CXX_PACKGetSize(EEPROM_AT24CXX_DEVICE* device, uint32_t address);
+uint32_t PUTINFLASH EEPROM_AT24CXX_PACKRead(EEPROM_AT24CXX_DEVICE* device,
+                                            uint32_t address,
+                                            uint8_t* data,
+                                            uint32_t data_len,
+                                            uint8_t* work,
+                                            uint32_t work_len);
+//END FUNCTION PROTOTYPES/////////////////////////////////
+#endif
@@ -0,0 +1,292 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* TYPED RECORD SERIALIZATION
+*
+* NOTE
+* -------
+*   (1) A LAYOUT DESCRIBES A C STRUCT AS A LIST OF FIELDS (OFFSET, SIZE,
+*       COUNT). Write ENCODES THE FIELDS IN LAYOUT ORDER, PACKED (NO
+*       PADDING), IN ONE PASS AND PUTS THEM ON THE BUS AS PAGE ALIGNED
+*       BLOCKS. Read DECODES STRAIGHT INTO THE STRUCT. A 40 FIELD STRUCT
+*       COSTS ITS PAGE COUNT IN BUS TRANSACTIONS, NOT 40
+*
+*   (2) SCALAR FIELDS (1 / 2 / 4 / 8 BYTES, ARRAYS OF THEM) ARE STORED
+*       BIG ENDIAN (SAME AS Write16 / Write32) OR LITTLE ENDIAN, AS THE
+*       LAYOUT SAYS, WHATEVER THE HOST ORDER. BYTES FIELDS (STRINGS,
+*       OPAQUE BLOBS) ARE STORED AS IS
+*
+*   (3) EEPROM_REC_RAW SKIPS ENCODING : THE STRUCT MEMORY ITSELF IS THE
+*       RECORD AND GOES TO / COMES FROM THE EEPROM WITH NO COPY AT ALL.
+*       ONLY PORTABLE BETWEEN BUILDS WITH THE SAME STRUCT LAYOUT
+*
+*   (4) ENCODED RECORDS PASS THROUGH ONE EEPROM_AT24CXX_REC_SCRATCH BYTE
+*       STACK BUFFER, SO RECORD SIZE IS NOT LIMITED BY IT
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#include "EEPROM_AT24CXX_REC.h"
+
+//ENCODE / DECODE STREAM
+//CHUNKS END ON EEPROM_AT24CXX_REC_SCRATCH ALIGNED ADDRESSES, SO EVERY
+//CHUNK BUT THE FIRST AND LAST IS WHOLE PAGES
+typedef struct
+{
+    EEPROM_AT24CXX_DEVICE* device;
+    uint32_t next;          //EEPROM ADDRESS OF THE NEXT CHUNK
+    uint32_t remaining;     //RECORD BYTES AFTER THE CURRENT CHUNK
+    uint16_t pos;           //NEXT BYTE IN buffer
+    uint16_t len;           //CURRENT CHUNK LENGTH
+    EEPROM_STATUS status;   //FIRST FAILED TRANSFER (OK TILL ONE FAILS)
+    uint8_t buffer[EEPROM_AT24CXX_REC_SCRATCH];
+} _EEPROM_AT24CXX_REC_STREAM;
+
+//INTERNAL FUNCTIONS//////////////////////////////////////////
+static uint8_t PUTINFLASH _eeprom_at24cxx_rec_check(EEPROM_AT24CXX_DEVICE* device, uint32_t address, const EEPROM_AT24CXX_REC_LAYOUT* layout, uint32_t* size);
+static uint8_t PUTINFLASH _eeprom_at24cxx_rec_swap(const EEPROM_AT24CXX_REC_LAYOUT* layout);
+static uint16_t PUTINFLASH _eeprom_at24cxx_rec_chunk_len(uint32_t address, uint32_t remaining);
+static void PUTINFLASH _eeprom_at24cxx_rec_put(_EEPROM_AT24CXX_REC_STREAM* stream, uint8_t byte);
+static uint8_t PUTINFLASH _eeprom_at24cxx_rec_get(_EEPROM_AT24CXX_REC_STREAM* stream);
+//END INTERNAL FUNCTIONS//////////////////////////////////////
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_RECGetSize(const EEPROM_AT24CXX_REC_LAYOUT* layout)
+{
+    //RETURN STORED SIZE OF A RECORD WITH THIS LAYOUT (0 = INVALID)
+
+    const EEPROM_AT24CXX_REC_FIELD* field;
+    uint32_t size = 0;
+    uint8_t i;
+
+    if(layout == NULL || layout->encoding > EEPROM_REC_RAW)
+    {
+        return 0;
+    }
+    if(layout->encoding == EEPROM_REC_RAW)
+    {
+        return layout->struct_size;
+    }
+    if(layout->fields == NULL)
+    {
+        return 0;
+    }
+
+    for(i = 0; i < layout->field_count; i++)
+    {
+        field = &layout->fields[i];
+        if(field->count == 0 || field->size == 0 ||
+            (uint32_t)field->offset + (uint32_t)field->size * field->count > layout->struct_size)
+        {
+            return 0;
+        }
+        if(field->type == EEPROM_REC_FIELD_SCALAR &&
+            field->size != 1 && field->size != 2 && field->size != 4 && field->size != 8)
+        {
+            return 0;
+        }
+        size += (uint32_t)field->size * field->count;
+    }
+    return size;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_RECWrite(EEPROM_AT24CXX_DEVICE* device,
+                                            uint32_t address,
+                                            const EEPROM_AT24CXX_REC_LAYOUT* layout,
+                                            const void* record)
+{
+    //ENCODE record AND WRITE IT AT BYTE ADDRESS address
+
+    _EEPROM_AT24CXX_REC_STREAM stream;
+    const EEPROM_AT24CXX_REC_FIELD* field;
+    const uint8_t* element;
+    uint32_t size;
+    uint16_t n;
+    uint16_t k;
+    uint8_t swap;
+    uint8_t i;
+
+    if(!_eeprom_at24cxx_rec_check(device, address, layout, &size))
+    {
+        return 0;
+    }
+
+    if(layout->encoding == EEPROM_REC_RAW)
+    {
+        return (EEPROM_AT24CXX_DeviceWriteBlock(device, address, ADDRESS_TYPE_BYTE, (uint8_t*)record, size) == EEPROM_STATUS_OK);
+    }
+
+    swap = _eeprom_at24cxx_rec_swap(layout);
+    stream.device = device;
+    stream.next = address;
+    stream.pos = 0;
+    stream.len = _eeprom_at24cxx_rec_chunk_len(address, size);
+    stream.remaining = size - stream.len;
+    stream.status = EEPROM_STATUS_OK;
+
+    for(i = 0; i < layout->field_count && stream.status == EEPROM_STATUS_OK; i++)
+    {
+        field = &layout->fields[i];
+        element = (const uint8_t*)record + field->offset;
+        for(n = 0; n < field->count && stream.status == EEPROM_STATUS_OK; n++)
+        {
+            for(k = 0; k < field->size; k++)
+            {
+                if(swap && field->type == EEPROM_REC_FIELD_SCALAR)
+                {
+                    _eeprom_at24cxx_rec_put(&stream, element[field->size - 1 - k]);
+                }
+                else
+                {
+                    _eeprom_at24cxx_rec_put(&stream, element[k]);
+                }
+            }
+            element += field->size;
+        }
+    }
+    return (stream.status == EEPROM_STATUS_OK);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_RECRead(EEPROM_AT24CXX_DEVICE* device,
+                                            uint32_t address,
+                                            const EEPROM_AT24CXX_REC_LAYOUT* layout,
+                                            void* record)
+{
+    //READ RECORD AT BYTE ADDRESS address AND DECODE IT INTO record
+    //STRUCT BYTES NOT COVERED BY THE LAYOUT ARE LEFT AS THEY ARE
+
+    _EEPROM_AT24CXX_REC_STREAM stream;
+    const EEPROM_AT24CXX_REC_FIELD* field;
+    uint8_t* element;
+    uint32_t size;
+    uint16_t n;
+    uint16_t k;
+    uint8_t swap;
+    uint8_t i;
+
+    if(!_eeprom_at24cxx_rec_check(device, address, layout, &size))
+    {
+        return 0;
+    }
+
+    if(layout->encoding == EEPROM_REC_RAW)
+    {
+        return (EEPROM_AT24CXX_DeviceReadBlock(device, address, ADDRESS_TYPE_BYTE, (uint8_t*)record, size) == EEPROM_STATUS_OK);
+    }
+
+    swap = _eeprom_at24cxx_rec_swap(layout);
+    stream.device = device;
+    stream.next = address;
+    stream.remaining = size;
+    stream.pos = 0;
+    stream.len = 0;
+    stream.status = EEPROM_STATUS_OK;
+
+    for(i = 0; i < layout->field_count && stream.status == EEPROM_STATUS_OK; i++)
+    {
+        field = &layout->fields[i];
+        element = (uint8_t*)record + field->offset;
+        for(n = 0; n < field->count && stream.status == EEPROM_STATUS_OK; n++)
+        {
+            for(k = 0; k < field->size; k++)
+            {
+                if(swap && field->type == EEPROM_REC_FIELD_SCALAR)
+                {
+                    element[field->size - 1 - k] = _eeprom_at24cxx_rec_get(&stream);
+                }
+                else
+                {
+                    element[k] = _eeprom_at24cxx_rec_get(&stream);
+                }
+            }
+            element += field->size;
+        }
+    }
+    return (stream.status == EEPROM_STATUS_OK);
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_rec_check(EEPROM_AT24CXX_DEVICE* device, uint32_t address, const EEPROM_AT24CXX_REC_LAYOUT* layout, uint32_t* size)
+{
+    //VALIDATE LAYOUT AND RANGE, RETURN RECORD SIZE IN size
+
+    *size = EEPROM_AT24CXX_RECGetSize(layout);
+    if(*size == 0)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : REC : Invalid layout !\n");
+        return 0;
+    }
+    if(address >= EEPROM_AT24CXX_DeviceGetSize(device) ||
+        *size > EEPROM_AT24CXX_DeviceGetSize(device) - address)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : REC : Invalid address !\n");
+        return 0;
+    }
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_rec_swap(const EEPROM_AT24CXX_REC_LAYOUT* layout)
+{
+    //RETURN 1 IF SCALARS MUST BE BYTE REVERSED BETWEEN HOST AND EEPROM
+
+    const uint16_t probe = 1;
+    uint8_t host_little = *(const uint8_t*)&probe;
+
+    return (layout->encoding == EEPROM_REC_BIG_ENDIAN) ? host_little : !host_little;
+}
+
+static uint16_t PUTINFLASH _eeprom_at24cxx_rec_chunk_len(uint32_t address, uint32_t remaining)
+{
+    //BYTES FROM address TO THE NEXT SCRATCH ALIGNED ADDRESS, AT MOST remaining
+
+    uint32_t len = EEPROM_AT24CXX_REC_SCRATCH - (address % EEPROM_AT24CXX_REC_SCRATCH);
+
+    return (uint16_t)((len < remaining) ? len : remaining);
+}
+
+static void PUTINFLASH _eeprom_at24cxx_rec_put(_EEPROM_AT24CXX_REC_STREAM* stream, uint8_t byte)
+{
+    //APPEND ENCODED BYTE, WRITE THE CHUNK OUT ONCE IT IS FULL
+    //NOTHING MORE IS WRITTEN ONCE A CHUNK WRITE HAS FAILED
+
+    if(stream->status != EEPROM_STATUS_OK)
+    {
+        return;
+    }
+    stream->buffer[stream->pos++] = byte;
+    if(stream->pos < stream->len)
+    {
+        return;
+    }
+
+    stream->status = EEPROM_AT24CXX_DeviceWriteBlock(stream->device, stream->next, ADDRESS_TYPE_BYTE, stream->buffer, stream->len);
+    stream->next += stream->len;
+    stream->len = _eeprom_at24cxx_rec_chunk_len(stream->next, stream->remaining);
+    stream->remaining -= stream->len;
+    stream->pos = 0;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_rec_get(_EEPROM_AT24CXX_REC_STREAM* stream)
+{
+    //RETURN NEXT STORED BYTE, READING THE NEXT CHUNK WHEN NEEDED
+    //ONCE A CHUNK READ HAS FAILED NOTHING MORE IS READ (0xFF RETURNED)
+
+    if(stream->status != EEPROM_STATUS_OK)
+    {
+        return 0xFF;
+    }
+    if(stream->pos == stream->len)
+    {
+        stream->len = _eeprom_at24cxx_rec_chunk_len(stream->next, stream->remaining);
+        stream->status = EEPROM_AT24CXX_DeviceReadBlock(stream->device, stream->next, ADDRESS_TYPE_BYTE, stream->buffer, stream->len);
+        if(stream->status != EEPROM_STATUS_OK)
+        {
+            return 0xFF;
+        }
+        stream->next += stream->len;
+        stream->remaining -= stream->len;
+        stream->pos = 0;
+    }
+    return stream->buffer[stream->pos++];
+}
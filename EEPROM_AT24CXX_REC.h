@@ -0,0 +1,105 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* TYPED RECORD SERIALIZATION
+*
+* NOTE
+* -------
+*   (1) A LAYOUT DESCRIBES A C STRUCT AS A LIST OF FIELDS (OFFSET, SIZE,
+*       COUNT). Write ENCODES THE FIELDS IN LAYOUT ORDER, PACKED (NO
+*       PADDING), IN ONE PASS AND PUTS THEM ON THE BUS AS PAGE ALIGNED
+*       BLOCKS. Read DECODES STRAIGHT INTO THE STRUCT. A 40 FIELD STRUCT
+*       COSTS ITS PAGE COUNT IN BUS TRANSACTIONS, NOT 40
+*
+*   (2) SCALAR FIELDS (1 / 2 / 4 / 8 BYTES, ARRAYS OF THEM) ARE STORED
+*       BIG ENDIAN (SAME AS Write16 / Write32) OR LITTLE ENDIAN, AS THE
+*       LAYOUT SAYS, WHATEVER THE HOST ORDER. BYTES FIELDS (STRINGS,
+*       OPAQUE BLOBS) ARE STORED AS IS
+*
+*   (3) EEPROM_REC_RAW SKIPS ENCODING : THE STRUCT MEMORY ITSELF IS THE
+*       RECORD AND GOES TO / COMES FROM THE EEPROM WITH NO COPY AT ALL.
+*       ONLY PORTABLE BETWEEN BUILDS WITH THE SAME STRUCT LAYOUT
+*
+*   (4) ENCODED RECORDS PASS THROUGH ONE EEPROM_AT24CXX_REC_SCRATCH BYTE
+*       STACK BUFFER, SO RECORD SIZE IS NOT LIMITED BY IT
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#ifndef _EEPROM_AT24CXX_REC_H_
+#define _EEPROM_AT24CXX_REC_H_
+
+#include <stddef.h>
+#include "EEPROM_AT24CXX.h"
+
+//ENCODE / DECODE BUFFER (STACK). POWER OF 2, MULTIPLE OF
+//EEPROM_AT24CXX_PAGE_SIZE, AT MOST 256
+#ifndef EEPROM_AT24CXX_REC_SCRATCH
+  #define EEPROM_AT24CXX_REC_SCRATCH          64
+#endif
+#if (EEPROM_AT24CXX_REC_SCRATCH & (EEPROM_AT24CXX_REC_SCRATCH - 1)) || \
+    (EEPROM_AT24CXX_REC_SCRATCH < EEPROM_AT24CXX_PAGE_SIZE) || (EEPROM_AT24CXX_REC_SCRATCH > 256)
+  #error "EEPROM : AT24CXX : REC : invalid scratch size"
+#endif
+
+//FIELD DESCRIPTORS
+//EEPROM_AT24CXX_REC_FIELD(struct_type, member)  : SCALAR (1 / 2 / 4 / 8 BYTES)
+//EEPROM_AT24CXX_REC_ARRAY(struct_type, member)  : ARRAY OF SCALARS
+//EEPROM_AT24CXX_REC_BYTES(struct_type, member)  : RAW BYTES (char[], BLOBS)
+#define _EEPROM_AT24CXX_REC_MEMBER_SIZE(t, m) sizeof(((t*)0)->m)
+#define EEPROM_AT24CXX_REC_FIELD(t, m)        { offsetof(t, m), _EEPROM_AT24CXX_REC_MEMBER_SIZE(t, m), 1, EEPROM_REC_FIELD_SCALAR }
+#define EEPROM_AT24CXX_REC_ARRAY(t, m)        { offsetof(t, m), sizeof(((t*)0)->m[0]), \
+                                                _EEPROM_AT24CXX_REC_MEMBER_SIZE(t, m) / sizeof(((t*)0)->m[0]), \
+                                                EEPROM_REC_FIELD_SCALAR }
+#define EEPROM_AT24CXX_REC_BYTES(t, m)        { offsetof(t, m), _EEPROM_AT24CXX_REC_MEMBER_SIZE(t, m), 1, EEPROM_REC_FIELD_BYTES }
+
+//CUSTOM VARIABLE STRUCTURES/////////////////////////////
+typedef enum
+{
+    EEPROM_REC_FIELD_SCALAR = 0,
+    EEPROM_REC_FIELD_BYTES
+} EEPROM_REC_FIELD_TYPE;
+
+typedef enum
+{
+    EEPROM_REC_BIG_ENDIAN = 0,
+    EEPROM_REC_LITTLE_ENDIAN,
+    EEPROM_REC_RAW
+} EEPROM_REC_ENCODING;
+
+typedef struct
+{
+    uint16_t offset;    //offsetof IN THE STRUCT
+    uint16_t size;      //ELEMENT SIZE (SCALAR : 1 / 2 / 4 / 8)
+    uint16_t count;     //ELEMENTS
+    uint8_t type;       //EEPROM_REC_FIELD_TYPE
+} EEPROM_AT24CXX_REC_FIELD;
+
+typedef struct
+{
+    const EEPROM_AT24CXX_REC_FIELD* fields;
+    uint8_t field_count;
+    EEPROM_REC_ENCODING encoding;
+    uint16_t struct_size;   //sizeof THE STRUCT (EEPROM_REC_RAW RECORD SIZE)
+} EEPROM_AT24CXX_REC_LAYOUT;
+//END CUSTOM VARIABLE STRUCTURES/////////////////////////
+
+//FUNCTION PROTOTYPES/////////////////////////////////////
+//address IS A DEVICE BYTE ADDRESS. GetSize RETURNS THE STORED RECORD
+//SIZE IN BYTES (0 = INVALID LAYOUT), Write / Read RETURN 1 ON SUCCESS,
+//0 ON AN INVALID LAYOUT OR RANGE OR A FAILED TRANSFER (SEE
+//DeviceGetLastStatus). A FAILED Read MAY LEAVE record PARTLY FILLED
+uint32_t PUTINFLASH EEPROM_AT24CXX_RECGetSize(const EEPROM_AT24CXX_REC_LAYOUT* layout);
+uint8_t PUTINFLASH EEPROM_AT24CXX_RECWrite(EEPROM_AT24CXX_DEVICE* device,
+                                            uint32_t address,
+                                            const EEPROM_AT24CXX_REC_LAYOUT* layout,
+                                            const void* record);
+uint8_t PUTINFLASH EEPROM_AT24CXX_RECRead(EEPROM_AT24CXX_DEVICE* device,
+                                            uint32_t address,
+                                            const EEPROM_AT24CXX_REC_LAYOUT* layout,
+                                            void* record);
+//END FUNCTION PROTOTYPES/////////////////////////////////
+#endif
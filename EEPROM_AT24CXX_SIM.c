@@ -0,0 +1,409 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* HOST SIDE SIMULATED EEPROM (LINUX / MAC)
+*
+* NOTE
+* -------
+*   (1) EEPROM CONTENT LIVES IN A FILE MAPPED INTO MEMORY, SO IT
+*       SURVIVES ACROSS RUNS AND CAN BE INSPECTED WITH A HEX DUMP
+*
+*   (2) MODELS THE BEHAVIOUR THE DRIVER HAS TO DEAL WITH
+*       - PAGE WRITE ROLLOVER (WRAP INSIDE THE PAGE)
+*       - READ ROLLOVER (WRAP FROM LAST BYTE TO FIRST)
+*       - WRITE CYCLE (tWR) : DEVICE NACKS ITS ADDRESS TILL IT IS OVER,
+*         WRITES ARE DROPPED AND READS RETURN 0xFF
+*       - BUS TIME OF EVERY TRANSFER AT THE SET BIT RATE
+*       - MARGINAL WIRING : ABOVE THE RATE SET WITH SimSetMaxStableSpeed
+*         EVERY 4TH TRANSFER TO THE DEVICE FAILS WITH A BUS ERROR
+*
+*   (3) ALL SIMULATED DEVICES SHARE ONE BUS AND ONE SIMULATED CLOCK.
+*       THE CLOCK ONLY MOVES WITH BUS TRAFFIC AND SimDelayUs, SO RUNS
+*       ARE REPRODUCIBLE. BUILD THE LIBRARY WITH EEPROM_AT24CXX_SIM_TIME
+*       SO ITS DELAYS GO THROUGH SimDelayUs
+*
+*   (4) DEVICES ARE PICKED BY I2C ADDRESS, LIKE ON A REAL BUS. PARTS
+*       WIDER THAN THEIR WORD ADDRESS (AT24C04 ... C16, AT24CM01) ANSWER
+*       ON SEVERAL ADDRESSES AND TAKE THE HIGH MEMORY ADDRESS BITS FROM
+*       THE LOW I2C ADDRESS BITS
+*
+*   (5) SimSetBusSpeed HAS THE SIGNATURE OF AN I2C CLOCK FUNCTION, SO
+*       IT CAN BE HANDED TO EEPROM_AT24CXX_SetI2CClockFunction
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#include "EEPROM_AT24CXX_SIM.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//BIT TIMES OF THE BUS CONDITIONS AROUND THE DATA BYTES
+//EVERY BYTE IS 8 DATA BITS + ACK
+#define _EEPROM_AT24CXX_SIM_BYTE_BITS     9
+#define _EEPROM_AT24CXX_SIM_START_BITS    1
+#define _EEPROM_AT24CXX_SIM_STOP_BITS     1
+
+//LOCAL LIBRARY VARIABLES/////////////////////////////////////
+static EEPROM_AT24CXX_SIM* _eeprom_at24cxx_sim_device[EEPROM_AT24CXX_SIM_MAX_DEVICES];
+static uint32_t _eeprom_at24cxx_sim_bus_hz = EEPROM_AT24CXX_SIM_BUS_HZ;
+static uint64_t _eeprom_at24cxx_sim_time_ns;
+
+//INTERNAL FUNCTIONS//////////////////////////////////////////
+static EEPROM_AT24CXX_SIM* PUTINFLASH _eeprom_at24cxx_sim_select(uint8_t i2c_address, uint32_t bits);
+static void PUTINFLASH _eeprom_at24cxx_sim_clock_bits(EEPROM_AT24CXX_SIM* sim, uint32_t bits);
+static uint8_t PUTINFLASH _eeprom_at24cxx_sim_glitch(EEPROM_AT24CXX_SIM* sim);
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_sim_write(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data, uint8_t len);
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_sim_read(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data, uint8_t len);
+//END INTERNAL FUNCTIONS//////////////////////////////////////
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_SimOpen(EEPROM_AT24CXX_SIM* sim,
+                                            const char* path,
+                                            uint8_t i2c_address,
+                                            uint32_t size,
+                                            uint16_t page_size,
+                                            uint32_t write_cycle_us)
+{
+    //OPEN (OR CREATE, FILLED WITH 0xFF) THE BACKING FILE, MAP IT AND
+    //PUT THE DEVICE ON THE SIMULATED BUS
+    //size AND page_size MUST BE POWERS OF 2
+    //RETURN 1 ON SUCCESS
+
+    struct stat st;
+    uint32_t word_size;
+    uint8_t block_mask;
+    uint8_t i;
+    uint8_t slot = EEPROM_AT24CXX_SIM_MAX_DEVICES;
+
+    if(size == 0 || (size & (size - 1)) || page_size == 0 || (page_size & (page_size - 1)) ||
+        size / page_size > EEPROM_AT24CXX_SIM_MAX_PAGES)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : SIM : Invalid geometry !\n");
+        return 0;
+    }
+
+    //ONE WORD ADDRESS BYTE UP TO 2KB (AS THE DRIVER), ANY REST OF THE
+    //MEMORY ADDRESS COMES FROM THE I2C ADDRESS
+    word_size = (size <= 2048) ? 256 : 65536;
+    block_mask = (size > word_size) ? (uint8_t)(size / word_size - 1) : 0;
+    i2c_address &= ~block_mask;
+
+    for(i = 0; i < EEPROM_AT24CXX_SIM_MAX_DEVICES; i++)
+    {
+        if(_eeprom_at24cxx_sim_device[i] != NULL &&
+            (_eeprom_at24cxx_sim_device[i]->i2c_address & ~(block_mask | _eeprom_at24cxx_sim_device[i]->block_mask)) ==
+            (i2c_address & ~(block_mask | _eeprom_at24cxx_sim_device[i]->block_mask)))
+        {
+            EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : SIM : address 0x%02X already in use !\n", i2c_address);
+            return 0;
+        }
+        if(_eeprom_at24cxx_sim_device[i] == NULL && slot == EEPROM_AT24CXX_SIM_MAX_DEVICES)
+        {
+            slot = i;
+        }
+    }
+    if(slot == EEPROM_AT24CXX_SIM_MAX_DEVICES)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : SIM : too many devices !\n");
+        return 0;
+    }
+
+    sim->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if(sim->fd < 0)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : SIM : cannot open %s !\n", path);
+        return 0;
+    }
+    if(fstat(sim->fd, &st) != 0 || (st.st_size != (off_t)size && ftruncate(sim->fd, size) != 0))
+    {
+        close(sim->fd);
+        return 0;
+    }
+
+    sim->memory = (uint8_t*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, sim->fd, 0);
+    if(sim->memory == MAP_FAILED)
+    {
+        close(sim->fd);
+        return 0;
+    }
+
+    //NEW FILE : ERASED EEPROM
+    if(st.st_size != (off_t)size)
+    {
+        memset(sim->memory, 0xFF, size);
+    }
+
+    sim->i2c_address = i2c_address;
+    sim->block_mask = block_mask;
+    sim->size = size;
+    sim->page_size = page_size;
+    sim->write_cycle_us = write_cycle_us;
+    sim->busy_until_ns = 0;
+    sim->max_stable_hz = 0;
+    sim->glitch_count = 0;
+    EEPROM_AT24CXX_SimResetStats(sim);
+
+    _eeprom_at24cxx_sim_device[slot] = sim;
+    return 1;
+}
+
+void PUTINFLASH EEPROM_AT24CXX_SimClose(EEPROM_AT24CXX_SIM* sim)
+{
+    //TAKE DEVICE OFF THE BUS, SYNC AND UNMAP THE BACKING FILE
+
+    uint8_t i;
+
+    for(i = 0; i < EEPROM_AT24CXX_SIM_MAX_DEVICES; i++)
+    {
+        if(_eeprom_at24cxx_sim_device[i] == sim)
+        {
+            _eeprom_at24cxx_sim_device[i] = NULL;
+        }
+    }
+
+    msync(sim->memory, sim->size, MS_SYNC);
+    munmap(sim->memory, sim->size);
+    close(sim->fd);
+    sim->memory = NULL;
+}
+
+void PUTINFLASH EEPROM_AT24CXX_SimSetBusSpeed(uint32_t bus_hz)
+{
+    //SET SIMULATED I2C BIT RATE (100000, 400000, 1000000 ...)
+
+    if(bus_hz > 0)
+    {
+        _eeprom_at24cxx_sim_bus_hz = bus_hz;
+    }
+}
+
+void PUTINFLASH EEPROM_AT24CXX_SimSetMaxStableSpeed(EEPROM_AT24CXX_SIM* sim, uint32_t max_hz)
+{
+    //SET THE FASTEST BIT RATE THE DEVICE'S WIRING HANDLES CLEANLY
+    //0 = ANY RATE IS FINE
+
+    sim->max_stable_hz = max_hz;
+    sim->glitch_count = 0;
+}
+
+void PUTINFLASH EEPROM_AT24CXX_SimAttach(EEPROM_AT24CXX_DEVICE* device)
+{
+    //POINT ALL I2C, ACK POLL AND TIME FUNCTIONS OF A DRIVER DEVICE AT
+    //THE SIMULATED BUS
+
+    EEPROM_AT24CXX_DeviceSetI2CFunctions(device,
+                                        EEPROM_AT24CXX_SimI2CInit,
+                                        EEPROM_AT24CXX_SimI2CWriteByte,
+                                        EEPROM_AT24CXX_SimI2CWriteByteMultiple,
+                                        EEPROM_AT24CXX_SimI2CReadByte,
+                                        EEPROM_AT24CXX_SimI2CReadByteMultiple);
+    EEPROM_AT24CXX_DeviceSetI2CAckPollFunction(device, EEPROM_AT24CXX_SimI2CAckPoll);
+    EEPROM_AT24CXX_DeviceSetTimeFunction(device, EEPROM_AT24CXX_SimGetTimeUs);
+}
+
+void PUTINFLASH EEPROM_AT24CXX_SimResetStats(EEPROM_AT24CXX_SIM* sim)
+{
+    //CLEAR ALL COUNTERS OF THE DEVICE
+
+    memset(&sim->stats, 0, sizeof(sim->stats));
+}
+
+uint64_t PUTINFLASH EEPROM_AT24CXX_SimGetTimeNs(void)
+{
+    //RETURN SIMULATED CLOCK IN NANOSECONDS
+
+    return _eeprom_at24cxx_sim_time_ns;
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_SimGetTimeUs(void)
+{
+    //RETURN SIMULATED CLOCK IN MICROSECONDS (WRAPS LIKE A HARDWARE TIMER)
+
+    return (uint32_t)(_eeprom_at24cxx_sim_time_ns / 1000);
+}
+
+void PUTINFLASH EEPROM_AT24CXX_SimDelayUs(uint32_t us)
+{
+    //ADVANCE SIMULATED CLOCK
+
+    _eeprom_at24cxx_sim_time_ns += (uint64_t)us * 1000;
+}
+
+void PUTINFLASH EEPROM_AT24CXX_SimI2CInit(void)
+{
+    //NOTHING TO SET UP ON THE SIMULATED BUS
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SimI2CWriteByte(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t data)
+{
+    return _eeprom_at24cxx_sim_write(i2c_address, address, address_bytes, &data, 1);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SimI2CWriteByteMultiple(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data, uint8_t len)
+{
+    return _eeprom_at24cxx_sim_write(i2c_address, address, address_bytes, data, len);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SimI2CReadByte(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data)
+{
+    return _eeprom_at24cxx_sim_read(i2c_address, address, address_bytes, data, 1);
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SimI2CReadByteMultiple(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data, uint8_t len)
+{
+    return _eeprom_at24cxx_sim_read(i2c_address, address, address_bytes, data, len);
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_SimI2CAckPoll(uint8_t i2c_address)
+{
+    //START + DEVICE ADDRESS + STOP
+    //RETURN 1 IF DEVICE ACKS
+
+    return (_eeprom_at24cxx_sim_select(i2c_address, _EEPROM_AT24CXX_SIM_START_BITS +
+                                                    _EEPROM_AT24CXX_SIM_BYTE_BITS +
+                                                    _EEPROM_AT24CXX_SIM_STOP_BITS) != NULL);
+}
+
+static EEPROM_AT24CXX_SIM* PUTINFLASH _eeprom_at24cxx_sim_select(uint8_t i2c_address, uint32_t bits)
+{
+    //ADDRESS A DEVICE, CLOCKING bits BITS IF IT ACKS OR JUST THE
+    //ADDRESS BYTE IF IT DOES NOT (ABSENT OR IN A WRITE CYCLE)
+    //RETURN DEVICE IF IT ACKED
+
+    EEPROM_AT24CXX_SIM* sim = NULL;
+    uint8_t i;
+
+    for(i = 0; i < EEPROM_AT24CXX_SIM_MAX_DEVICES; i++)
+    {
+        if(_eeprom_at24cxx_sim_device[i] != NULL &&
+            (i2c_address & ~_eeprom_at24cxx_sim_device[i]->block_mask) == _eeprom_at24cxx_sim_device[i]->i2c_address)
+        {
+            sim = _eeprom_at24cxx_sim_device[i];
+            break;
+        }
+    }
+
+    if(sim == NULL)
+    {
+        _eeprom_at24cxx_sim_clock_bits(NULL, _EEPROM_AT24CXX_SIM_START_BITS + _EEPROM_AT24CXX_SIM_BYTE_BITS + _EEPROM_AT24CXX_SIM_STOP_BITS);
+        return NULL;
+    }
+
+    sim->stats.transactions++;
+    if(_eeprom_at24cxx_sim_time_ns < sim->busy_until_ns)
+    {
+        sim->stats.nacks++;
+        _eeprom_at24cxx_sim_clock_bits(sim, _EEPROM_AT24CXX_SIM_START_BITS + _EEPROM_AT24CXX_SIM_BYTE_BITS + _EEPROM_AT24CXX_SIM_STOP_BITS);
+        return NULL;
+    }
+
+    _eeprom_at24cxx_sim_clock_bits(sim, bits);
+    return sim;
+}
+
+static void PUTINFLASH _eeprom_at24cxx_sim_clock_bits(EEPROM_AT24CXX_SIM* sim, uint32_t bits)
+{
+    //ADVANCE SIMULATED CLOCK BY THE TIME TO CLOCK bits BITS
+
+    uint64_t ns;
+
+    ns = ((uint64_t)bits * 1000000000) / _eeprom_at24cxx_sim_bus_hz;
+    _eeprom_at24cxx_sim_time_ns += ns;
+    if(sim != NULL)
+    {
+        sim->stats.bus_time_ns += ns;
+    }
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_sim_glitch(EEPROM_AT24CXX_SIM* sim)
+{
+    //RETURN 1 IF THIS TRANSFER TO AN ACKING DEVICE IS CORRUPTED BY
+    //RUNNING THE BUS ABOVE ITS STABLE RATE
+
+    if(sim->max_stable_hz == 0 || _eeprom_at24cxx_sim_bus_hz <= sim->max_stable_hz)
+    {
+        return 0;
+    }
+    if((++sim->glitch_count & 3) != 0)
+    {
+        return 0;
+    }
+    sim->stats.bus_errors++;
+    return 1;
+}
+
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_sim_write(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data, uint8_t len)
+{
+    //START, DEVICE ADDRESS, WORD ADDRESS, DATA, STOP
+    //DATA WRAPS INSIDE THE ADDRESSED PAGE (WRITE ROLLOVER). THE WRITE
+    //CYCLE STARTS AT THE STOP CONDITION. A CORRUPTED WRITE IS DROPPED
+
+    EEPROM_AT24CXX_SIM* sim;
+    uint32_t page_base;
+    uint32_t i;
+
+    sim = _eeprom_at24cxx_sim_select(i2c_address, _EEPROM_AT24CXX_SIM_START_BITS +
+                                                    (1 + address_bytes + len) * _EEPROM_AT24CXX_SIM_BYTE_BITS +
+                                                    _EEPROM_AT24CXX_SIM_STOP_BITS);
+    if(sim == NULL)
+    {
+        return EEPROM_STATUS_NACK;
+    }
+    if(_eeprom_at24cxx_sim_glitch(sim))
+    {
+        return EEPROM_STATUS_BUS_ERROR;
+    }
+
+    address |= (uint32_t)(i2c_address & sim->block_mask) << (8 * address_bytes);
+    address &= sim->size - 1;
+    page_base = address & ~((uint32_t)sim->page_size - 1);
+    for(i = 0; i < len; i++)
+    {
+        sim->memory[page_base + ((address + i) & (sim->page_size - 1))] = data[i];
+    }
+
+    sim->stats.bytes_written += len;
+    sim->stats.page_programs++;
+    sim->stats.page_program_count[address / sim->page_size]++;
+    sim->busy_until_ns = _eeprom_at24cxx_sim_time_ns + (uint64_t)sim->write_cycle_us * 1000;
+    return EEPROM_STATUS_OK;
+}
+
+static EEPROM_STATUS PUTINFLASH _eeprom_at24cxx_sim_read(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data, uint8_t len)
+{
+    //START, DEVICE ADDRESS (W), WORD ADDRESS, REPEATED START, DEVICE
+    //ADDRESS (R), DATA, STOP
+    //DATA WRAPS FROM THE LAST BYTE TO THE FIRST (READ ROLLOVER)
+    //A NACKED OR CORRUPTED READ RETURNS 0xFF (BUS PULLED UP)
+
+    EEPROM_AT24CXX_SIM* sim;
+    uint32_t i;
+
+    sim = _eeprom_at24cxx_sim_select(i2c_address, _EEPROM_AT24CXX_SIM_START_BITS +
+                                                    (1 + address_bytes) * _EEPROM_AT24CXX_SIM_BYTE_BITS +
+                                                    _EEPROM_AT24CXX_SIM_START_BITS +
+                                                    (1 + len) * _EEPROM_AT24CXX_SIM_BYTE_BITS +
+                                                    _EEPROM_AT24CXX_SIM_STOP_BITS);
+    if(sim == NULL)
+    {
+        memset(data, 0xFF, len);
+        return EEPROM_STATUS_NACK;
+    }
+    if(_eeprom_at24cxx_sim_glitch(sim))
+    {
+        memset(data, 0xFF, len);
+        return EEPROM_STATUS_BUS_ERROR;
+    }
+
+    address |= (uint32_t)(i2c_address & sim->block_mask) << (8 * address_bytes);
+    for(i = 0; i < len; i++)
+    {
+        data[i] = sim->memory[(address + i) & (sim->size - 1)];
+    }
+    sim->stats.bytes_read += len;
+    return EEPROM_STATUS_OK;
+}
@@ -0,0 +1,107 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* HOST SIDE SIMULATED EEPROM (LINUX / MAC)
+*
+* NOTE
+* -------
+*   (1) EEPROM CONTENT LIVES IN A FILE MAPPED INTO MEMORY, SO IT
+*       SURVIVES ACROSS RUNS AND CAN BE INSPECTED WITH A HEX DUMP
+*
+*   (2) MODELS THE BEHAVIOUR THE DRIVER HAS TO DEAL WITH
+*       - PAGE WRITE ROLLOVER (WRAP INSIDE THE PAGE)
+*       - READ ROLLOVER (WRAP FROM LAST BYTE TO FIRST)
+*       - WRITE CYCLE (tWR) : DEVICE NACKS ITS ADDRESS TILL IT IS OVER,
+*         WRITES ARE DROPPED AND READS RETURN 0xFF
+*       - BUS TIME OF EVERY TRANSFER AT THE SET BIT RATE
+*       - MARGINAL WIRING : ABOVE THE RATE SET WITH SimSetMaxStableSpeed
+*         EVERY 4TH TRANSFER TO THE DEVICE FAILS WITH A BUS ERROR
+*
+*   (3) ALL SIMULATED DEVICES SHARE ONE BUS AND ONE SIMULATED CLOCK.
+*       THE CLOCK ONLY MOVES WITH BUS TRAFFIC AND SimDelayUs, SO RUNS
+*       ARE REPRODUCIBLE. BUILD THE LIBRARY WITH EEPROM_AT24CXX_SIM_TIME
+*       SO ITS DELAYS GO THROUGH SimDelayUs
+*
+*   (4) DEVICES ARE PICKED BY I2C ADDRESS, LIKE ON A REAL BUS
+*
+*   (5) SimSetBusSpeed HAS THE SIGNATURE OF AN I2C CLOCK FUNCTION, SO
+*       IT CAN BE HANDED TO EEPROM_AT24CXX_SetI2CClockFunction
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#ifndef _EEPROM_AT24CXX_SIM_H_
+#define _EEPROM_AT24CXX_SIM_H_
+
+#include "EEPROM_AT24CXX.h"
+
+//MAXIMUM SIMULATED DEVICES ON THE BUS
+#define EEPROM_AT24CXX_SIM_MAX_DEVICES        8
+
+//MAXIMUM PAGES TRACKED FOR PER PAGE WEAR COUNTS
+#define EEPROM_AT24CXX_SIM_MAX_PAGES          4096
+
+//DEFAULTS
+#define EEPROM_AT24CXX_SIM_BUS_HZ             400000
+#define EEPROM_AT24CXX_SIM_WRITE_CYCLE_US     5000
+
+//CUSTOM VARIABLE STRUCTURES/////////////////////////////
+typedef struct
+{
+    uint32_t transactions;    //ADDRESSED TRANSFERS (INCLUDING NACKED ONES)
+    uint32_t nacks;           //TRANSFERS NACKED BECAUSE OF A WRITE CYCLE
+    uint32_t bytes_written;
+    uint32_t bytes_read;
+    uint32_t page_programs;   //WRITE CYCLES STARTED
+    uint32_t bus_errors;      //TRANSFERS CORRUPTED ABOVE max_stable_hz
+    uint64_t bus_time_ns;     //TIME SPENT CLOCKING THE BUS
+    uint32_t page_program_count[EEPROM_AT24CXX_SIM_MAX_PAGES];
+} EEPROM_AT24CXX_SIM_STATS;
+
+typedef struct
+{
+    uint8_t i2c_address;      //BASE ADDRESS (BLOCK BITS CLEAR)
+    uint8_t block_mask;       //I2C ADDRESS BITS CARRYING MEMORY ADDRESS BITS
+    uint32_t size;
+    uint16_t page_size;
+    uint32_t write_cycle_us;
+    int fd;
+    uint8_t* memory;
+    uint64_t busy_until_ns;   //WRITE CYCLE END ON SIMULATED CLOCK
+    uint32_t max_stable_hz;   //0 = STABLE AT ANY RATE
+    uint32_t glitch_count;
+    EEPROM_AT24CXX_SIM_STATS stats;
+} EEPROM_AT24CXX_SIM;
+//END CUSTOM VARIABLE STRUCTURES/////////////////////////
+
+//FUNCTION PROTOTYPES/////////////////////////////////////
+//CONFIGURATION FUNCTIONS
+uint8_t PUTINFLASH EEPROM_AT24CXX_SimOpen(EEPROM_AT24CXX_SIM* sim,
+                                            const char* path,
+                                            uint8_t i2c_address,
+                                            uint32_t size,
+                                            uint16_t page_size,
+                                            uint32_t write_cycle_us);
+void PUTINFLASH EEPROM_AT24CXX_SimClose(EEPROM_AT24CXX_SIM* sim);
+void PUTINFLASH EEPROM_AT24CXX_SimSetBusSpeed(uint32_t bus_hz);
+void PUTINFLASH EEPROM_AT24CXX_SimSetMaxStableSpeed(EEPROM_AT24CXX_SIM* sim, uint32_t max_hz);
+void PUTINFLASH EEPROM_AT24CXX_SimAttach(EEPROM_AT24CXX_DEVICE* device);
+void PUTINFLASH EEPROM_AT24CXX_SimResetStats(EEPROM_AT24CXX_SIM* sim);
+
+//SIMULATED CLOCK
+uint64_t PUTINFLASH EEPROM_AT24CXX_SimGetTimeNs(void);
+uint32_t PUTINFLASH EEPROM_AT24CXX_SimGetTimeUs(void);
+void PUTINFLASH EEPROM_AT24CXX_SimDelayUs(uint32_t us);
+
+//I2C FUNCTIONS (SAME SIGNATURES AS EEPROM_AT24CXX_SetI2CFunctions)
+void PUTINFLASH EEPROM_AT24CXX_SimI2CInit(void);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SimI2CWriteByte(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t data);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SimI2CWriteByteMultiple(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data, uint8_t len);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SimI2CReadByte(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_SimI2CReadByteMultiple(uint8_t i2c_address, uint32_t address, uint8_t address_bytes, uint8_t* data, uint8_t len);
+uint8_t PUTINFLASH EEPROM_AT24CXX_SimI2CAckPoll(uint8_t i2c_address);
+//END FUNCTION PROTOTYPES/////////////////////////////////
+#endif
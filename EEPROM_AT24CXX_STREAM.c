@@ -0,0 +1,408 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* SEQUENTIAL STREAM CURSORS
+*
+* NOTE
+* -------
+*   (1) A STREAM IS A READ OR WRITE CURSOR OVER A BYTE RANGE OF ONE
+*       DEVICE (UP TO THE WHOLE CHIP). Read / Write TAKE ANY LENGTH,
+*       Seek / Tell MOVE THE CURSOR. THE CALLER NEVER DEALS WITH PAGES,
+*       BLOCKS OR THE 255 BYTE TRANSFER LIMIT
+*
+*   (2) DOUBLE BUFFERED : DATA MOVES IN EEPROM_AT24CXX_STREAM_BLOCK
+*       ALIGNED BLOCKS THROUGH TWO BUFFERS IN THE STREAM. A FULL WRITE
+*       BLOCK IS QUEUED ON THE DEVICE (WriteAsync) AND THE CALLER GOES ON
+*       FILLING THE OTHER ONE WHILE IT COMMITS, SO CPU WORK (COMPRESSION,
+*       CRC) OVERLAPS THE WRITE CYCLE. A READ QUEUES THE NEXT BLOCK AS
+*       SOON AS THE CURSOR ENTERS THE CURRENT ONE (READ AHEAD)
+*
+*   (3) A Read OF AT LEAST TWO BLOCKS THAT NOTHING BUFFERED COVERS GOES
+*       STRAIGHT INTO THE CALLER'S BUFFER AS ONE SEQUENTIAL READ (THE
+*       CHIP AUTO INCREMENTS ACROSS PAGES, ONLY THE ADDRESS BLOCK BITS
+*       OF PARTS UP TO C16 SPLIT IT), WITH NO COPY
+*
+*   (4) WITHOUT EEPROM_AT24CXX_THREAD_SAFE THE CALLER IS THE BUS OWNER :
+*       EVERY Read / Write ALSO RUNS ONE Tick, AND A BUFFER STILL IN
+*       FLIGHT WHEN IT IS NEEDED AGAIN IS WAITED FOR (WaitRequest). KEEP
+*       CALLING Tick FROM THE MAIN LOOP SO BLOCKS COMMIT BETWEEN CALLS.
+*       WITH THREADS THE BUS OWNER THREAD RUNS THE QUEUE
+*
+*   (5) SIZE THE BLOCK TO AT LEAST THE WRITE PAGE OF THE PART. A BLOCK
+*       SMALLER THAN THE PAGE IS A PARTIAL PAGE WRITE AND COSTS A FULL
+*       WRITE CYCLE. WITH THE PAGE CACHE ON, WRITE BLOCKS LAND IN THE
+*       CACHE AND ITS WRITE BACK DECIDES WHEN THE PAGES COMMIT
+*
+*   (6) THE FIRST FAILED TRANSFER STOPS THE STREAM : Read / Write RETURN
+*       SHORT AND Sync / Close / GetStatus GIVE THE STATUS TILL THE
+*       STREAM IS OPENED AGAIN. Sync COMMITS A PARTLY FILLED BLOCK AND
+*       FLUSHES THE PAGE CACHE. DATA WRITTEN TO THE RANGE OUTSIDE A READ
+*       STREAM IS NOT SEEN IN BLOCKS IT HAS ALREADY BUFFERED
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#include "EEPROM_AT24CXX_STREAM.h"
+
+//INTERNAL FUNCTIONS//////////////////////////////////////////
+static uint32_t PUTINFLASH _eeprom_at24cxx_stream_block_end(EEPROM_AT24CXX_STREAM* stream, uint32_t address);
+static uint8_t PUTINFLASH _eeprom_at24cxx_stream_covers(EEPROM_AT24CXX_STREAM* stream, uint8_t n, uint32_t address);
+static void PUTINFLASH _eeprom_at24cxx_stream_submit(EEPROM_AT24CXX_STREAM* stream, uint8_t n, uint32_t address, uint16_t len);
+static void PUTINFLASH _eeprom_at24cxx_stream_wait(EEPROM_AT24CXX_STREAM* stream, uint8_t n);
+static void PUTINFLASH _eeprom_at24cxx_stream_fetch(EEPROM_AT24CXX_STREAM* stream, uint8_t n, uint32_t address);
+static void PUTINFLASH _eeprom_at24cxx_stream_commit(EEPROM_AT24CXX_STREAM* stream);
+static void PUTINFLASH _eeprom_at24cxx_stream_pump(EEPROM_AT24CXX_STREAM* stream);
+//END INTERNAL FUNCTIONS//////////////////////////////////////
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_StreamOpen(EEPROM_AT24CXX_STREAM* stream,
+                                                    EEPROM_AT24CXX_DEVICE* device,
+                                                    EEPROM_STREAM_MODE mode,
+                                                    uint32_t address,
+                                                    uint32_t len)
+{
+    //SET UP A CURSOR AT THE START OF THE RANGE
+    //A READ STREAM QUEUES ITS FIRST TWO BLOCKS RIGHT AWAY
+
+    if(device == NULL || mode >= EEPROM_STREAM_MAX || len == 0 ||
+        address >= EEPROM_AT24CXX_DeviceGetSize(device) ||
+        len > EEPROM_AT24CXX_DeviceGetSize(device) - address)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : STREAM : Invalid range !\n");
+        return EEPROM_STATUS_INVALID;
+    }
+
+    stream->device = device;
+    stream->mode = mode;
+    stream->start = address;
+    stream->end = address + len;
+    stream->position = address;
+    stream->status = EEPROM_STATUS_OK;
+    stream->current = 0;
+    stream->pending[0] = 0;
+    stream->pending[1] = 0;
+    stream->block_len[0] = 0;
+    stream->block_len[1] = 0;
+
+    if(mode == EEPROM_STREAM_READ)
+    {
+        _eeprom_at24cxx_stream_fetch(stream, 0, address);
+        _eeprom_at24cxx_stream_fetch(stream, 1, _eeprom_at24cxx_stream_block_end(stream, address));
+    }
+    return EEPROM_STATUS_OK;
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_StreamRead(EEPROM_AT24CXX_STREAM* stream, uint8_t* data, uint32_t len)
+{
+    //READ UP TO len BYTES AT THE CURSOR AND MOVE IT ON
+
+    uint32_t done = 0;
+    uint32_t chunk_len;
+    uint8_t n;
+
+    if(stream->mode != EEPROM_STREAM_READ)
+    {
+        return 0;
+    }
+    _eeprom_at24cxx_stream_pump(stream);
+
+    while(done < len && stream->position < stream->end && stream->status == EEPROM_STATUS_OK)
+    {
+        n = stream->current;
+        if(!_eeprom_at24cxx_stream_covers(stream, n, stream->position))
+        {
+            n ^= 1;
+            if(!_eeprom_at24cxx_stream_covers(stream, n, stream->position))
+            {
+                //NOTHING BUFFERED HERE (START, SEEK OR AFTER A LONG READ)
+                chunk_len = len - done;
+                if(chunk_len > stream->end - stream->position)
+                {
+                    chunk_len = stream->end - stream->position;
+                }
+                if(chunk_len >= 2 * EEPROM_AT24CXX_STREAM_BLOCK)
+                {
+                    //LONG READ : STRAIGHT INTO data, ENDING ON A BLOCK
+                    //BOUNDARY SO READ AHEAD PICKS UP WHOLE BLOCKS AFTER IT
+                    chunk_len -= (stream->position + chunk_len) % EEPROM_AT24CXX_STREAM_BLOCK;
+                    stream->status = EEPROM_AT24CXX_DeviceReadBlock(stream->device, stream->position, ADDRESS_TYPE_BYTE, data + done, chunk_len);
+                    if(stream->status != EEPROM_STATUS_OK)
+                    {
+                        break;
+                    }
+                    stream->position += chunk_len;
+                    done += chunk_len;
+                    continue;
+                }
+                n = stream->current;
+                _eeprom_at24cxx_stream_fetch(stream, n, stream->position);
+            }
+            stream->current = n;
+
+            //READ AHEAD : NEXT BLOCK INTO THE OTHER BUFFER
+            if(!_eeprom_at24cxx_stream_covers(stream, n ^ 1, stream->block_address[n] + stream->block_len[n]))
+            {
+                _eeprom_at24cxx_stream_fetch(stream, n ^ 1, stream->block_address[n] + stream->block_len[n]);
+            }
+        }
+
+        _eeprom_at24cxx_stream_wait(stream, n);
+        if(stream->status != EEPROM_STATUS_OK)
+        {
+            break;
+        }
+        chunk_len = stream->block_address[n] + stream->block_len[n] - stream->position;
+        if(chunk_len > len - done)
+        {
+            chunk_len = len - done;
+        }
+        MEMCPY(data + done, &stream->buffer[n][stream->position - stream->block_address[n]], chunk_len);
+        stream->position += chunk_len;
+        done += chunk_len;
+    }
+    return done;
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_StreamWrite(EEPROM_AT24CXX_STREAM* stream, uint8_t* data, uint32_t len)
+{
+    //WRITE UP TO len BYTES AT THE CURSOR AND MOVE IT ON
+    //A BLOCK IS QUEUED AS SOON AS IT IS FULL
+
+    uint32_t done = 0;
+    uint32_t chunk_len;
+    uint8_t n;
+
+    if(stream->mode != EEPROM_STREAM_WRITE)
+    {
+        return 0;
+    }
+    _eeprom_at24cxx_stream_pump(stream);
+
+    while(done < len && stream->position < stream->end && stream->status == EEPROM_STATUS_OK)
+    {
+        n = stream->current;
+        if(stream->block_len[n] == 0)
+        {
+            //BUFFER MAY STILL BE COMMITTING THE BLOCK BEFORE LAST
+            _eeprom_at24cxx_stream_wait(stream, n);
+            if(stream->status != EEPROM_STATUS_OK)
+            {
+                break;
+            }
+            stream->block_address[n] = stream->position;
+        }
+
+        chunk_len = _eeprom_at24cxx_stream_block_end(stream, stream->position) - stream->position;
+        if(chunk_len > len - done)
+        {
+            chunk_len = len - done;
+        }
+        MEMCPY(&stream->buffer[n][stream->block_len[n]], data + done, chunk_len);
+        stream->block_len[n] += chunk_len;
+        stream->position += chunk_len;
+        done += chunk_len;
+
+        if(stream->position == _eeprom_at24cxx_stream_block_end(stream, stream->block_address[n]))
+        {
+            _eeprom_at24cxx_stream_commit(stream);
+        }
+    }
+    return done;
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_StreamSeek(EEPROM_AT24CXX_STREAM* stream, uint32_t offset)
+{
+    //MOVE THE CURSOR TO offset (0 ... RANGE LENGTH)
+    //A PARTLY FILLED WRITE BLOCK IS QUEUED FIRST. READ BLOCKS ALREADY
+    //BUFFERED ARE KEPT, SO SHORT SEEKS BACK COST NO BUS TRAFFIC
+
+    if(offset > stream->end - stream->start)
+    {
+        return EEPROM_STATUS_INVALID;
+    }
+
+    if(stream->mode == EEPROM_STREAM_WRITE)
+    {
+        _eeprom_at24cxx_stream_commit(stream);
+    }
+    stream->position = stream->start + offset;
+    return stream->status;
+}
+
+uint32_t PUTINFLASH EEPROM_AT24CXX_StreamTell(EEPROM_AT24CXX_STREAM* stream)
+{
+    //RETURN CURSOR OFFSET FROM THE START OF THE RANGE
+
+    return stream->position - stream->start;
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_StreamGetStatus(EEPROM_AT24CXX_STREAM* stream)
+{
+    //RETURN THE FIRST FAILURE (EEPROM_STATUS_OK IF NONE)
+    //BLOCKS STILL IN FLIGHT ARE NOT WAITED FOR
+
+    return stream->status;
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_StreamSync(EEPROM_AT24CXX_STREAM* stream)
+{
+    //WRITE : QUEUE A PARTLY FILLED BLOCK, WAIT TILL EVERY BLOCK IS
+    //COMMITTED AND FLUSH THE PAGE CACHE
+    //READ : WAIT FOR THE READ AHEAD, SO NO REQUEST USES THE BUFFERS
+
+    EEPROM_STATUS status;
+
+    if(stream->mode == EEPROM_STREAM_WRITE)
+    {
+        _eeprom_at24cxx_stream_commit(stream);
+    }
+    _eeprom_at24cxx_stream_wait(stream, 0);
+    _eeprom_at24cxx_stream_wait(stream, 1);
+
+    if(stream->mode == EEPROM_STREAM_WRITE)
+    {
+        status = EEPROM_AT24CXX_DeviceFlush(stream->device);
+        if(stream->status == EEPROM_STATUS_OK)
+        {
+            stream->status = status;
+        }
+    }
+    return stream->status;
+}
+
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_StreamClose(EEPROM_AT24CXX_STREAM* stream)
+{
+    //SYNC AND PARK THE CURSOR AT THE END, LATER Read / Write DO NOTHING
+    //THE STREAM (AND ITS BUFFERS) MAY BE REUSED ONCE THIS RETURNS
+
+    EEPROM_AT24CXX_StreamSync(stream);
+    stream->position = stream->end;
+    stream->block_len[0] = 0;
+    stream->block_len[1] = 0;
+    return stream->status;
+}
+
+static uint32_t PUTINFLASH _eeprom_at24cxx_stream_block_end(EEPROM_AT24CXX_STREAM* stream, uint32_t address)
+{
+    //END OF THE BLOCK HOLDING address, CLIPPED TO THE END OF THE RANGE
+
+    uint32_t end = ((address / EEPROM_AT24CXX_STREAM_BLOCK) + 1) * EEPROM_AT24CXX_STREAM_BLOCK;
+
+    return (end < stream->end) ? end : stream->end;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_stream_covers(EEPROM_AT24CXX_STREAM* stream, uint8_t n, uint32_t address)
+{
+    //RETURN 1 IF READ BUFFER n HOLDS (OR IS FETCHING) address
+
+    return (stream->block_len[n] != 0 && address >= stream->block_address[n] &&
+            address - stream->block_address[n] < stream->block_len[n]);
+}
+
+static void PUTINFLASH _eeprom_at24cxx_stream_submit(EEPROM_AT24CXX_STREAM* stream, uint8_t n, uint32_t address, uint16_t len)
+{
+    //QUEUE BUFFER n FOR len BYTES AT address
+    //IF THE DEVICE QUEUE IS FULL THE TRANSFER IS DONE HERE INSTEAD
+
+    EEPROM_AT24CXX_REQUEST* request = &stream->request[n];
+    uint8_t queued;
+
+    if(stream->mode == EEPROM_STREAM_WRITE)
+    {
+        queued = EEPROM_AT24CXX_DeviceWriteAsync(stream->device, request, address, ADDRESS_TYPE_BYTE, stream->buffer[n], len, NULL, NULL);
+    }
+    else
+    {
+        queued = EEPROM_AT24CXX_DeviceReadAsync(stream->device, request, address, ADDRESS_TYPE_BYTE, stream->buffer[n], len, NULL, NULL);
+    }
+
+    if(!queued)
+    {
+        if(stream->mode == EEPROM_STREAM_WRITE)
+        {
+            request->status = EEPROM_AT24CXX_DeviceWriteBlock(stream->device, address, ADDRESS_TYPE_BYTE, stream->buffer[n], len);
+        }
+        else
+        {
+            request->status = EEPROM_AT24CXX_DeviceReadBlock(stream->device, address, ADDRESS_TYPE_BYTE, stream->buffer[n], len);
+        }
+        request->done = 1;
+    }
+    stream->pending[n] = 1;
+}
+
+static void PUTINFLASH _eeprom_at24cxx_stream_wait(EEPROM_AT24CXX_STREAM* stream, uint8_t n)
+{
+    //WAIT TILL BUFFER n IS BACK FROM THE DEVICE
+    //A FAILED READ BLOCK IS DROPPED, A FAILURE STOPS THE STREAM
+
+    EEPROM_STATUS status;
+
+    if(!stream->pending[n])
+    {
+        return;
+    }
+    stream->pending[n] = 0;
+
+    status = EEPROM_AT24CXX_DeviceWaitRequest(stream->device, &stream->request[n]);
+    if(status != EEPROM_STATUS_OK)
+    {
+        if(stream->mode == EEPROM_STREAM_READ)
+        {
+            stream->block_len[n] = 0;
+        }
+        if(stream->status == EEPROM_STATUS_OK)
+        {
+            stream->status = status;
+        }
+    }
+}
+
+static void PUTINFLASH _eeprom_at24cxx_stream_fetch(EEPROM_AT24CXX_STREAM* stream, uint8_t n, uint32_t address)
+{
+    //LOAD READ BUFFER n WITH THE BLOCK FROM address (NOTHING PAST THE END)
+
+    _eeprom_at24cxx_stream_wait(stream, n);
+    stream->block_len[n] = 0;
+    if(address >= stream->end || stream->status != EEPROM_STATUS_OK)
+    {
+        return;
+    }
+
+    stream->block_address[n] = address;
+    stream->block_len[n] = (uint16_t)(_eeprom_at24cxx_stream_block_end(stream, address) - address);
+    _eeprom_at24cxx_stream_submit(stream, n, address, stream->block_len[n]);
+}
+
+static void PUTINFLASH _eeprom_at24cxx_stream_commit(EEPROM_AT24CXX_STREAM* stream)
+{
+    //QUEUE THE CURRENT WRITE BUFFER (IF IT HOLDS ANYTHING) AND MOVE THE
+    //CURSOR TO THE OTHER ONE
+
+    uint8_t n = stream->current;
+
+    if(stream->block_len[n] == 0)
+    {
+        return;
+    }
+    _eeprom_at24cxx_stream_submit(stream, n, stream->block_address[n], stream->block_len[n]);
+    stream->block_len[n] = 0;
+    stream->current = n ^ 1;
+}
+
+static void PUTINFLASH _eeprom_at24cxx_stream_pump(EEPROM_AT24CXX_STREAM* stream)
+{
+    //WITHOUT THREADS THE CALLER IS THE BUS OWNER : MOVE THE QUEUE ON BY
+    //ONE TRANSFER SO BLOCKS IN FLIGHT PROGRESS BETWEEN CALLS
+
+    #if !defined(EEPROM_AT24CXX_THREAD_SAFE)
+        if(stream->pending[0] || stream->pending[1])
+        {
+            EEPROM_AT24CXX_DeviceTick(stream->device);
+        }
+    #else
+        (void)stream;
+    #endif
+}
@@ -0,0 +1,109 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* SEQUENTIAL STREAM CURSORS
+*
+* NOTE
+* -------
+*   (1) A STREAM IS A READ OR WRITE CURSOR OVER A BYTE RANGE OF ONE
+*       DEVICE (UP TO THE WHOLE CHIP). Read / Write TAKE ANY LENGTH,
+*       Seek / Tell MOVE THE CURSOR. THE CALLER NEVER DEALS WITH PAGES,
+*       BLOCKS OR THE 255 BYTE TRANSFER LIMIT
+*
+*   (2) DOUBLE BUFFERED : DATA MOVES IN EEPROM_AT24CXX_STREAM_BLOCK
+*       ALIGNED BLOCKS THROUGH TWO BUFFERS IN THE STREAM. A FULL WRITE
+*       BLOCK IS QUEUED ON THE DEVICE (WriteAsync) AND THE CALLER GOES ON
+*       FILLING THE OTHER ONE WHILE IT COMMITS, SO CPU WORK (COMPRESSION,
+*       CRC) OVERLAPS THE WRITE CYCLE. A READ QUEUES THE NEXT BLOCK AS
+*       SOON AS THE CURSOR ENTERS THE CURRENT ONE (READ AHEAD)
+*
+*   (3) A Read OF AT LEAST TWO BLOCKS THAT NOTHING BUFFERED COVERS GOES
+*       STRAIGHT INTO THE CALLER'S BUFFER AS ONE SEQUENTIAL READ (THE
+*       CHIP AUTO INCREMENTS ACROSS PAGES, ONLY THE ADDRESS BLOCK BITS
+*       OF PARTS UP TO C16 SPLIT IT), WITH NO COPY
+*
+*   (4) WITHOUT EEPROM_AT24CXX_THREAD_SAFE THE CALLER IS THE BUS OWNER :
+*       EVERY Read / Write ALSO RUNS ONE Tick, AND A BUFFER STILL IN
+*       FLIGHT WHEN IT IS NEEDED AGAIN IS WAITED FOR (WaitRequest). KEEP
+*       CALLING Tick FROM THE MAIN LOOP SO BLOCKS COMMIT BETWEEN CALLS.
+*       WITH THREADS THE BUS OWNER THREAD RUNS THE QUEUE
+*
+*   (5) SIZE THE BLOCK TO AT LEAST THE WRITE PAGE OF THE PART. A BLOCK
+*       SMALLER THAN THE PAGE IS A PARTIAL PAGE WRITE AND COSTS A FULL
+*       WRITE CYCLE. WITH THE PAGE CACHE ON, WRITE BLOCKS LAND IN THE
+*       CACHE AND ITS WRITE BACK DECIDES WHEN THE PAGES COMMIT
+*
+*   (6) THE FIRST FAILED TRANSFER STOPS THE STREAM : Read / Write RETURN
+*       SHORT AND Sync / Close / GetStatus GIVE THE STATUS TILL THE
+*       STREAM IS OPENED AGAIN. Sync COMMITS A PARTLY FILLED BLOCK AND
+*       FLUSHES THE PAGE CACHE. DATA WRITTEN TO THE RANGE OUTSIDE A READ
+*       STREAM IS NOT SEEN IN BLOCKS IT HAS ALREADY BUFFERED
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#ifndef _EEPROM_AT24CXX_STREAM_H_
+#define _EEPROM_AT24CXX_STREAM_H_
+
+#include "EEPROM_AT24CXX.h"
+
+//BLOCK (BYTES PER BUFFER, TWO PER STREAM). POWER OF 2, AT LEAST
+//EEPROM_AT24CXX_PAGE_SIZE, AT MOST 256
+#ifndef EEPROM_AT24CXX_STREAM_BLOCK
+  #define EEPROM_AT24CXX_STREAM_BLOCK         64
+#endif
+#if (EEPROM_AT24CXX_STREAM_BLOCK & (EEPROM_AT24CXX_STREAM_BLOCK - 1)) || \
+    (EEPROM_AT24CXX_STREAM_BLOCK < EEPROM_AT24CXX_PAGE_SIZE) || (EEPROM_AT24CXX_STREAM_BLOCK > 256)
+  #error "EEPROM : AT24CXX : STREAM : invalid block size"
+#endif
+
+//CUSTOM VARIABLE STRUCTURES/////////////////////////////
+typedef enum
+{
+    EEPROM_STREAM_READ = 0,
+    EEPROM_STREAM_WRITE,
+    EEPROM_STREAM_MAX
+} EEPROM_STREAM_MODE;
+
+typedef struct
+{
+    EEPROM_AT24CXX_DEVICE* device;
+    EEPROM_STREAM_MODE mode;
+    uint32_t start;         //RANGE (DEVICE BYTE ADDRESSES)
+    uint32_t end;
+    uint32_t position;      //CURSOR (DEVICE BYTE ADDRESS)
+    EEPROM_STATUS status;   //FIRST FAILURE
+
+    //BUFFERS
+    //READ  : block_len BYTES FROM block_address (0 = EMPTY)
+    //WRITE : block_len BYTES BUFFERED, NOT YET QUEUED
+    uint8_t current;        //BUFFER THE CURSOR IS IN
+    uint8_t pending[2];     //request[n] QUEUED, NOT YET WAITED FOR
+    uint32_t block_address[2];
+    uint16_t block_len[2];
+    EEPROM_AT24CXX_REQUEST request[2];
+    uint8_t buffer[2][EEPROM_AT24CXX_STREAM_BLOCK];
+} EEPROM_AT24CXX_STREAM;
+//END CUSTOM VARIABLE STRUCTURES/////////////////////////
+
+//FUNCTION PROTOTYPES/////////////////////////////////////
+//STREAM COVERS len BYTES FROM DEVICE BYTE ADDRESS address. OFFSETS
+//(Seek / Tell) ARE RELATIVE TO address. Read / Write RETURN THE NUMBER
+//OF BYTES MOVED (SHORT AT THE END OF THE RANGE OR ON A FAILURE)
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_StreamOpen(EEPROM_AT24CXX_STREAM* stream,
+                                                    EEPROM_AT24CXX_DEVICE* device,
+                                                    EEPROM_STREAM_MODE mode,
+                                                    uint32_t address,
+                                                    uint32_t len);
+uint32_t PUTINFLASH EEPROM_AT24CXX_StreamRead(EEPROM_AT24CXX_STREAM* stream, uint8_t* data, uint32_t len);
+uint32_t PUTINFLASH EEPROM_AT24CXX_StreamWrite(EEPROM_AT24CXX_STREAM* stream, uint8_t* data, uint32_t len);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_StreamSeek(EEPROM_AT24CXX_STREAM* stream, uint32_t offset);
+uint32_t PUTINFLASH EEPROM_AT24CXX_StreamTell(EEPROM_AT24CXX_STREAM* stream);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_StreamGetStatus(EEPROM_AT24CXX_STREAM* stream);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_StreamSync(EEPROM_AT24CXX_STREAM* stream);
+EEPROM_STATUS PUTINFLASH EEPROM_AT24CXX_StreamClose(EEPROM_AT24CXX_STREAM* stream);
+//END FUNCTION PROTOTYPES/////////////////////////////////
+#endif
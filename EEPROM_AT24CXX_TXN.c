@@ -0,0 +1,382 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* POWER FAIL SAFE MULTI PAGE TRANSACTIONS
+*
+* NOTE
+* -------
+*   (1) DOUBLE BUFFERED : EVERY LOGICAL PAGE OF THE REGION HAS TWO
+*       COPIES. A HEADER MAP SAYS WHICH COPY IS LIVE. A TRANSACTION
+*       WRITES THE PAGES IT TOUCHES INTO THEIR OTHER (SHADOW) COPY AND
+*       Commit FLIPS THEM ALL AT ONCE WITH ONE HEADER PAGE WRITE, SO A
+*       COMMIT OF N PAGES COSTS N + 1 PAGE WRITES
+*
+*   (2) LAYOUT (REGION RELATIVE, ONE EEPROM_AT24CXX_PAGE_SIZE PAGE EACH)
+*       PAGE 0, 1    : HEADER SLOTS, USED IN TURN (SEQ & 1)
+*       PAGE 2 + 2n  : LOGICAL PAGE n, COPY 0
+*       PAGE 3 + 2n  : LOGICAL PAGE n, COPY 1
+*       HEADER       : [MAGIC "TX" 2][SEQ 4][PAGES 1][MAP][CRC32 4]
+*       MAP BIT n SET = LOGICAL PAGE n LIVES IN COPY 1
+*
+*   (3) A POWER FAIL BEFORE THE HEADER WRITE LEAVES ONLY SHADOW COPIES
+*       CHANGED. A TORN HEADER FAILS ITS CRC AND THE OTHER SLOT (THE
+*       PREVIOUS COMMIT) IS USED. Mount ONLY READS THE TWO HEADER SLOTS,
+*       THERE IS NOTHING TO SCAN OR REPLAY
+*
+*   (4) THE FIRST WRITE TO A PAGE IN A TRANSACTION COPIES THE LIVE PAGE
+*       INTO THE SHADOW (ONE READ + ONE PAGE WRITE, NO READ IF THE WRITE
+*       COVERS THE WHOLE PAGE). LATER WRITES TO IT GO STRAIGHT TO THE
+*       SHADOW. Read SEES THE OPEN TRANSACTION'S WRITES
+*
+*   (5) THE TWO HEADER SLOTS TAKE ONE WRITE PER COMMIT BETWEEN THEM.
+*       PUT THE REGION ON A PART (OR OFFSET) WITH ENDURANCE TO SPARE
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#include "EEPROM_AT24CXX_TXN.h"
+
+#define _EEPROM_AT24CXX_TXN_MAGIC_0     'T'
+#define _EEPROM_AT24CXX_TXN_MAGIC_1     'X'
+
+#define _EEPROM_AT24CXX_TXN_BIT(map, n)  (((map)[(n) / 8] >> ((n) % 8)) & 1)
+
+//INTERNAL FUNCTIONS//////////////////////////////////////////
+static uint8_t PUTINFLASH _eeprom_at24cxx_txn_setup(EEPROM_AT24CXX_TXN* txn, EEPROM_AT24CXX_DEVICE* device, uint16_t first_page, uint8_t page_count);
+static uint32_t PUTINFLASH _eeprom_at24cxx_txn_page_address(EEPROM_AT24CXX_TXN* txn, uint8_t page, uint8_t copy);
+static uint8_t PUTINFLASH _eeprom_at24cxx_txn_read_header(EEPROM_AT24CXX_TXN* txn, uint8_t slot, uint32_t* seq, uint8_t* map);
+static uint8_t PUTINFLASH _eeprom_at24cxx_txn_write_header(EEPROM_AT24CXX_TXN* txn, uint32_t seq, uint8_t* map);
+static uint8_t PUTINFLASH _eeprom_at24cxx_txn_range(EEPROM_AT24CXX_TXN* txn, uint32_t address, uint32_t len);
+//END INTERNAL FUNCTIONS//////////////////////////////////////
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNFormat(EEPROM_AT24CXX_TXN* txn,
+                                            EEPROM_AT24CXX_DEVICE* device,
+                                            uint16_t first_page,
+                                            uint8_t page_count)
+{
+    //ERASE DATA (ALL 0xFF IN COPY 0) AND COMMIT AN EMPTY MAP
+    //THE OTHER HEADER SLOT IS WIPED SO AN OLD REGION CANNOT WIN A MOUNT
+
+    uint8_t page_data[EEPROM_AT24CXX_PAGE_SIZE];
+    uint8_t i;
+
+    if(!_eeprom_at24cxx_txn_setup(txn, device, first_page, page_count))
+    {
+        return 0;
+    }
+
+    memset(page_data, 0xFF, EEPROM_AT24CXX_PAGE_SIZE);
+    for(i = 0; i < txn->page_count; i++)
+    {
+        if(EEPROM_AT24CXX_DeviceWriteBlock(txn->device, _eeprom_at24cxx_txn_page_address(txn, i, 0), ADDRESS_TYPE_BYTE, page_data, EEPROM_AT24CXX_PAGE_SIZE) != EEPROM_STATUS_OK)
+        {
+            return 0;
+        }
+    }
+    if(EEPROM_AT24CXX_DeviceWriteBlock(txn->device, EEPROM_GET_BYTE_ADDRESS_FROM_PAGE((uint32_t)txn->first_page + 0), ADDRESS_TYPE_BYTE, page_data, EEPROM_AT24CXX_PAGE_SIZE) != EEPROM_STATUS_OK ||
+        !_eeprom_at24cxx_txn_write_header(txn, 1, txn->map) ||
+        EEPROM_AT24CXX_DeviceFlush(txn->device) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+
+    txn->seq = 1;
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNMount(EEPROM_AT24CXX_TXN* txn,
+                                            EEPROM_AT24CXX_DEVICE* device,
+                                            uint16_t first_page,
+                                            uint8_t page_count)
+{
+    //LOAD THE NEWEST VALID HEADER OF THE TWO SLOTS
+
+    uint8_t map[EEPROM_AT24CXX_TXN_MAP_SIZE];
+    uint32_t seq;
+    uint8_t found = 0;
+    uint8_t slot;
+
+    if(!_eeprom_at24cxx_txn_setup(txn, device, first_page, page_count))
+    {
+        return 0;
+    }
+
+    for(slot = 0; slot < 2; slot++)
+    {
+        if(_eeprom_at24cxx_txn_read_header(txn, slot, &seq, map) && (!found || seq > txn->seq))
+        {
+            txn->seq = seq;
+            memcpy(txn->map, map, EEPROM_AT24CXX_TXN_MAP_SIZE);
+            found = 1;
+        }
+    }
+    if(!found)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : TXN : no valid header !\n");
+        return 0;
+    }
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNBegin(EEPROM_AT24CXX_TXN* txn)
+{
+    //OPEN A TRANSACTION (ONE AT A TIME)
+
+    if(txn->open)
+    {
+        return 0;
+    }
+    memset(txn->staged, 0, EEPROM_AT24CXX_TXN_MAP_SIZE);
+    txn->open = 1;
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNWrite(EEPROM_AT24CXX_TXN* txn, uint32_t address, uint8_t* data, uint32_t len)
+{
+    //WRITE INTO THE SHADOW COPIES OF THE TOUCHED PAGES
+    //NOTHING IS VISIBLE AFTER A RESET TILL Commit
+
+    uint8_t page_data[EEPROM_AT24CXX_PAGE_SIZE];
+    uint32_t offset;
+    uint32_t chunk_len;
+    uint8_t page;
+    uint8_t live;
+
+    if(!txn->open || !_eeprom_at24cxx_txn_range(txn, address, len))
+    {
+        return 0;
+    }
+
+    while(len > 0)
+    {
+        page = (uint8_t)(address / EEPROM_AT24CXX_PAGE_SIZE);
+        offset = address % EEPROM_AT24CXX_PAGE_SIZE;
+        chunk_len = EEPROM_AT24CXX_PAGE_SIZE - offset;
+        if(chunk_len > len)
+        {
+            chunk_len = len;
+        }
+        live = _EEPROM_AT24CXX_TXN_BIT(txn->map, page);
+
+        if(_EEPROM_AT24CXX_TXN_BIT(txn->staged, page))
+        {
+            if(EEPROM_AT24CXX_DeviceWriteBlock(txn->device, _eeprom_at24cxx_txn_page_address(txn, page, !live) + offset, ADDRESS_TYPE_BYTE, data, chunk_len) != EEPROM_STATUS_OK)
+            {
+                return 0;
+            }
+        }
+        else
+        {
+            //FIRST TOUCH : SHADOW = LIVE PAGE WITH THE NEW BYTES ON TOP
+            if(chunk_len < EEPROM_AT24CXX_PAGE_SIZE &&
+                EEPROM_AT24CXX_DeviceReadBlock(txn->device, _eeprom_at24cxx_txn_page_address(txn, page, live), ADDRESS_TYPE_BYTE, page_data, EEPROM_AT24CXX_PAGE_SIZE) != EEPROM_STATUS_OK)
+            {
+                return 0;
+            }
+            memcpy(&page_data[offset], data, chunk_len);
+            if(EEPROM_AT24CXX_DeviceWriteBlock(txn->device, _eeprom_at24cxx_txn_page_address(txn, page, !live), ADDRESS_TYPE_BYTE, page_data, EEPROM_AT24CXX_PAGE_SIZE) != EEPROM_STATUS_OK)
+            {
+                return 0;
+            }
+            txn->staged[page / 8] |= (1 << (page % 8));
+        }
+
+        address += chunk_len;
+        data += chunk_len;
+        len -= chunk_len;
+    }
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNCommit(EEPROM_AT24CXX_TXN* txn)
+{
+    //MAKE ALL SHADOW PAGES LIVE WITH ONE HEADER WRITE
+    //SHADOWS ARE FLUSHED OUT OF THE PAGE CACHE BEFORE THE HEADER IS
+    //WRITTEN, AND THE HEADER BEFORE RETURNING. ON A FAILED TRANSFER THE
+    //COMMITTED STATE IN RAM STAYS AS IT WAS AND THE TRANSACTION OPEN
+
+    uint8_t map[EEPROM_AT24CXX_TXN_MAP_SIZE];
+    uint8_t changed = 0;
+    uint8_t i;
+
+    if(!txn->open)
+    {
+        return 0;
+    }
+
+    for(i = 0; i < EEPROM_AT24CXX_TXN_MAP_SIZE; i++)
+    {
+        map[i] = txn->map[i] ^ txn->staged[i];
+        changed |= txn->staged[i];
+    }
+
+    if(changed &&
+        (EEPROM_AT24CXX_DeviceFlush(txn->device) != EEPROM_STATUS_OK ||
+        !_eeprom_at24cxx_txn_write_header(txn, txn->seq + 1, map) ||
+        EEPROM_AT24CXX_DeviceFlush(txn->device) != EEPROM_STATUS_OK))
+    {
+        return 0;
+    }
+
+    if(changed)
+    {
+        txn->seq++;
+        memcpy(txn->map, map, EEPROM_AT24CXX_TXN_MAP_SIZE);
+    }
+    txn->open = 0;
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNAbort(EEPROM_AT24CXX_TXN* txn)
+{
+    //DROP THE OPEN TRANSACTION. SHADOW COPIES ARE SIMPLY NOT USED
+
+    if(!txn->open)
+    {
+        return 0;
+    }
+    txn->open = 0;
+    return 1;
+}
+
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNRead(EEPROM_AT24CXX_TXN* txn, uint32_t address, uint8_t* data, uint32_t len)
+{
+    //READ COMMITTED DATA, OR THE OPEN TRANSACTION'S VERSION OF A PAGE
+    //IT HAS WRITTEN
+
+    uint32_t chunk_len;
+    uint8_t page;
+    uint8_t copy;
+
+    if(!_eeprom_at24cxx_txn_range(txn, address, len))
+    {
+        return 0;
+    }
+
+    while(len > 0)
+    {
+        page = (uint8_t)(address / EEPROM_AT24CXX_PAGE_SIZE);
+        chunk_len = EEPROM_AT24CXX_PAGE_SIZE - (address % EEPROM_AT24CXX_PAGE_SIZE);
+        if(chunk_len > len)
+        {
+            chunk_len = len;
+        }
+        copy = _EEPROM_AT24CXX_TXN_BIT(txn->map, page);
+        if(txn->open && _EEPROM_AT24CXX_TXN_BIT(txn->staged, page))
+        {
+            copy = !copy;
+        }
+
+        if(EEPROM_AT24CXX_DeviceReadBlock(txn->device,
+                                            _eeprom_at24cxx_txn_page_address(txn, page, copy) + (address % EEPROM_AT24CXX_PAGE_SIZE),
+                                            ADDRESS_TYPE_BYTE,
+                                            data,
+                                            chunk_len) != EEPROM_STATUS_OK)
+        {
+            return 0;
+        }
+        address += chunk_len;
+        data += chunk_len;
+        len -= chunk_len;
+    }
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_txn_setup(EEPROM_AT24CXX_TXN* txn, EEPROM_AT24CXX_DEVICE* device, uint16_t first_page, uint8_t page_count)
+{
+    //VALIDATE REGION AND RESET STATE
+
+    uint32_t device_pages;
+
+    device_pages = EEPROM_AT24CXX_DeviceGetSize(device) / EEPROM_AT24CXX_PAGE_SIZE;
+    if(page_count == 0 || page_count > EEPROM_AT24CXX_TXN_MAX_PAGES ||
+        (uint32_t)first_page + 2 + 2 * (uint32_t)page_count > device_pages)
+    {
+        EEPROM_AT24CXX_LOG_ERROR("EEPROM : AT24CXX : TXN : Invalid region !\n");
+        return 0;
+    }
+
+    txn->device = device;
+    txn->first_page = first_page;
+    txn->page_count = page_count;
+    txn->seq = 0;
+    txn->open = 0;
+    memset(txn->map, 0, EEPROM_AT24CXX_TXN_MAP_SIZE);
+    memset(txn->staged, 0, EEPROM_AT24CXX_TXN_MAP_SIZE);
+    return 1;
+}
+
+static uint32_t PUTINFLASH _eeprom_at24cxx_txn_page_address(EEPROM_AT24CXX_TXN* txn, uint8_t page, uint8_t copy)
+{
+    //LOGICAL PAGE COPY TO DEVICE BYTE ADDRESS
+
+    return EEPROM_GET_BYTE_ADDRESS_FROM_PAGE((uint32_t)txn->first_page + 2 + 2 * (uint32_t)page + copy);
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_txn_read_header(EEPROM_AT24CXX_TXN* txn, uint8_t slot, uint32_t* seq, uint8_t* map)
+{
+    //READ HEADER SLOT
+    //RETURN 1 IF IT IS INTACT AND DESCRIBES A REGION OF THIS SIZE
+
+    uint8_t header[EEPROM_AT24CXX_PAGE_SIZE];
+    uint32_t crc;
+
+    if(EEPROM_AT24CXX_DeviceReadBlock(txn->device, EEPROM_GET_BYTE_ADDRESS_FROM_PAGE((uint32_t)txn->first_page + slot), ADDRESS_TYPE_BYTE, header, EEPROM_AT24CXX_PAGE_SIZE) != EEPROM_STATUS_OK)
+    {
+        return 0;
+    }
+
+    crc = ((uint32_t)header[EEPROM_AT24CXX_PAGE_SIZE - 4] << 24) |
+            ((uint32_t)header[EEPROM_AT24CXX_PAGE_SIZE - 3] << 16) |
+            ((uint32_t)header[EEPROM_AT24CXX_PAGE_SIZE - 2] << 8) |
+            header[EEPROM_AT24CXX_PAGE_SIZE - 1];
+    if(header[0] != _EEPROM_AT24CXX_TXN_MAGIC_0 || header[1] != _EEPROM_AT24CXX_TXN_MAGIC_1 ||
+        header[6] != txn->page_count ||
+        EEPROM_AT24CXX_Crc32(0, header, EEPROM_AT24CXX_PAGE_SIZE - 4) != crc)
+    {
+        return 0;
+    }
+
+    *seq = ((uint32_t)header[2] << 24) | ((uint32_t)header[3] << 16) | ((uint32_t)header[4] << 8) | header[5];
+    memcpy(map, &header[7], EEPROM_AT24CXX_TXN_MAP_SIZE);
+    return 1;
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_txn_write_header(EEPROM_AT24CXX_TXN* txn, uint32_t seq, uint8_t* map)
+{
+    //WRITE HEADER FOR seq INTO SLOT seq & 1 (THE SLOT NOT HOLDING THE
+    //CURRENT COMMIT) AS ONE PAGE WRITE
+    //RETURN 0 IF THE TRANSFER FAILED
+
+    uint8_t header[EEPROM_AT24CXX_PAGE_SIZE];
+    uint32_t crc;
+
+    header[0] = _EEPROM_AT24CXX_TXN_MAGIC_0;
+    header[1] = _EEPROM_AT24CXX_TXN_MAGIC_1;
+    header[2] = (uint8_t)(seq >> 24);
+    header[3] = (uint8_t)(seq >> 16);
+    header[4] = (uint8_t)(seq >> 8);
+    header[5] = (uint8_t)seq;
+    header[6] = txn->page_count;
+    memcpy(&header[7], map, EEPROM_AT24CXX_TXN_MAP_SIZE);
+
+    crc = EEPROM_AT24CXX_Crc32(0, header, EEPROM_AT24CXX_PAGE_SIZE - 4);
+    header[EEPROM_AT24CXX_PAGE_SIZE - 4] = (uint8_t)(crc >> 24);
+    header[EEPROM_AT24CXX_PAGE_SIZE - 3] = (uint8_t)(crc >> 16);
+    header[EEPROM_AT24CXX_PAGE_SIZE - 2] = (uint8_t)(crc >> 8);
+    header[EEPROM_AT24CXX_PAGE_SIZE - 1] = (uint8_t)crc;
+
+    return (EEPROM_AT24CXX_DeviceWriteBlock(txn->device, EEPROM_GET_BYTE_ADDRESS_FROM_PAGE((uint32_t)txn->first_page + (seq & 1)), ADDRESS_TYPE_BYTE, header, EEPROM_AT24CXX_PAGE_SIZE) == EEPROM_STATUS_OK);
+}
+
+static uint8_t PUTINFLASH _eeprom_at24cxx_txn_range(EEPROM_AT24CXX_TXN* txn, uint32_t address, uint32_t len)
+{
+    //RETURN 1 IF [address, address + len) LIES IN THE LOGICAL DATA
+
+    uint32_t size = (uint32_t)txn->page_count * EEPROM_AT24CXX_PAGE_SIZE;
+
+    return (len > 0 && address < size && len <= size - address);
+}
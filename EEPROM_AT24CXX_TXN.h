@@ -0,0 +1,91 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* POWER FAIL SAFE MULTI PAGE TRANSACTIONS
+*
+* NOTE
+* -------
+*   (1) DOUBLE BUFFERED : EVERY LOGICAL PAGE OF THE REGION HAS TWO
+*       COPIES. A HEADER MAP SAYS WHICH COPY IS LIVE. A TRANSACTION
+*       WRITES THE PAGES IT TOUCHES INTO THEIR OTHER (SHADOW) COPY AND
+*       Commit FLIPS THEM ALL AT ONCE WITH ONE HEADER PAGE WRITE, SO A
+*       COMMIT OF N PAGES COSTS N + 1 PAGE WRITES
+*
+*   (2) LAYOUT (REGION RELATIVE, ONE EEPROM_AT24CXX_PAGE_SIZE PAGE EACH)
+*       PAGE 0, 1    : HEADER SLOTS, USED IN TURN (SEQ & 1)
+*       PAGE 2 + 2n  : LOGICAL PAGE n, COPY 0
+*       PAGE 3 + 2n  : LOGICAL PAGE n, COPY 1
+*       HEADER       : [MAGIC "TX" 2][SEQ 4][PAGES 1][MAP][CRC32 4]
+*       MAP BIT n SET = LOGICAL PAGE n LIVES IN COPY 1
+*
+*   (3) A POWER FAIL BEFORE THE HEADER WRITE LEAVES ONLY SHADOW COPIES
+*       CHANGED. A TORN HEADER FAILS ITS CRC AND THE OTHER SLOT (THE
+*       PREVIOUS COMMIT) IS USED. Mount ONLY READS THE TWO HEADER SLOTS,
+*       THERE IS NOTHING TO SCAN OR REPLAY
+*
+*   (4) THE FIRST WRITE TO A PAGE IN A TRANSACTION COPIES THE LIVE PAGE
+*       INTO THE SHADOW (ONE READ + ONE PAGE WRITE, NO READ IF THE WRITE
+*       COVERS THE WHOLE PAGE). LATER WRITES TO IT GO STRAIGHT TO THE
+*       SHADOW. Read SEES THE OPEN TRANSACTION'S WRITES
+*
+*   (5) THE TWO HEADER SLOTS TAKE ONE WRITE PER COMMIT BETWEEN THEM.
+*       PUT THE REGION ON A PART (OR OFFSET) WITH ENDURANCE TO SPARE
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#ifndef _EEPROM_AT24CXX_TXN_H_
+#define _EEPROM_AT24CXX_TXN_H_
+
+#include "EEPROM_AT24CXX.h"
+
+#define EEPROM_AT24CXX_TXN_HEADER_SIZE        11
+#define EEPROM_AT24CXX_TXN_MAP_SIZE           (EEPROM_AT24CXX_PAGE_SIZE - EEPROM_AT24CXX_TXN_HEADER_SIZE)
+
+//LARGEST REGION IN LOGICAL PAGES (ONE MAP BIT EACH)
+#define EEPROM_AT24CXX_TXN_MAX_PAGES          (EEPROM_AT24CXX_TXN_MAP_SIZE * 8)
+
+//CUSTOM VARIABLE STRUCTURES/////////////////////////////
+typedef struct
+{
+    EEPROM_AT24CXX_DEVICE* device;
+    uint16_t first_page;    //REGION START (DEVICE PAGE)
+    uint8_t page_count;     //LOGICAL PAGES
+
+    //COMMITTED STATE
+    uint32_t seq;
+    uint8_t map[EEPROM_AT24CXX_TXN_MAP_SIZE];
+
+    //OPEN TRANSACTION
+    uint8_t open;
+    uint8_t staged[EEPROM_AT24CXX_TXN_MAP_SIZE];    //PAGES WITH A NEW SHADOW
+} EEPROM_AT24CXX_TXN;
+//END CUSTOM VARIABLE STRUCTURES/////////////////////////
+
+//FUNCTION PROTOTYPES/////////////////////////////////////
+//REGION HOLDS page_count LOGICAL PAGES (DATA SIZE page_count *
+//EEPROM_AT24CXX_PAGE_SIZE) AND TAKES 2 + 2 * page_count DEVICE PAGES
+//FROM first_page. ADDRESSES ARE BYTE OFFSETS INTO THE LOGICAL DATA
+//ALL FUNCTIONS RETURN 1 ON SUCCESS, 0 ON FAILURE (A FAILED TRANSFER
+//STOPS THE CALL, SEE EEPROM_AT24CXX_DeviceGetLastStatus). A Commit THAT
+//FAILS KEEPS THE LAST COMMITTED STATE AND LEAVES THE TRANSACTION OPEN,
+//Abort IT AND REDO IT (STAGED PAGES THE PAGE CACHE FAILED TO FLUSH ARE
+//GONE, SO A PLAIN RETRY CAN COMMIT STALE DATA)
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNFormat(EEPROM_AT24CXX_TXN* txn,
+                                            EEPROM_AT24CXX_DEVICE* device,
+                                            uint16_t first_page,
+                                            uint8_t page_count);
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNMount(EEPROM_AT24CXX_TXN* txn,
+                                            EEPROM_AT24CXX_DEVICE* device,
+                                            uint16_t first_page,
+                                            uint8_t page_count);
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNBegin(EEPROM_AT24CXX_TXN* txn);
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNWrite(EEPROM_AT24CXX_TXN* txn, uint32_t address, uint8_t* data, uint32_t len);
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNCommit(EEPROM_AT24CXX_TXN* txn);
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNAbort(EEPROM_AT24CXX_TXN* txn);
+uint8_t PUTINFLASH EEPROM_AT24CXX_TXNRead(EEPROM_AT24CXX_TXN* txn, uint32_t address, uint8_t* data, uint32_t len);
+//END FUNCTION PROTOTYPES/////////////////////////////////
+#endif
@@ -0,0 +1,375 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* BENCHMARK (HOST, ON THE SIMULATED EEPROM)
+*
+* BUILD
+* -------
+*   gcc -O2 -DEEPROM_AT24CXX_SIM_TIME -I.. -o eeprom_bench \
+*       EEPROM_AT24CXX_BENCH.c ../EEPROM_AT24CXX.c ../EEPROM_AT24CXX_SIM.c
+*
+* USAGE
+* -------
+*   eeprom_bench [-c] [-p PREFETCH] [-b BUS_HZ] [-w TWR_US] [-n OPS]
+*                [-s SEED] [-m KBIT] [-t TRACE_FILE]
+*     -c  TURN PAGE CACHE ON
+*     -m  MODEL BY SIZE IN KBIT : 1 2 4 8 16 32 64 128 256 512 1024
+*         (1024 = AT24CM01), DEFAULT 64
+*     -t  WRITE THE DRIVER TRACE RING TO TRACE_FILE AT THE END (NEEDS
+*         EEPROM_AT24CXX_TRACE, DECODE WITH tools/EEPROM_AT24CXX_TRACE_DECODE)
+*
+* NOTE
+* -------
+*   (1) ALL TIMES ARE ON THE SIMULATED CLOCK (BUS BIT TIME + tWR), SO
+*       RESULTS ONLY DEPEND ON THE DRIVER, NOT ON THE HOST
+*
+*   (2) RESULTS ARE PRINTED AS ONE JSON OBJECT ON STDOUT
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#include "EEPROM_AT24CXX_SIM.h"
+
+#if !defined(EEPROM_AT24CXX_SIM_TIME)
+  #error "EEPROM : AT24CXX : BENCH : build with EEPROM_AT24CXX_SIM_TIME"
+#endif
+
+#define BENCH_MAX_OPS             4096
+#define BENCH_BLOCK_LEN           128
+#define BENCH_STORM_FIELDS        16
+#define BENCH_FILE                "eeprom_bench.bin"
+
+//CUSTOM VARIABLE STRUCTURES/////////////////////////////
+typedef struct
+{
+    uint32_t kbit;
+    EEPROM_MODEL_TYPE model;
+    const char* name;
+} BENCH_MODEL;
+
+typedef struct
+{
+    const char* name;
+    uint32_t ops;
+    uint32_t bytes;
+    uint64_t start_ns;
+    EEPROM_AT24CXX_SIM_STATS start_stats;
+    uint64_t latency_ns[BENCH_MAX_OPS];
+} BENCH_RUN;
+//END CUSTOM VARIABLE STRUCTURES/////////////////////////
+
+//LOCAL VARIABLES/////////////////////////////////////////
+static EEPROM_AT24CXX_SIM _bench_sim;
+static EEPROM_AT24CXX_DEVICE _bench_device;
+static BENCH_RUN _bench_run;
+static uint8_t _bench_image[131072];
+static uint8_t _bench_first = 1;
+
+static const BENCH_MODEL _bench_model[] =
+{
+    {1,     EEPROM_MODEL_AT24C01,   "AT24C01"},
+    {2,     EEPROM_MODEL_AT24C02,   "AT24C02"},
+    {4,     EEPROM_MODEL_AT24C04,   "AT24C04"},
+    {8,     EEPROM_MODEL_AT24C08,   "AT24C08"},
+    {16,    EEPROM_MODEL_AT24C16,   "AT24C16"},
+    {32,    EEPROM_MODEL_AT24C32,   "AT24C32"},
+    {64,    EEPROM_MODEL_AT24C64,   "AT24C64"},
+    {128,   EEPROM_MODEL_AT24C128,  "AT24C128"},
+    {256,   EEPROM_MODEL_AT24C256,  "AT24C256"},
+    {512,   EEPROM_MODEL_AT24C512,  "AT24C512"},
+    {1024,  EEPROM_MODEL_AT24CM01,  "AT24CM01"}
+};
+
+//INTERNAL FUNCTIONS//////////////////////////////////////
+static void _bench_begin(const char* name);
+static void _bench_op_start(uint64_t* t);
+static void _bench_op_end(uint64_t t, uint32_t bytes);
+static void _bench_end(void);
+static int _bench_compare_u64(const void* a, const void* b);
+static uint64_t _bench_percentile(uint64_t* sorted, uint32_t count, uint32_t pct);
+//END INTERNAL FUNCTIONS//////////////////////////////////
+
+int main(int argc, char** argv)
+{
+    const BENCH_MODEL* model = &_bench_model[6];
+    uint8_t cache_on = 0;
+    uint8_t prefetch = EEPROM_AT24CXX_CACHE_PREFETCH_PAGES;
+    uint32_t bus_hz = EEPROM_AT24CXX_SIM_BUS_HZ;
+    uint32_t write_cycle_us = EEPROM_AT24CXX_SIM_WRITE_CYCLE_US;
+    uint32_t ops = 2000;
+    uint32_t seed = 1;
+    const char* trace_file = NULL;
+    uint32_t size;
+    uint32_t address;
+    uint32_t fields[BENCH_STORM_FIELDS];
+    uint64_t t;
+    uint32_t i;
+    int opt;
+
+    while((opt = getopt(argc, argv, "cp:b:w:n:s:m:t:")) != -1)
+    {
+        switch(opt)
+        {
+            case 'c': cache_on = 1; break;
+            case 'p': prefetch = (uint8_t)atoi(optarg); break;
+            case 'b': bus_hz = (uint32_t)atoi(optarg); break;
+            case 'w': write_cycle_us = (uint32_t)atoi(optarg); break;
+            case 'n': ops = (uint32_t)atoi(optarg); break;
+            case 's': seed = (uint32_t)atoi(optarg); break;
+            case 'm':
+                for(i = 0; i < sizeof(_bench_model) / sizeof(BENCH_MODEL); i++)
+                {
+                    if(_bench_model[i].kbit == (uint32_t)atoi(optarg))
+                    {
+                        model = &_bench_model[i];
+                    }
+                }
+                break;
+            case 't': trace_file = optarg; break;
+            default:
+                fprintf(stderr, "usage : %s [-c] [-p prefetch] [-b bus_hz] [-w twr_us] [-n ops] [-s seed] [-m kbit] [-t trace_file]\n", argv[0]);
+                return 1;
+        }
+    }
+    if(ops > BENCH_MAX_OPS)
+    {
+        ops = BENCH_MAX_OPS;
+    }
+    srand(seed);
+
+    //FRESH SIMULATED DEVICE EVERY RUN
+    EEPROM_AT24CXX_DeviceInitialize(&_bench_device, model->model, 0, 0, 0);
+    size = EEPROM_AT24CXX_DeviceGetSize(&_bench_device);
+    unlink(BENCH_FILE);
+    if(!EEPROM_AT24CXX_SimOpen(&_bench_sim, BENCH_FILE, EEPROM_AT24CXX_DeviceGetI2CAddress(&_bench_device), size, EEPROM_AT24CXX_DeviceGetPageSize(&_bench_device), write_cycle_us))
+    {
+        return 1;
+    }
+    EEPROM_AT24CXX_SimSetBusSpeed(bus_hz);
+    EEPROM_AT24CXX_SimAttach(&_bench_device);
+    EEPROM_AT24CXX_DeviceSetCache(&_bench_device, cache_on);
+    EEPROM_AT24CXX_DeviceSetCachePrefetch(&_bench_device, prefetch);
+
+    for(i = 0; i < size; i++)
+    {
+        _bench_image[i] = (uint8_t)rand();
+    }
+    for(i = 0; i < BENCH_STORM_FIELDS; i++)
+    {
+        fields[i] = (uint32_t)(rand() % (size / 16)) & ~3u;
+    }
+
+    printf("{\n");
+    printf("  \"config\": {\"model\": \"%s\", \"size\": %u, \"cache\": %u, \"prefetch\": %u, \"bus_hz\": %u, \"write_cycle_us\": %u, \"ops\": %u, \"seed\": %u},\n",
+            model->name,
+            size, cache_on, prefetch, bus_hz, write_cycle_us, ops, seed);
+    printf("  \"workloads\": [\n");
+
+    //FULL CHIP RESTORE (ALSO LOADS THE TEST IMAGE)
+    _bench_begin("restore");
+    for(address = 0; address < size; address += BENCH_BLOCK_LEN)
+    {
+        _bench_op_start(&t);
+        EEPROM_AT24CXX_DeviceWriteBlock(&_bench_device, address, ADDRESS_TYPE_BYTE, &_bench_image[address], BENCH_BLOCK_LEN);
+        _bench_op_end(t, BENCH_BLOCK_LEN);
+    }
+    EEPROM_AT24CXX_DeviceFlush(&_bench_device);
+    _bench_end();
+
+    //FULL CHIP DUMP / SEQUENTIAL BLOCK READ
+    _bench_begin("dump");
+    for(address = 0; address < size; address += BENCH_BLOCK_LEN)
+    {
+        uint8_t block[BENCH_BLOCK_LEN];
+
+        _bench_op_start(&t);
+        EEPROM_AT24CXX_DeviceReadBlock(&_bench_device, address, ADDRESS_TYPE_BYTE, block, BENCH_BLOCK_LEN);
+        _bench_op_end(t, BENCH_BLOCK_LEN);
+        if(memcmp(block, &_bench_image[address], BENCH_BLOCK_LEN) != 0)
+        {
+            fprintf(stderr, "dump mismatch at %u\n", address);
+            return 1;
+        }
+    }
+    _bench_end();
+
+    //SEQUENTIAL SMALL READS
+    _bench_begin("seq_read32");
+    for(i = 0; i < ops; i++)
+    {
+        address = (i * 4) % size;
+        _bench_op_start(&t);
+        EEPROM_AT24CXX_DeviceRead32(&_bench_device, address, ADDRESS_TYPE_BYTE);
+        _bench_op_end(t, 4);
+    }
+    _bench_end();
+
+    //RANDOM 8 / 16 / 32 BIT READS
+    _bench_begin("rand_read8");
+    for(i = 0; i < ops; i++)
+    {
+        address = (uint32_t)rand() % size;
+        _bench_op_start(&t);
+        EEPROM_AT24CXX_DeviceRead8(&_bench_device, address, ADDRESS_TYPE_BYTE);
+        _bench_op_end(t, 1);
+    }
+    _bench_end();
+
+    _bench_begin("rand_read16");
+    for(i = 0; i < ops; i++)
+    {
+        address = (uint32_t)rand() % (size - 1);
+        _bench_op_start(&t);
+        EEPROM_AT24CXX_DeviceRead16(&_bench_device, address, ADDRESS_TYPE_BYTE);
+        _bench_op_end(t, 2);
+    }
+    _bench_end();
+
+    _bench_begin("rand_read32");
+    for(i = 0; i < ops; i++)
+    {
+        address = (uint32_t)rand() % (size - 3);
+        _bench_op_start(&t);
+        EEPROM_AT24CXX_DeviceRead32(&_bench_device, address, ADDRESS_TYPE_BYTE);
+        _bench_op_end(t, 4);
+    }
+    _bench_end();
+
+    //SMALL FIELD UPDATE STORM (COUNTERS / FLAGS REWRITTEN IN PLACE)
+    _bench_begin("update_storm");
+    for(i = 0; i < ops; i++)
+    {
+        address = fields[(uint32_t)rand() % BENCH_STORM_FIELDS];
+        _bench_op_start(&t);
+        switch(i % 3)
+        {
+            case 0:
+                EEPROM_AT24CXX_DeviceWrite8(&_bench_device, address, ADDRESS_TYPE_BYTE, (uint8_t)i);
+                _bench_op_end(t, 1);
+                break;
+            case 1:
+                EEPROM_AT24CXX_DeviceWrite16(&_bench_device, address, ADDRESS_TYPE_BYTE, (uint16_t)i);
+                _bench_op_end(t, 2);
+                break;
+            default:
+                EEPROM_AT24CXX_DeviceWrite32(&_bench_device, address, ADDRESS_TYPE_BYTE, i);
+                _bench_op_end(t, 4);
+                break;
+        }
+    }
+    EEPROM_AT24CXX_DeviceFlush(&_bench_device);
+    _bench_end();
+
+    printf("\n  ]\n}\n");
+
+    if(trace_file != NULL)
+    {
+        #if defined(EEPROM_AT24CXX_TRACE)
+            static uint8_t trace[EEPROM_AT24CXX_TRACE_HEADER_SIZE + EEPROM_AT24CXX_TRACE_ENTRIES * EEPROM_AT24CXX_TRACE_ENTRY_SIZE];
+            FILE* file = fopen(trace_file, "wb");
+
+            if(file != NULL)
+            {
+                fwrite(trace, 1, EEPROM_AT24CXX_DeviceTraceDump(&_bench_device, trace, sizeof(trace)), file);
+                fclose(file);
+            }
+        #else
+            fprintf(stderr, "trace not compiled in, build with EEPROM_AT24CXX_TRACE\n");
+        #endif
+    }
+
+    EEPROM_AT24CXX_SimClose(&_bench_sim);
+    unlink(BENCH_FILE);
+    return 0;
+}
+
+static void _bench_begin(const char* name)
+{
+    //START A WORKLOAD : SNAPSHOT CLOCK AND DEVICE COUNTERS
+
+    _bench_run.name = name;
+    _bench_run.ops = 0;
+    _bench_run.bytes = 0;
+    _bench_run.start_ns = EEPROM_AT24CXX_SimGetTimeNs();
+    memcpy(&_bench_run.start_stats, &_bench_sim.stats, sizeof(_bench_run.start_stats));
+}
+
+static void _bench_op_start(uint64_t* t)
+{
+    *t = EEPROM_AT24CXX_SimGetTimeNs();
+}
+
+static void _bench_op_end(uint64_t t, uint32_t bytes)
+{
+    if(_bench_run.ops < BENCH_MAX_OPS)
+    {
+        _bench_run.latency_ns[_bench_run.ops] = EEPROM_AT24CXX_SimGetTimeNs() - t;
+    }
+    _bench_run.ops++;
+    _bench_run.bytes += bytes;
+}
+
+static void _bench_end(void)
+{
+    //PRINT WORKLOAD RESULT
+    //TOTAL TIME INCLUDES ANY TRAILING FLUSH, LATENCIES ARE PER CALL
+
+    EEPROM_AT24CXX_SIM_STATS* s = &_bench_sim.stats;
+    EEPROM_AT24CXX_SIM_STATS* s0 = &_bench_run.start_stats;
+    uint64_t elapsed_ns;
+    uint32_t count;
+
+    elapsed_ns = EEPROM_AT24CXX_SimGetTimeNs() - _bench_run.start_ns;
+    count = (_bench_run.ops < BENCH_MAX_OPS) ? _bench_run.ops : BENCH_MAX_OPS;
+    qsort(_bench_run.latency_ns, count, sizeof(uint64_t), _bench_compare_u64);
+
+    printf("%s    {\"name\": \"%s\", \"ops\": %u, \"bytes\": %u, \"time_us\": %.1f, \"bytes_per_sec\": %.1f, \"ops_per_sec\": %.1f,\n",
+            _bench_first ? "" : ",\n",
+            _bench_run.name,
+            _bench_run.ops,
+            _bench_run.bytes,
+            elapsed_ns / 1000.0,
+            elapsed_ns ? (_bench_run.bytes * 1e9) / elapsed_ns : 0.0,
+            elapsed_ns ? (_bench_run.ops * 1e9) / elapsed_ns : 0.0);
+    printf("     \"latency_us\": {\"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, \"max\": %.1f},\n",
+            _bench_percentile(_bench_run.latency_ns, count, 50) / 1000.0,
+            _bench_percentile(_bench_run.latency_ns, count, 90) / 1000.0,
+            _bench_percentile(_bench_run.latency_ns, count, 99) / 1000.0,
+            count ? _bench_run.latency_ns[count - 1] / 1000.0 : 0.0);
+    printf("     \"i2c_transactions\": %u, \"i2c_nacks\": %u, \"write_cycles\": %u, \"bus_bytes_written\": %u, \"bus_bytes_read\": %u}",
+            s->transactions - s0->transactions,
+            s->nacks - s0->nacks,
+            s->page_programs - s0->page_programs,
+            s->bytes_written - s0->bytes_written,
+            s->bytes_read - s0->bytes_read);
+    _bench_first = 0;
+}
+
+static int _bench_compare_u64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+
+    return (x > y) - (x < y);
+}
+
+static uint64_t _bench_percentile(uint64_t* sorted, uint32_t count, uint32_t pct)
+{
+    //NEAREST RANK PERCENTILE OF A SORTED ARRAY
+
+    uint32_t rank;
+
+    if(count == 0)
+    {
+        return 0;
+    }
+    rank = (pct * count + 99) / 100;
+    if(rank == 0)
+    {
+        rank = 1;
+    }
+    return sorted[rank - 1];
+}
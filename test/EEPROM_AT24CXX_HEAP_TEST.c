@@ -0,0 +1,215 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* HEAP USAGE TEST (HOST, ON THE SIMULATED EEPROM)
+*
+* BUILD
+* -------
+*   gcc -O2 -DEEPROM_AT24CXX_SIM_TIME -DEEPROM_AT24CXX_NO_HEAP -I.. \
+*       -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc \
+*       -Wl,--wrap=free -o eeprom_heap_test \
+*       EEPROM_AT24CXX_HEAP_TEST.c ../EEPROM_AT24CXX.c ../EEPROM_AT24CXX_SIM.c
+*
+* USAGE
+* -------
+*   eeprom_heap_test
+*     EXIT STATUS 0 IF NO CALL MADE ANY HEAP CALL, 1 OTHERWISE
+*
+* NOTE
+* -------
+*   (1) malloc / calloc / realloc / free ARE INTERPOSED AT LINK TIME
+*       (--wrap) AND COUNTED WHILE THE SCALAR AND BLOCK READ / WRITE
+*       CALLS RUN, WITH THE PAGE CACHE OFF AND ON, THROUGH THE DEFAULT
+*       AND THE DEVICE API, INCLUDING THE INVALID ADDRESS PATHS
+*
+*   (2) SETUP (SIMULATOR, STDIO BUFFERS) IS DONE BEFORE COUNTING STARTS
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#include "EEPROM_AT24CXX_SIM.h"
+
+#if !defined(EEPROM_AT24CXX_SIM_TIME)
+  #error "EEPROM : AT24CXX : HEAP TEST : build with EEPROM_AT24CXX_SIM_TIME"
+#endif
+
+#define HEAP_TEST_FILE            "eeprom_heap_test.bin"
+#define HEAP_TEST_BLOCK_LEN       100
+
+//INTERPOSED ALLOCATOR
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+static EEPROM_AT24CXX_SIM _heap_test_sim;
+static EEPROM_AT24CXX_DEVICE _heap_test_device;
+static volatile uint8_t _heap_test_counting;
+static volatile uint32_t _heap_test_calls;
+
+void* __wrap_malloc(size_t size)
+{
+    if(_heap_test_counting)
+    {
+        _heap_test_calls++;
+    }
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size)
+{
+    if(_heap_test_counting)
+    {
+        _heap_test_calls++;
+    }
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size)
+{
+    if(_heap_test_counting)
+    {
+        _heap_test_calls++;
+    }
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr)
+{
+    if(_heap_test_counting && ptr != NULL)
+    {
+        _heap_test_calls++;
+    }
+    __real_free(ptr);
+}
+
+static uint32_t _heap_test_default_api(uint32_t size)
+{
+    //SCALAR AND BLOCK CALLS OF THE DEFAULT DEVICE API
+    //RETURN NUMBER OF WRONG READ BACKS
+
+    uint8_t block[HEAP_TEST_BLOCK_LEN];
+    uint8_t check[HEAP_TEST_BLOCK_LEN];
+    uint32_t bad = 0;
+    uint32_t i;
+
+    for(i = 0; i < HEAP_TEST_BLOCK_LEN; i++)
+    {
+        block[i] = (uint8_t)(i * 7 + 1);
+    }
+
+    EEPROM_AT24CXX_Write8(10, ADDRESS_TYPE_BYTE, 0x5A);
+    EEPROM_AT24CXX_Write16(20, ADDRESS_TYPE_BYTE, 0x1234);
+    EEPROM_AT24CXX_Write32(30, ADDRESS_TYPE_BYTE, 0xDEADBEEF);
+    EEPROM_AT24CXX_WriteBlock(61, ADDRESS_TYPE_BYTE, block, HEAP_TEST_BLOCK_LEN);
+    EEPROM_AT24CXX_WriteBlockIfChanged(61, ADDRESS_TYPE_BYTE, block, HEAP_TEST_BLOCK_LEN);
+    EEPROM_AT24CXX_Flush();
+
+    bad += (EEPROM_AT24CXX_Read8(10, ADDRESS_TYPE_BYTE) != 0x5A);
+    bad += (EEPROM_AT24CXX_Read16(20, ADDRESS_TYPE_BYTE) != 0x1234);
+    bad += (EEPROM_AT24CXX_Read32(30, ADDRESS_TYPE_BYTE) != 0xDEADBEEF);
+    bad += (EEPROM_AT24CXX_ReadBlock(61, ADDRESS_TYPE_BYTE, check, HEAP_TEST_BLOCK_LEN) != EEPROM_STATUS_OK);
+    bad += (memcmp(block, check, HEAP_TEST_BLOCK_LEN) != 0);
+    EEPROM_AT24CXX_InvalidateCache(0, ADDRESS_TYPE_BYTE, size);
+
+    //INVALID ADDRESSES (EARLY RETURN PATHS)
+    bad += (EEPROM_AT24CXX_Write16(size, ADDRESS_TYPE_BYTE, 0x1234) != EEPROM_STATUS_INVALID);
+    bad += (EEPROM_AT24CXX_Write32(size - 2, ADDRESS_TYPE_BYTE, 0xDEADBEEF) != EEPROM_STATUS_INVALID);
+    EEPROM_AT24CXX_Read16(size, ADDRESS_TYPE_BYTE);
+    EEPROM_AT24CXX_Read32(size - 2, ADDRESS_TYPE_BYTE);
+    bad += (EEPROM_AT24CXX_ReadBlock(size - 1, ADDRESS_TYPE_BYTE, check, 2) != EEPROM_STATUS_INVALID);
+    return bad;
+}
+
+static uint32_t _heap_test_device_api(EEPROM_AT24CXX_DEVICE* device, uint32_t size)
+{
+    //SCALAR AND BLOCK CALLS OF THE DEVICE API
+    //RETURN NUMBER OF WRONG READ BACKS
+
+    uint8_t block[HEAP_TEST_BLOCK_LEN];
+    uint8_t check[HEAP_TEST_BLOCK_LEN];
+    uint32_t bad = 0;
+    uint32_t i;
+
+    for(i = 0; i < HEAP_TEST_BLOCK_LEN; i++)
+    {
+        block[i] = (uint8_t)(i * 13 + 3);
+    }
+
+    EEPROM_AT24CXX_DeviceWrite8(device, 1000, ADDRESS_TYPE_BYTE, 0xA5);
+    EEPROM_AT24CXX_DeviceWrite16(device, 1010, ADDRESS_TYPE_BYTE, 0x4321);
+    EEPROM_AT24CXX_DeviceWrite32(device, 1020, ADDRESS_TYPE_BYTE, 0xCAFEF00D);
+    EEPROM_AT24CXX_DeviceWriteBlock(device, 1050, ADDRESS_TYPE_BYTE, block, HEAP_TEST_BLOCK_LEN);
+    EEPROM_AT24CXX_DeviceWriteBlockIfChanged(device, 1050, ADDRESS_TYPE_BYTE, block, HEAP_TEST_BLOCK_LEN);
+    EEPROM_AT24CXX_DeviceFlush(device);
+
+    bad += (EEPROM_AT24CXX_DeviceRead8(device, 1000, ADDRESS_TYPE_BYTE) != 0xA5);
+    bad += (EEPROM_AT24CXX_DeviceRead16(device, 1010, ADDRESS_TYPE_BYTE) != 0x4321);
+    bad += (EEPROM_AT24CXX_DeviceRead32(device, 1020, ADDRESS_TYPE_BYTE) != 0xCAFEF00D);
+    bad += (EEPROM_AT24CXX_DeviceReadBlock(device, 1050, ADDRESS_TYPE_BYTE, check, HEAP_TEST_BLOCK_LEN) != EEPROM_STATUS_OK);
+    bad += (memcmp(block, check, HEAP_TEST_BLOCK_LEN) != 0);
+    EEPROM_AT24CXX_DeviceInvalidateCache(device, 0, ADDRESS_TYPE_BYTE, size);
+
+    //INVALID ADDRESSES (EARLY RETURN PATHS)
+    bad += (EEPROM_AT24CXX_DeviceWrite16(device, size - 1, ADDRESS_TYPE_BYTE, 0x4321) != EEPROM_STATUS_INVALID);
+    bad += (EEPROM_AT24CXX_DeviceWrite32(device, size, ADDRESS_TYPE_BYTE, 0xCAFEF00D) != EEPROM_STATUS_INVALID);
+    EEPROM_AT24CXX_DeviceRead16(device, size - 1, ADDRESS_TYPE_BYTE);
+    EEPROM_AT24CXX_DeviceRead32(device, size, ADDRESS_TYPE_BYTE);
+    bad += (EEPROM_AT24CXX_DeviceReadBlock(device, size, ADDRESS_TYPE_BYTE, check, 1) != EEPROM_STATUS_INVALID);
+    return bad;
+}
+
+int main(void)
+{
+    uint32_t size;
+    uint32_t bad = 0;
+    uint32_t calls = 0;
+    uint8_t cache_on;
+
+    //DEFAULT DEVICE AND A SECOND DEVICE STRUCTURE ON THE SAME SIMULATED
+    //EEPROM, THE TWO API WORK ON DISJOINT ADDRESS RANGES
+    EEPROM_AT24CXX_Initialize(EEPROM_MODEL_AT24C64, 0, 0, 0);
+    EEPROM_AT24CXX_DeviceInitialize(&_heap_test_device, EEPROM_MODEL_AT24C64, 0, 0, 0);
+    size = EEPROM_AT24CXX_GetSize();
+    unlink(HEAP_TEST_FILE);
+    if(!EEPROM_AT24CXX_SimOpen(&_heap_test_sim, HEAP_TEST_FILE, EEPROM_AT24CXX_GetI2CAddress(), size, EEPROM_AT24CXX_GetPageSize(), EEPROM_AT24CXX_SIM_WRITE_CYCLE_US))
+    {
+        return 1;
+    }
+    EEPROM_AT24CXX_SetI2CFunctions(EEPROM_AT24CXX_SimI2CInit,
+                                    EEPROM_AT24CXX_SimI2CWriteByte,
+                                    EEPROM_AT24CXX_SimI2CWriteByteMultiple,
+                                    EEPROM_AT24CXX_SimI2CReadByte,
+                                    EEPROM_AT24CXX_SimI2CReadByteMultiple);
+    EEPROM_AT24CXX_SetI2CAckPollFunction(EEPROM_AT24CXX_SimI2CAckPoll);
+    EEPROM_AT24CXX_SetTimeFunction(EEPROM_AT24CXX_SimGetTimeUs);
+    EEPROM_AT24CXX_SimAttach(&_heap_test_device);
+
+    //GET STDIO BUFFERS ALLOCATED BEFORE COUNTING (ERROR PATHS LOG)
+    printf("heap test : %u bytes\n", size);
+    fflush(stdout);
+
+    for(cache_on = 0; cache_on < 2; cache_on++)
+    {
+        EEPROM_AT24CXX_SetCache(cache_on);
+        EEPROM_AT24CXX_DeviceSetCache(&_heap_test_device, cache_on);
+
+        _heap_test_calls = 0;
+        _heap_test_counting = 1;
+        bad += _heap_test_default_api(size);
+        bad += _heap_test_device_api(&_heap_test_device, size);
+        _heap_test_counting = 0;
+
+        printf("cache %u : heap calls %u\n", cache_on, _heap_test_calls);
+        calls += _heap_test_calls;
+    }
+
+    EEPROM_AT24CXX_SimClose(&_heap_test_sim);
+    unlink(HEAP_TEST_FILE);
+
+    printf("%s : heap calls %u, bad read backs %u\n", (calls == 0 && bad == 0) ? "PASS" : "FAIL", calls, bad);
+    return (calls == 0 && bad == 0) ? 0 : 1;
+}
@@ -0,0 +1,288 @@
+/****************************************************************
+* AT24CXX SERIAL EEPROM LIBRARY
+* TRACE DUMP DECODER (HOST)
+*
+* BUILD
+* -------
+*   gcc -O2 -I.. -o eeprom_trace_decode EEPROM_AT24CXX_TRACE_DECODE.c
+*
+* USAGE
+* -------
+*   eeprom_trace_decode [-x] [-s SPIKE_US] DUMP_FILE
+*     -x  DUMP_FILE IS HEX TEXT (AS PRINTED OVER A UART), NOT BINARY
+*     -s  MARK EVENTS TAKING AT LEAST SPIKE_US (DEFAULT 2000)
+*
+* NOTE
+* -------
+*   (1) INPUT IS THE OUTPUT OF EEPROM_AT24CXX_TraceDump. LAYOUT IS
+*       DOCUMENTED IN EEPROM_AT24CXX.h
+*
+*   (2) PRINTS ONE LINE PER EVENT (TIME RELATIVE TO THE FIRST EVENT,
+*       IDLE GAP BEFORE IT, DURATION), THEN A PER EVENT SUMMARY
+*
+*   (3) THE RING STORES EVENTS AS THEY END, SO AN API CALL COMES AFTER
+*       THE BUS TRANSFERS IT MADE. THE TIMELINE IS SORTED BY START TIME
+*       AND EVENTS RUNNING INSIDE ANOTHER ONE ARE INDENTED
+*
+* ANKIT BHATNAGAR
+* ANKIT.BHATNAGARINDIA@GMAIL.COM
+*
+* REFERENCES
+*
+****************************************************************/
+
+#include "EEPROM_AT24CXX.h"
+
+#include <ctype.h>
+
+#define DECODE_MAX_BYTES          (1024 * 1024)
+#define DECODE_SPIKE_US           2000
+#define DECODE_MAX_EVENTS         ((DECODE_MAX_BYTES - EEPROM_AT24CXX_TRACE_HEADER_SIZE) / EEPROM_AT24CXX_TRACE_ENTRY_SIZE)
+
+//CUSTOM VARIABLE STRUCTURES/////////////////////////////
+typedef struct
+{
+    uint32_t index;     //POSITION IN DUMP (ORDER OF COMPLETION)
+    EEPROM_AT24CXX_TRACE_ENTRY entry;
+} DECODE_EVENT;
+//END CUSTOM VARIABLE STRUCTURES/////////////////////////
+
+//LOCAL VARIABLES/////////////////////////////////////////
+static uint8_t _decode_buffer[DECODE_MAX_BYTES];
+static DECODE_EVENT _decode_events[DECODE_MAX_EVENTS];
+
+static const char* _decode_event_name[EEPROM_TRACE_MAX] =
+{
+    "READ8",
+    "READ16",
+    "READ32",
+    "READ_BLOCK",
+    "WRITE8",
+    "WRITE16",
+    "WRITE32",
+    "WRITE_BLOCK",
+    "FLUSH",
+    "BUS_READ",
+    "BUS_WRITE",
+    "WRITE_CYCLE"
+};
+
+//INTERNAL FUNCTIONS//////////////////////////////////////
+static uint32_t _decode_load(const char* path, uint8_t hex);
+static uint32_t _decode_u32(uint8_t* ptr);
+static int _decode_compare(const void* a, const void* b);
+//END INTERNAL FUNCTIONS//////////////////////////////////
+
+int main(int argc, char** argv)
+{
+    uint8_t hex = 0;
+    uint32_t spike_us = DECODE_SPIKE_US;
+    uint32_t len;
+    uint32_t count;
+    uint32_t total;
+    uint32_t first_us;
+    uint32_t busy_until_us;
+    uint32_t end_us;
+    uint32_t event_count[EEPROM_TRACE_MAX];
+    uint32_t event_errors[EEPROM_TRACE_MAX];
+    uint64_t event_time[EEPROM_TRACE_MAX];
+    uint32_t event_max[EEPROM_TRACE_MAX];
+    EEPROM_AT24CXX_TRACE_ENTRY* entry;
+    uint8_t* ptr;
+    uint32_t i;
+    int opt;
+
+    while((opt = getopt(argc, argv, "xs:")) != -1)
+    {
+        switch(opt)
+        {
+            case 'x': hex = 1; break;
+            case 's': spike_us = (uint32_t)atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage : %s [-x] [-s spike_us] dump_file\n", argv[0]);
+                return 1;
+        }
+    }
+    if(optind >= argc)
+    {
+        fprintf(stderr, "usage : %s [-x] [-s spike_us] dump_file\n", argv[0]);
+        return 1;
+    }
+
+    len = _decode_load(argv[optind], hex);
+    if(len < EEPROM_AT24CXX_TRACE_HEADER_SIZE ||
+        memcmp(_decode_buffer, "AT24", 4) != 0)
+    {
+        fprintf(stderr, "%s : not a trace dump\n", argv[optind]);
+        return 1;
+    }
+    if(_decode_buffer[4] != EEPROM_AT24CXX_TRACE_VERSION)
+    {
+        fprintf(stderr, "%s : unsupported trace version %u\n", argv[optind], _decode_buffer[4]);
+        return 1;
+    }
+    count = _decode_buffer[6] | ((uint32_t)_decode_buffer[7] << 8);
+    total = _decode_u32(&_decode_buffer[8]);
+    if(EEPROM_AT24CXX_TRACE_HEADER_SIZE + count * EEPROM_AT24CXX_TRACE_ENTRY_SIZE > len)
+    {
+        fprintf(stderr, "%s : truncated dump\n", argv[optind]);
+        return 1;
+    }
+
+    printf("device 0x%02X : %u events (%u recorded, %u lost)\n",
+            _decode_buffer[5], count, total, total - count);
+    printf("%12s %10s %10s  %-12s %8s %6s  %s\n", "time_us", "gap_us", "dur_us", "event", "address", "len", "result");
+
+    memset(event_count, 0, sizeof(event_count));
+    memset(event_errors, 0, sizeof(event_errors));
+    memset(event_time, 0, sizeof(event_time));
+    memset(event_max, 0, sizeof(event_max));
+
+    ptr = &_decode_buffer[EEPROM_AT24CXX_TRACE_HEADER_SIZE];
+    for(i = 0; i < count; i++, ptr += EEPROM_AT24CXX_TRACE_ENTRY_SIZE)
+    {
+        _decode_events[i].index = i;
+        _decode_events[i].entry.time_us = _decode_u32(&ptr[0]);
+        _decode_events[i].entry.duration_us = _decode_u32(&ptr[4]);
+        _decode_events[i].entry.address = _decode_u32(&ptr[8]);
+        _decode_events[i].entry.len = (uint16_t)(ptr[12] | (ptr[13] << 8));
+        _decode_events[i].entry.event = ptr[14];
+        _decode_events[i].entry.result = ptr[15];
+    }
+    qsort(_decode_events, count, sizeof(DECODE_EVENT), _decode_compare);
+
+    first_us = (count > 0) ? _decode_events[0].entry.time_us : 0;
+    busy_until_us = first_us;
+    for(i = 0; i < count; i++)
+    {
+        uint8_t nested;
+
+        entry = &_decode_events[i].entry;
+        nested = ((int32_t)(entry->time_us - busy_until_us) < 0);
+        end_us = entry->time_us + entry->duration_us;
+
+        printf("%12u %10u %10u  %s%-*s %8u %6u  %s%s\n",
+                entry->time_us - first_us,
+                nested ? 0 : entry->time_us - busy_until_us,
+                entry->duration_us,
+                nested ? "  " : "",
+                nested ? 10 : 12,
+                (entry->event < EEPROM_TRACE_MAX) ? _decode_event_name[entry->event] : "?",
+                entry->address,
+                entry->len,
+                entry->result ? "ok" : "FAIL",
+                (entry->duration_us >= spike_us) ? "  <-- SPIKE" : "");
+        if((int32_t)(end_us - busy_until_us) > 0)
+        {
+            busy_until_us = end_us;
+        }
+
+        if(entry->event < EEPROM_TRACE_MAX)
+        {
+            event_count[entry->event]++;
+            event_errors[entry->event] += !entry->result;
+            event_time[entry->event] += entry->duration_us;
+            if(entry->duration_us > event_max[entry->event])
+            {
+                event_max[entry->event] = entry->duration_us;
+            }
+        }
+    }
+
+    printf("\n%-12s %8s %8s %12s %10s %10s\n", "event", "count", "errors", "total_us", "avg_us", "max_us");
+    for(i = 0; i < EEPROM_TRACE_MAX; i++)
+    {
+        if(event_count[i] == 0)
+        {
+            continue;
+        }
+        printf("%-12s %8u %8u %12llu %10.1f %10u\n",
+                _decode_event_name[i],
+                event_count[i],
+                event_errors[i],
+                (unsigned long long)event_time[i],
+                (double)event_time[i] / event_count[i],
+                event_max[i]);
+    }
+    return 0;
+}
+
+static uint32_t _decode_load(const char* path, uint8_t hex)
+{
+    //READ DUMP FILE INTO _decode_buffer
+    //HEX TEXT : PAIRS OF HEX DIGITS, ANYTHING ELSE (SPACES, NEWLINES,
+    //0x PREFIXES, COMMAS) IS SKIPPED
+    //RETURN NUMBER OF BYTES LOADED
+
+    FILE* file;
+    uint32_t len = 0;
+    int c;
+    int nibble = -1;
+
+    file = fopen(path, hex ? "r" : "rb");
+    if(file == NULL)
+    {
+        fprintf(stderr, "%s : cannot open\n", path);
+        return 0;
+    }
+
+    if(!hex)
+    {
+        len = (uint32_t)fread(_decode_buffer, 1, DECODE_MAX_BYTES, file);
+        fclose(file);
+        return len;
+    }
+
+    while((c = fgetc(file)) != EOF && len < DECODE_MAX_BYTES)
+    {
+        if(c == 'x' || c == 'X')
+        {
+            //DROP THE 0 OF A 0x PREFIX
+            nibble = -1;
+            continue;
+        }
+        if(!isxdigit(c))
+        {
+            nibble = -1;
+            continue;
+        }
+        c = isdigit(c) ? (c - '0') : (tolower(c) - 'a' + 10);
+        if(nibble < 0)
+        {
+            nibble = c;
+        }
+        else
+        {
+            _decode_buffer[len++] = (uint8_t)((nibble << 4) | c);
+            nibble = -1;
+        }
+    }
+    fclose(file);
+    return len;
+}
+
+static uint32_t _decode_u32(uint8_t* ptr)
+{
+    //LITTLE ENDIAN UINT32_T
+
+    return ptr[0] | ((uint32_t)ptr[1] << 8) | ((uint32_t)ptr[2] << 16) | ((uint32_t)ptr[3] << 24);
+}
+
+static int _decode_compare(const void* a, const void* b)
+{
+    //START TIME, THEN LONGEST FIRST (ENCLOSING CALL BEFORE ITS
+    //TRANSFERS), THEN ORDER IN THE DUMP
+
+    const DECODE_EVENT* x = (const DECODE_EVENT*)a;
+    const DECODE_EVENT* y = (const DECODE_EVENT*)b;
+
+    if(x->entry.time_us != y->entry.time_us)
+    {
+        return ((int32_t)(x->entry.time_us - y->entry.time_us) < 0) ? -1 : 1;
+    }
+    if(x->entry.duration_us != y->entry.duration_us)
+    {
+        return (x->entry.duration_us > y->entry.duration_us) ? -1 : 1;
+    }
+    return (x->index < y->index) ? -1 : 1;
+}